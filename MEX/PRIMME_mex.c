@@ -102,10 +102,14 @@
 #define max(a, b) ((a) > (b) ? (a) : (b))
 #endif
 
-void MatrixMatvec_d(void *x, void *y, int *blockSize, primme_params *primme);
-void MatrixMatvec_z(void *x, void *y, int *blockSize, primme_params *primme);
-void Preconditioner_d(void *x, void *y, int *blockSize, primme_params *primme);
-void Preconditioner_z(void *x, void *y, int *blockSize, primme_params *primme);
+void MatrixMatvec_d(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+void MatrixMatvec_z(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+void Preconditioner_d(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+void Preconditioner_z(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
 
 double Matvec_mex_timer = 0.0L;
 char *outputfilename;
@@ -734,7 +738,8 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
  * this function.
  */
 
-void MatrixMatvec_d(void *x, void *y, int *blockSize, primme_params *primme)
+void MatrixMatvec_d(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme)
 {  
    double wt1 = primme_get_wtime(); 
    double * sendXr;
@@ -753,15 +758,19 @@ void MatrixMatvec_d(void *x, void *y, int *blockSize, primme_params *primme)
    double * yvecr;
    double * ycopyvec = (double *)y;
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      sendXr[l] = xvec[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         sendXr[n*k+l] = xvec[(*ldx)*k+l];
+      }
    }
 
    mexCallMATLAB( 1, lhs, 1, rhs, "getMatvecHandle");        
    yvecr = mxGetPr(lhs[0]);
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      ycopyvec[l] = yvecr[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         ycopyvec[(*ldy)*k+l] = yvecr[n*k+l];
+      }
    }
 
    mxDestroyArray(rhs[0]); 
@@ -773,7 +782,8 @@ void MatrixMatvec_d(void *x, void *y, int *blockSize, primme_params *primme)
 }
 
 
-void MatrixMatvec_z(void *x, void *y, int *blockSize, primme_params *primme)
+void MatrixMatvec_z(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme)
 {  
    double wt1 = primme_get_wtime(); 
 
@@ -794,18 +804,22 @@ void MatrixMatvec_z(void *x, void *y, int *blockSize, primme_params *primme)
 
    Complex_Z * ycopyvec = (Complex_Z *)y;
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      sendXr[l] = xvec[l].r;
-      sendXi[l] = xvec[l].i;
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         sendXr[n*k+l] = xvec[(*ldx)*k+l].r;
+         sendXi[n*k+l] = xvec[(*ldx)*k+l].i;
+      }
    }
 
    mexCallMATLAB( 1, lhs, 1, rhs, "getMatvecHandle");        
    yvecr = mxGetPr(lhs[0]);
    yveci = mxGetPi(lhs[0]);
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      ycopyvec[l].r = yvecr[l];
-      ycopyvec[l].i = yveci[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         ycopyvec[(*ldy)*k+l].r = yvecr[n*k+l];
+         ycopyvec[(*ldy)*k+l].i = yveci[n*k+l];
+      }
    }
 
    mxDestroyArray(rhs[0]);
@@ -828,7 +842,8 @@ void MatrixMatvec_z(void *x, void *y, int *blockSize, primme_params *primme)
  * vector y is returned to this function.
  */
 
-void Preconditioner_d(void *x, void *y, int *blockSize, primme_params *primme)
+void Preconditioner_d(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme)
 { 
 
    double * sendXr;
@@ -847,15 +862,19 @@ void Preconditioner_d(void *x, void *y, int *blockSize, primme_params *primme)
    double * yvecr;
    double * ycopyvec = (double *)y;
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      sendXr[l] = xvec[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         sendXr[n*k+l] = xvec[(*ldx)*k+l];
+      }
    }
 
    mexCallMATLAB( 1, lhs, 1, rhs, "getPrecondHandle");
    yvecr = mxGetPr(lhs[0]);
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      ycopyvec[l] = yvecr[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         ycopyvec[(*ldy)*k+l] = yvecr[n*k+l];
+      }
    }
 
    mxDestroyArray(rhs[0]);
@@ -863,7 +882,8 @@ void Preconditioner_d(void *x, void *y, int *blockSize, primme_params *primme)
 
 }
 
-void Preconditioner_z(void *x, void *y, int *blockSize, primme_params *primme)
+void Preconditioner_z(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme)
 { 
    double * sendXr;
    double * sendXi;
@@ -881,18 +901,22 @@ void Preconditioner_z(void *x, void *y, int *blockSize, primme_params *primme)
 
    Complex_Z * ycopyvec = (Complex_Z *)y;
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      sendXr[l] = xvec[l].r;
-      sendXi[l] = xvec[l].i;
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         sendXr[n*k+l] = xvec[(*ldx)*k+l].r;
+         sendXi[n*k+l] = xvec[(*ldx)*k+l].i;
+      }
    }
 
    mexCallMATLAB( 1, lhs, 1, rhs, "getPrecondHandle");
    yvecr = mxGetPr(lhs[0]);
    yveci = mxGetPi(lhs[0]);
 
-   for (l = 0; l < n*(*blockSize); l++) {
-      ycopyvec[l].r = yvecr[l];
-      ycopyvec[l].i = yveci[l];
+   for (k = 0; k < *blockSize; k++) {
+      for (l = 0; l < n; l++) {
+         ycopyvec[(*ldy)*k+l].r = yvecr[n*k+l];
+         ycopyvec[(*ldy)*k+l].i = yveci[n*k+l];
+      }
    }
 
    mxDestroyArray(rhs[0]);
@@ -40,5 +40,14 @@
 #define PRACTICALLY_CONVERGED  6
 #define UNCONDITIONAL_LOCK_IT  7
 
+/* Alignment of the workspace and of the columns of V and W, and the     */
+/* column stride that maps consecutive columns onto the same cache sets  */
+#define CACHE_LINE_BYTES       64
+#define ALIASING_STRIDE_BYTES  4096
+
+/* Bytes of the new columns that the kernels streaming over V and W      */
+/* compute per block of rows; about the size of a core's L2 cache        */
+#define STREAM_TILE_BYTES      (256*1024)
+
 
 #endif /* CONST_H */
@@ -185,6 +185,9 @@ static void convertToString(primme_function func, char *functionName) {
       case Primme_main_iter:
          strcpy(functionName, "main_iter");
          break;
+      case Primme_krylov_schur:
+         strcpy(functionName, "krylov_schur");
+         break;
       case Primme_allocate_workspace:
          strcpy(functionName, "allocate_workspace");
          break;
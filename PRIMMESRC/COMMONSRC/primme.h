@@ -46,6 +46,7 @@ typedef enum {
    Primme_check_input,
    Primme_allocate_workspace,
    Primme_main_iter,
+   Primme_krylov_schur,
    Primme_init_basis,
    Primme_init_block_krylov,
    Primme_init_krylov,
@@ -81,7 +82,9 @@ typedef enum {
 
 typedef enum {
    primme_thick,
-   primme_dtr
+   primme_dtr,
+   primme_thick_adaptive,
+   primme_krylov_schur
 } primme_restartscheme;
 
 
@@ -93,6 +96,73 @@ typedef enum {
 } primme_convergencetest;
 
 
+typedef enum {
+   primme_phase_matvec,
+   primme_phase_precond,
+   primme_phase_ortho,
+   primme_phase_update_projection,
+   primme_phase_solve_H,
+   primme_phase_restart,
+   primme_phase_locking,
+   primme_phase_convergence,
+   primme_phase_inner_solve,
+   primme_phase_globalSum
+} primme_phase;
+
+
+typedef enum {
+   primme_event_begin,        /* A phase starts                              */
+   primme_event_end,          /* A phase ends                                */
+   primme_event_ritz,         /* Ritz value and residual norm of block index */
+   primme_event_blockSize,    /* Block size of the outer iteration           */
+   primme_event_method,       /* Dynamic method switch to method index       */
+   primme_event_tune,         /* Tuned size: index 0 basis, 1 restart, 2 block*/
+   primme_event_restart       /* Basis size after restart, index previous    */
+                              /* vectors retained in it                      */
+} primme_event_type;
+
+
+typedef enum {
+   primme_trace_chrome,       /* Chrome trace-event JSON                     */
+   primme_trace_jsonl         /* One JSON object per line                    */
+} primme_trace_format;
+
+
+typedef struct primme_event {
+   double time;               /* Wall clock time, as primme_get_wtime        */
+   primme_event_type type;
+   primme_phase phase;        /* For primme_event_begin/end                  */
+   int iteration;             /* stats.numOuterIterations                    */
+   int index;                 /* Block index, method or tuned size           */
+   double value;              /* Ritz value, size or switching ratio         */
+   double resNorm;            /* Residual norm for primme_event_ritz         */
+} primme_event;
+
+
+typedef struct primme_cost_model {
+   int calibrated;            /* Nonzero if the times below were measured    */
+   double MV;                 /* Time of a matvec                            */
+   double PR;                 /* Time of a preconditioner application        */
+   double qmr_only;           /* Time of a QMR step without MV and PR        */
+   double qmr_plus_MV_PR;     /* Time of a QMR step                          */
+   double gdk_plus_MV;        /* Time of a GD+k outer step without PR        */
+   double gdk_conv_rate;      /* Residual reduction per MV with GD+k         */
+   double jdq_conv_rate;      /* Residual reduction per MV with JDQMR        */
+   double JDQMR_slowdown;     /* MVs of JDQMR over MVs of GD+k               */
+   double ratio_MV_outer;     /* MVs per outer iteration with JDQMR          */
+   double gdk_sum_logResReductions; /* Averaging sums of the rates, scaled   */
+   double gdk_sum_MV;               /* to the weight of one converged pair   */
+   double jdq_sum_logResReductions;
+   double jdq_sum_MV;
+   double latency;            /* Time of a global sum, besides its bytes     */
+   double bandwidth;          /* Bytes per second of a global sum, or 0      */
+   double qmr_globalSums;     /* Global sums per QMR step                    */
+   double qmr_globalSumBytes; /* Bytes summed per QMR step                   */
+   double gdk_globalSums;     /* Global sums per GD+k outer step             */
+   double gdk_globalSumBytes; /* Bytes summed per GD+k outer step            */
+} primme_cost_model;
+
+
 typedef struct stackTraceNode {
    primme_function callingFunction;
    primme_function failedFunction;
@@ -109,6 +179,40 @@ typedef struct primme_stats {
    int numMatvecs;
    int numPreconds;
    double elapsedTime; 
+   long int numPageFaults;     /* Page faults during the call, or -1        */
+   long int numRemotePages;    /* Pages of V and W off the NUMA node of the */
+                               /* thread owning their rows, or -1           */
+   long int bytesStreamed;     /* Bytes read from or written to storage     */
+                               /* during the call, or -1                    */
+   double timeMatvec;          /* Time in matrixMatvec                      */
+   double timePrecond;         /* Time in applyPreconditioner               */
+   double timeOrtho;           /* Time in ortho                             */
+   double timeUpdateProjection; /* Time in update_projection                */
+   double timeSolveH;          /* Time in solve_H                           */
+   double timeRestart;         /* Time in restart                           */
+   double timeLocking;         /* Time in lock_vectors                      */
+   double timeConvergence;     /* Time in check_convergence                 */
+   double timeInnerSolve;      /* Time in inner_solve                       */
+   double timeGlobalSum;       /* Time in globalSumDouble                   */
+   int numMatvecCalls;         /* Calls to matrixMatvec                     */
+   int numPrecondCalls;        /* Calls to applyPreconditioner              */
+   int numOrthoCalls;          /* Calls to ortho                            */
+   int numUpdateProjectionCalls; /* Calls to update_projection              */
+   int numSolveHCalls;         /* Calls to solve_H                          */
+   int numRestartCalls;        /* Calls to restart                          */
+   int numLockingCalls;        /* Calls to lock_vectors                     */
+   int numConvergenceCalls;    /* Calls to check_convergence                */
+   int numInnerSolveCalls;     /* Calls to inner_solve                      */
+   int numGlobalSumCalls;      /* Calls to globalSumDouble                  */
+   int numReorthos;            /* Reorthogonalizations in ortho             */
+   int numRandomizations;      /* Vectors replaced by random ones in ortho  */
+   long int bytesGlobalSum;    /* Bytes passed to globalSumDouble           */
+   int tunedBasisSize;         /* Sizes in use at the end of the call; they */
+   int tunedRestartSize;       /* differ from maxBasisSize, minRestartSize  */
+   int tunedBlockSize;         /* and maxBlockSize only with autoTune       */
+   int numTunings;             /* Restarts at which autoTune changed them   */
+   double meanRestartSize;     /* Average basis size after restart          */
+   double meanPrevRetained;    /* Average previous vectors retained in it   */
 } primme_stats;
    
 typedef struct JD_projectors {
@@ -142,20 +246,33 @@ typedef struct primme_params {
    /* The user must input at least the following two arguments */
    int n;
    void (*matrixMatvec)
-      ( void *x,  void *y, int *blockSize, struct primme_params *primme);
+      ( void *x, int *ldx, void *y, int *ldy, int *blockSize,
+        struct primme_params *primme);
 
    /* Preconditioner applied on block of vectors (if available) */
    void (*applyPreconditioner)
-      ( void *x,  void *y, int *blockSize, struct primme_params *primme);
+      ( void *x, int *ldx, void *y, int *ldy, int *blockSize,
+        struct primme_params *primme);
 
    /* Matrix times a multivector for mass matrix B for generalized Ax = xBl */
    void (*massMatrixMatvec)
-      ( void *x,  void *y, int *blockSize, struct primme_params *primme);
+      ( void *x, int *ldx, void *y, int *ldy, int *blockSize,
+        struct primme_params *primme);
+
+   /* Optional split-phase matvec. If both are set, the main iteration      */
+   /* starts y = A*x with Begin, does local work, and completes with Wait   */
+   void (*matrixMatvecBegin)
+      ( void *x, int *ldx, void *y, int *ldy, int *blockSize, void **request,
+        struct primme_params *primme);
+   void (*matrixMatvecWait)
+      ( void **request, struct primme_params *primme);
 
    /* input for the following is only required for parallel programs */
    int numProcs;
    int procID;
    int nLocal;
+   int ldOPs;             /* Leading dimension of the basis V and W, and of */
+                          /* the vectors passed to the operators from them  */
    void *commInfo;
    void (*globalSumDouble)
       (void *sendBuf, void *recvBuf, int *count, struct primme_params *primme );
@@ -176,11 +293,43 @@ typedef struct primme_params {
    int maxBlockSize;
    int maxMatvecs;
    int maxOuterIterations;
+   double maxTime;        /* Wall clock budget in seconds; 0 for no limit   */
+   int autoTune;          /* Tune basis, restart and block sizes at restarts*/
    int intWorkSize;
    long int realWorkSize;
    int iseed[4];
    int *intWork;
    void *realWork;
+
+   /* Allocation of realWork. NULL hooks select primme_default_allocWork */
+   void *(*allocWork)(size_t byteSize, struct primme_params *primme);
+   void (*freeWork)(void *ptr, struct primme_params *primme);
+   int hugePages;         /* Ask for transparent huge pages for realWork    */
+   int numTouchParts;     /* V and W are first touched by numTouchParts     */
+   int *touchRowStarts;   /* threads; part i owns the local rows from       */
+                          /* touchRowStarts[i] to touchRowStarts[i+1]-1     */
+   char *outOfCoreDir;    /* If not NULL, realWork is a memory-mapped file  */
+                          /* created in this directory                      */
+   void *mappedWork;      /* Internal: block mapped by the default allocator*/
+
+   /* Event trace, a ring buffer with the last traceSize events */
+   int traceSize;         /* Capacity of trace; 0 disables tracing          */
+   long int traceCount;   /* Events recorded in the last call               */
+   primme_event *trace;
+   primme_event *traceOwned; /* Internal: the buffer allocated by PRIMME,   */
+   int traceOwnedSize;    /* and its capacity; freed by primme_Free         */
+   double timerStart;     /* Internal: start of the timer of the last call  */
+
+   /* If not NULL, dynamic method switching starts from this model when */
+   /* calibrated, and leaves in it the model at the end of the run       */
+   primme_cost_model *costModel;
+
+   /* Called after every convergence check and locking. Returning nonzero  */
+   /* stops the solver, which returns the current approximations           */
+   int (*monitor)(double *basisEvals, int *basisFlags, int basisSize,
+      int *iblock, double *blockNorms, int blockSize, double *lockedEvals,
+      int numLocked, int numConverged, struct primme_params *primme);
+
    double aNorm;
    double eps;
 
@@ -229,6 +378,12 @@ void primme_display_params(primme_params primme);
 void *primme_valloc(size_t byteSize, const char *target);
 void *primme_calloc(size_t nelem, size_t elsize, const char *target);
 void primme_Free(primme_params *primme);
+void *primme_default_allocWork(size_t byteSize, primme_params *primme);
+void primme_default_freeWork(void *ptr, primme_params *primme);
+int primme_read_cost_model(FILE *f, primme_cost_model *model);
+int primme_write_cost_model(FILE *f, primme_cost_model *model);
+int primme_write_trace(FILE *f, primme_trace_format format,
+   primme_params *primme);
 void primme_seq_globalSumDouble(void *sendBuf, void *recvBuf, int *count,
                                                    primme_params *params);
 void primme_PushErrorMessage(const primme_function callingFunction, 
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_cost_model.c
+ *
+ * Purpose - Reads and writes the cost model of the dynamic method switching
+ *           (see primme.costModel), so that a later run on the same
+ *           operators starts from calibrated estimates. The file has one
+ *           "name = value" line per field; lines starting with '#' and
+ *           unknown names are ignored, and missing fields keep their values.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "primme.h"
+
+#define COST_MODEL_VERSION 1
+
+static const struct {
+   const char *name;
+   size_t offset;
+} fields[] = {
+   {"MV",                       offsetof(primme_cost_model, MV)},
+   {"PR",                       offsetof(primme_cost_model, PR)},
+   {"qmr_only",                 offsetof(primme_cost_model, qmr_only)},
+   {"qmr_plus_MV_PR",           offsetof(primme_cost_model, qmr_plus_MV_PR)},
+   {"gdk_plus_MV",              offsetof(primme_cost_model, gdk_plus_MV)},
+   {"gdk_conv_rate",            offsetof(primme_cost_model, gdk_conv_rate)},
+   {"jdq_conv_rate",            offsetof(primme_cost_model, jdq_conv_rate)},
+   {"JDQMR_slowdown",           offsetof(primme_cost_model, JDQMR_slowdown)},
+   {"ratio_MV_outer",           offsetof(primme_cost_model, ratio_MV_outer)},
+   {"gdk_sum_logResReductions", 
+                  offsetof(primme_cost_model, gdk_sum_logResReductions)},
+   {"gdk_sum_MV",               offsetof(primme_cost_model, gdk_sum_MV)},
+   {"jdq_sum_logResReductions", 
+                  offsetof(primme_cost_model, jdq_sum_logResReductions)},
+   {"jdq_sum_MV",               offsetof(primme_cost_model, jdq_sum_MV)},
+   {"latency",                  offsetof(primme_cost_model, latency)},
+   {"bandwidth",                offsetof(primme_cost_model, bandwidth)},
+   {"qmr_globalSums",           offsetof(primme_cost_model, qmr_globalSums)},
+   {"qmr_globalSumBytes",       
+                  offsetof(primme_cost_model, qmr_globalSumBytes)},
+   {"gdk_globalSums",           offsetof(primme_cost_model, gdk_globalSums)},
+   {"gdk_globalSumBytes",       
+                  offsetof(primme_cost_model, gdk_globalSumBytes)}
+};
+
+#define NUM_FIELDS ((int)(sizeof(fields)/sizeof(fields[0])))
+
+/******************************************************************************
+ * Function primme_read_cost_model - Reads a model written by
+ *    primme_write_cost_model into model.
+ *
+ * Return Value
+ * ------------
+ *  0 - Success; model->calibrated is set if the file was calibrated
+ * -1 - The file is not a cost model of a supported version; model is left
+ *      unchanged
+ *
+ ******************************************************************************/
+
+int primme_read_cost_model(FILE *f, primme_cost_model *model) {
+
+   char line[256], name[64];
+   double value;
+   int i, version = -1;
+   primme_cost_model read = *model;  /* fields not in the file are kept */
+
+   while (fgets(line, sizeof(line), f) != NULL) {
+      if (line[0] == '#' || sscanf(line, "%63s = %le", name, &value) != 2) {
+         continue;
+      }
+
+      if (strcmp(name, "version") == 0) {
+         version = (int)value;
+      }
+      else if (strcmp(name, "calibrated") == 0) {
+         read.calibrated = (int)value;
+      }
+      else {
+         for (i = 0; i < NUM_FIELDS; i++) {
+            if (strcmp(name, fields[i].name) == 0) {
+               *(double *)((char *)&read + fields[i].offset) = value;
+               break;
+            }
+         }
+      }
+   }
+
+   if (version != COST_MODEL_VERSION) {
+      return -1;
+   }
+
+   *model = read;
+   return 0;
+}
+
+/******************************************************************************
+ * Function primme_write_cost_model - Writes model to f.
+ *
+ * Return Value
+ * ------------
+ *  0 - Success
+ * -1 - Error writing the file
+ *
+ ******************************************************************************/
+
+int primme_write_cost_model(FILE *f, primme_cost_model *model) {
+
+   int i;
+
+   fprintf(f, "# PRIMME dynamic method switching cost model\n");
+   fprintf(f, "version = %d\n", COST_MODEL_VERSION);
+   fprintf(f, "calibrated = %d\n", model->calibrated);
+   for (i = 0; i < NUM_FIELDS; i++) {
+      fprintf(f, "%s = %.17e\n", fields[i].name,
+         *(double *)((char *)model + fields[i].offset));
+   }
+
+   return ferror(f) ? -1 : 0;
+}
@@ -244,6 +244,9 @@ void primme_set_member_f77(primme_params **primme, int *label, union f77_value v
       case PRIMMEF77_nLocal:
               (*primme)->nLocal = *v.int_v;
       break;
+      case PRIMMEF77_ldOPs:
+              (*primme)->ldOPs = *v.int_v;
+      break;
       case PRIMMEF77_globalSumDouble:
               (*primme)->globalSumDouble = v.globalSumDoubleFunc_v;
       break;
@@ -286,6 +289,12 @@ void primme_set_member_f77(primme_params **primme, int *label, union f77_value v
       case PRIMMEF77_maxOuterIterations:
               (*primme)->maxOuterIterations = *v.int_v;
       break;
+      case PRIMMEF77_maxTime:
+              (*primme)->maxTime = *v.double_v;
+      break;
+      case PRIMMEF77_autoTune:
+              (*primme)->autoTune = *v.int_v;
+      break;
       case PRIMMEF77_intWorkSize:
               (*primme)->intWorkSize = *v.int_v;
       break;
@@ -303,6 +312,21 @@ void primme_set_member_f77(primme_params **primme, int *label, union f77_value v
       case PRIMMEF77_realWork:
               (*primme)->realWork = v.ptr_v;
       break;
+      case PRIMMEF77_hugePages:
+              (*primme)->hugePages = *v.int_v;
+      break;
+      case PRIMMEF77_numTouchParts:
+              (*primme)->numTouchParts = *v.int_v;
+      break;
+      case PRIMMEF77_touchRowStarts:
+              (*primme)->touchRowStarts = v.int_v;
+      break;
+      case PRIMMEF77_traceSize:
+              (*primme)->traceSize = *v.int_v;
+      break;
+      case PRIMMEF77_traceCount:
+              (*primme)->traceCount = *v.long_int_v;
+      break;
       case PRIMMEF77_aNorm:
               (*primme)->aNorm = *v.double_v;
       break;
@@ -375,6 +399,102 @@ void primme_set_member_f77(primme_params **primme, int *label, union f77_value v
       case PRIMMEF77_stats_elapsedTime:
               (*primme)->stats.elapsedTime = *v.double_v;
       break;
+      case PRIMMEF77_stats_numPageFaults:
+              (*primme)->stats.numPageFaults = *v.long_int_v;
+      break;
+      case PRIMMEF77_stats_numRemotePages:
+              (*primme)->stats.numRemotePages = *v.long_int_v;
+      break;
+      case PRIMMEF77_stats_bytesStreamed:
+              (*primme)->stats.bytesStreamed = *v.long_int_v;
+      break;
+      case PRIMMEF77_stats_timeMatvec:
+              (*primme)->stats.timeMatvec = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timePrecond:
+              (*primme)->stats.timePrecond = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeOrtho:
+              (*primme)->stats.timeOrtho = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeUpdateProjection:
+              (*primme)->stats.timeUpdateProjection = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeSolveH:
+              (*primme)->stats.timeSolveH = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeRestart:
+              (*primme)->stats.timeRestart = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeLocking:
+              (*primme)->stats.timeLocking = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeConvergence:
+              (*primme)->stats.timeConvergence = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeInnerSolve:
+              (*primme)->stats.timeInnerSolve = *v.double_v;
+      break;
+      case PRIMMEF77_stats_timeGlobalSum:
+              (*primme)->stats.timeGlobalSum = *v.double_v;
+      break;
+      case PRIMMEF77_stats_numMatvecCalls:
+              (*primme)->stats.numMatvecCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numPrecondCalls:
+              (*primme)->stats.numPrecondCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numOrthoCalls:
+              (*primme)->stats.numOrthoCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numUpdateProjectionCalls:
+              (*primme)->stats.numUpdateProjectionCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numSolveHCalls:
+              (*primme)->stats.numSolveHCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numRestartCalls:
+              (*primme)->stats.numRestartCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numLockingCalls:
+              (*primme)->stats.numLockingCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numConvergenceCalls:
+              (*primme)->stats.numConvergenceCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numInnerSolveCalls:
+              (*primme)->stats.numInnerSolveCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numGlobalSumCalls:
+              (*primme)->stats.numGlobalSumCalls = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numReorthos:
+              (*primme)->stats.numReorthos = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numRandomizations:
+              (*primme)->stats.numRandomizations = *v.int_v;
+      break;
+      case PRIMMEF77_stats_tunedBasisSize:
+              (*primme)->stats.tunedBasisSize = *v.int_v;
+      break;
+      case PRIMMEF77_stats_tunedRestartSize:
+              (*primme)->stats.tunedRestartSize = *v.int_v;
+      break;
+      case PRIMMEF77_stats_tunedBlockSize:
+              (*primme)->stats.tunedBlockSize = *v.int_v;
+      break;
+      case PRIMMEF77_stats_numTunings:
+              (*primme)->stats.numTunings = *v.int_v;
+      break;
+      case PRIMMEF77_stats_meanRestartSize:
+              (*primme)->stats.meanRestartSize = *v.double_v;
+      break;
+      case PRIMMEF77_stats_meanPrevRetained:
+              (*primme)->stats.meanPrevRetained = *v.double_v;
+      break;
+      case PRIMMEF77_stats_bytesGlobalSum:
+              (*primme)->stats.bytesGlobalSum = *v.long_int_v;
+      break;
       default : 
       fprintf(stderr,"Requested member (%d) does not exist: consult primme_f77.h.",*label);
       fprintf(stderr," No action taken \n");
@@ -440,6 +560,9 @@ void primme_get_member_f77(primme_params *primme, int *label, union f77_value_pt
       case PRIMMEF77_nLocal:
               v->int_v = primme->nLocal;
       break;
+      case PRIMMEF77_ldOPs:
+              v->int_v = primme->ldOPs;
+      break;
       case PRIMMEF77_globalSumDouble:
               v->globalSumDoubleFunc_v = primme->globalSumDouble;
       break;
@@ -484,6 +607,12 @@ void primme_get_member_f77(primme_params *primme, int *label, union f77_value_pt
       case PRIMMEF77_maxOuterIterations:
               v->int_v = primme->maxOuterIterations;
       break;
+      case PRIMMEF77_maxTime:
+              v->double_v = primme->maxTime;
+      break;
+      case PRIMMEF77_autoTune:
+              v->int_v = primme->autoTune;
+      break;
       case PRIMMEF77_intWorkSize:
               v->int_v = primme->intWorkSize;
       break;
@@ -501,6 +630,21 @@ void primme_get_member_f77(primme_params *primme, int *label, union f77_value_pt
       case PRIMMEF77_realWork:
               v->ptr_v = primme->realWork;
       break;
+      case PRIMMEF77_hugePages:
+              v->int_v = primme->hugePages;
+      break;
+      case PRIMMEF77_numTouchParts:
+              v->int_v = primme->numTouchParts;
+      break;
+      case PRIMMEF77_touchRowStarts:
+              v->ptr_v = primme->touchRowStarts;
+      break;
+      case PRIMMEF77_traceSize:
+              v->int_v = primme->traceSize;
+      break;
+      case PRIMMEF77_traceCount:
+              v->long_int_v = primme->traceCount;
+      break;
       case PRIMMEF77_aNorm:
               v->double_v = primme->aNorm;
       break;
@@ -573,6 +717,102 @@ void primme_get_member_f77(primme_params *primme, int *label, union f77_value_pt
       case PRIMMEF77_stats_elapsedTime:
               v->double_v = primme->stats.elapsedTime;
       break;
+      case PRIMMEF77_stats_numPageFaults:
+              v->long_int_v = primme->stats.numPageFaults;
+      break;
+      case PRIMMEF77_stats_numRemotePages:
+              v->long_int_v = primme->stats.numRemotePages;
+      break;
+      case PRIMMEF77_stats_bytesStreamed:
+              v->long_int_v = primme->stats.bytesStreamed;
+      break;
+      case PRIMMEF77_stats_timeMatvec:
+              v->double_v = primme->stats.timeMatvec;
+      break;
+      case PRIMMEF77_stats_timePrecond:
+              v->double_v = primme->stats.timePrecond;
+      break;
+      case PRIMMEF77_stats_timeOrtho:
+              v->double_v = primme->stats.timeOrtho;
+      break;
+      case PRIMMEF77_stats_timeUpdateProjection:
+              v->double_v = primme->stats.timeUpdateProjection;
+      break;
+      case PRIMMEF77_stats_timeSolveH:
+              v->double_v = primme->stats.timeSolveH;
+      break;
+      case PRIMMEF77_stats_timeRestart:
+              v->double_v = primme->stats.timeRestart;
+      break;
+      case PRIMMEF77_stats_timeLocking:
+              v->double_v = primme->stats.timeLocking;
+      break;
+      case PRIMMEF77_stats_timeConvergence:
+              v->double_v = primme->stats.timeConvergence;
+      break;
+      case PRIMMEF77_stats_timeInnerSolve:
+              v->double_v = primme->stats.timeInnerSolve;
+      break;
+      case PRIMMEF77_stats_timeGlobalSum:
+              v->double_v = primme->stats.timeGlobalSum;
+      break;
+      case PRIMMEF77_stats_numMatvecCalls:
+              v->int_v = primme->stats.numMatvecCalls;
+      break;
+      case PRIMMEF77_stats_numPrecondCalls:
+              v->int_v = primme->stats.numPrecondCalls;
+      break;
+      case PRIMMEF77_stats_numOrthoCalls:
+              v->int_v = primme->stats.numOrthoCalls;
+      break;
+      case PRIMMEF77_stats_numUpdateProjectionCalls:
+              v->int_v = primme->stats.numUpdateProjectionCalls;
+      break;
+      case PRIMMEF77_stats_numSolveHCalls:
+              v->int_v = primme->stats.numSolveHCalls;
+      break;
+      case PRIMMEF77_stats_numRestartCalls:
+              v->int_v = primme->stats.numRestartCalls;
+      break;
+      case PRIMMEF77_stats_numLockingCalls:
+              v->int_v = primme->stats.numLockingCalls;
+      break;
+      case PRIMMEF77_stats_numConvergenceCalls:
+              v->int_v = primme->stats.numConvergenceCalls;
+      break;
+      case PRIMMEF77_stats_numInnerSolveCalls:
+              v->int_v = primme->stats.numInnerSolveCalls;
+      break;
+      case PRIMMEF77_stats_numGlobalSumCalls:
+              v->int_v = primme->stats.numGlobalSumCalls;
+      break;
+      case PRIMMEF77_stats_numReorthos:
+              v->int_v = primme->stats.numReorthos;
+      break;
+      case PRIMMEF77_stats_numRandomizations:
+              v->int_v = primme->stats.numRandomizations;
+      break;
+      case PRIMMEF77_stats_tunedBasisSize:
+              v->int_v = primme->stats.tunedBasisSize;
+      break;
+      case PRIMMEF77_stats_tunedRestartSize:
+              v->int_v = primme->stats.tunedRestartSize;
+      break;
+      case PRIMMEF77_stats_tunedBlockSize:
+              v->int_v = primme->stats.tunedBlockSize;
+      break;
+      case PRIMMEF77_stats_numTunings:
+              v->int_v = primme->stats.numTunings;
+      break;
+      case PRIMMEF77_stats_meanRestartSize:
+              v->double_v = primme->stats.meanRestartSize;
+      break;
+      case PRIMMEF77_stats_meanPrevRetained:
+              v->double_v = primme->stats.meanPrevRetained;
+      break;
+      case PRIMMEF77_stats_bytesGlobalSum:
+              v->long_int_v = primme->stats.bytesGlobalSum;
+      break;
       default :
       fprintf(stderr,"Requested member (%d) does not exist: consult primme_f77.h.",*label);
       fprintf(stderr," No action taken \n");
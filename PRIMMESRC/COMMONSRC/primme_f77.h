@@ -92,7 +92,47 @@ C-------------------------------------------------------
      : PRIMMEF77_stats_numPreconds,
      : PRIMMEF77_stats_elapsedTime,
      : PRIMMEF77_dynamicMethodSwitch,
-     : PRIMMEF77_massMatrixMatvec
+     : PRIMMEF77_massMatrixMatvec,
+     : PRIMMEF77_ldOPs,
+     : PRIMMEF77_hugePages,
+     : PRIMMEF77_numTouchParts,
+     : PRIMMEF77_touchRowStarts,
+     : PRIMMEF77_stats_numPageFaults,
+     : PRIMMEF77_stats_numRemotePages,
+     : PRIMMEF77_stats_bytesStreamed,
+     : PRIMMEF77_stats_timeMatvec,
+     : PRIMMEF77_stats_timePrecond,
+     : PRIMMEF77_stats_timeOrtho,
+     : PRIMMEF77_stats_timeUpdateProjection,
+     : PRIMMEF77_stats_timeSolveH,
+     : PRIMMEF77_stats_timeRestart,
+     : PRIMMEF77_stats_timeLocking,
+     : PRIMMEF77_stats_timeConvergence,
+     : PRIMMEF77_stats_timeInnerSolve,
+     : PRIMMEF77_stats_timeGlobalSum,
+     : PRIMMEF77_stats_numMatvecCalls,
+     : PRIMMEF77_stats_numPrecondCalls,
+     : PRIMMEF77_stats_numOrthoCalls,
+     : PRIMMEF77_stats_numUpdateProjectionCalls,
+     : PRIMMEF77_stats_numSolveHCalls,
+     : PRIMMEF77_stats_numRestartCalls,
+     : PRIMMEF77_stats_numLockingCalls,
+     : PRIMMEF77_stats_numConvergenceCalls,
+     : PRIMMEF77_stats_numInnerSolveCalls,
+     : PRIMMEF77_stats_numGlobalSumCalls,
+     : PRIMMEF77_stats_numReorthos,
+     : PRIMMEF77_stats_numRandomizations,
+     : PRIMMEF77_stats_bytesGlobalSum,
+     : PRIMMEF77_traceSize,
+     : PRIMMEF77_traceCount,
+     : PRIMMEF77_maxTime,
+     : PRIMMEF77_autoTune,
+     : PRIMMEF77_stats_tunedBasisSize,
+     : PRIMMEF77_stats_tunedRestartSize,
+     : PRIMMEF77_stats_tunedBlockSize,
+     : PRIMMEF77_stats_numTunings,
+     : PRIMMEF77_stats_meanRestartSize,
+     : PRIMMEF77_stats_meanPrevRetained
 
       parameter(
      : PRIMMEF77_n = 0,
@@ -145,7 +185,47 @@ C-------------------------------------------------------
      : PRIMMEF77_stats_numPreconds = 47,
      : PRIMMEF77_stats_elapsedTime = 48,
      : PRIMMEF77_dynamicMethodSwitch = 49,
-     : PRIMMEF77_massMatrixMatvec = 50
+     : PRIMMEF77_massMatrixMatvec = 50,
+     : PRIMMEF77_ldOPs = 51,
+     : PRIMMEF77_hugePages = 52,
+     : PRIMMEF77_numTouchParts = 53,
+     : PRIMMEF77_touchRowStarts = 54,
+     : PRIMMEF77_stats_numPageFaults = 55,
+     : PRIMMEF77_stats_numRemotePages = 56,
+     : PRIMMEF77_stats_bytesStreamed = 57,
+     : PRIMMEF77_stats_timeMatvec = 58,
+     : PRIMMEF77_stats_timePrecond = 59,
+     : PRIMMEF77_stats_timeOrtho = 60,
+     : PRIMMEF77_stats_timeUpdateProjection = 61,
+     : PRIMMEF77_stats_timeSolveH = 62,
+     : PRIMMEF77_stats_timeRestart = 63,
+     : PRIMMEF77_stats_timeLocking = 64,
+     : PRIMMEF77_stats_timeConvergence = 65,
+     : PRIMMEF77_stats_timeInnerSolve = 66,
+     : PRIMMEF77_stats_timeGlobalSum = 67,
+     : PRIMMEF77_stats_numMatvecCalls = 68,
+     : PRIMMEF77_stats_numPrecondCalls = 69,
+     : PRIMMEF77_stats_numOrthoCalls = 70,
+     : PRIMMEF77_stats_numUpdateProjectionCalls = 71,
+     : PRIMMEF77_stats_numSolveHCalls = 72,
+     : PRIMMEF77_stats_numRestartCalls = 73,
+     : PRIMMEF77_stats_numLockingCalls = 74,
+     : PRIMMEF77_stats_numConvergenceCalls = 75,
+     : PRIMMEF77_stats_numInnerSolveCalls = 76,
+     : PRIMMEF77_stats_numGlobalSumCalls = 77,
+     : PRIMMEF77_stats_numReorthos = 78,
+     : PRIMMEF77_stats_numRandomizations = 79,
+     : PRIMMEF77_stats_bytesGlobalSum = 80,
+     : PRIMMEF77_traceSize = 81,
+     : PRIMMEF77_traceCount = 82,
+     : PRIMMEF77_maxTime = 83,
+     : PRIMMEF77_autoTune = 84,
+     : PRIMMEF77_stats_tunedBasisSize = 85,
+     : PRIMMEF77_stats_tunedRestartSize = 86,
+     : PRIMMEF77_stats_tunedBlockSize = 87,
+     : PRIMMEF77_stats_numTunings = 88,
+     : PRIMMEF77_stats_meanRestartSize = 89,
+     : PRIMMEF77_stats_meanPrevRetained = 90
      : )
 
 C-------------------------------------------------------
@@ -161,6 +241,8 @@ C-------------------------------------------------------
      : PRIMMEF77_closest_abs,
      : PRIMMEF77_thick,
      : PRIMMEF77_dtr,
+     : PRIMMEF77_thick_adaptive,
+     : PRIMMEF77_krylov_schur,
      : PRIMMEF77_full_LTolerance,
      : PRIMMEF77_decreasing_LTolerance,
      : PRIMMEF77_adaptive_ETolerance,
@@ -174,6 +256,8 @@ C-------------------------------------------------------
      : PRIMMEF77_closest_abs = 4,
      : PRIMMEF77_thick = 0,
      : PRIMMEF77_dtr = 1,
+     : PRIMMEF77_thick_adaptive = 2,
+     : PRIMMEF77_krylov_schur = 3,
      : PRIMMEF77_full_LTolerance = 0,
      : PRIMMEF77_decreasing_LTolerance = 1,
      : PRIMMEF77_adaptive_ETolerance = 2,
@@ -103,6 +103,46 @@
 #define PRIMMEF77_stats_elapsedTime  48
 #define PRIMMEF77_dynamicMethodSwitch 49
 #define PRIMMEF77_massMatrixMatvec  50
+#define PRIMMEF77_ldOPs  51
+#define PRIMMEF77_hugePages  52
+#define PRIMMEF77_numTouchParts  53
+#define PRIMMEF77_touchRowStarts  54
+#define PRIMMEF77_stats_numPageFaults  55
+#define PRIMMEF77_stats_numRemotePages  56
+#define PRIMMEF77_stats_bytesStreamed  57
+#define PRIMMEF77_stats_timeMatvec  58
+#define PRIMMEF77_stats_timePrecond  59
+#define PRIMMEF77_stats_timeOrtho  60
+#define PRIMMEF77_stats_timeUpdateProjection  61
+#define PRIMMEF77_stats_timeSolveH  62
+#define PRIMMEF77_stats_timeRestart  63
+#define PRIMMEF77_stats_timeLocking  64
+#define PRIMMEF77_stats_timeConvergence  65
+#define PRIMMEF77_stats_timeInnerSolve  66
+#define PRIMMEF77_stats_timeGlobalSum  67
+#define PRIMMEF77_stats_numMatvecCalls  68
+#define PRIMMEF77_stats_numPrecondCalls  69
+#define PRIMMEF77_stats_numOrthoCalls  70
+#define PRIMMEF77_stats_numUpdateProjectionCalls  71
+#define PRIMMEF77_stats_numSolveHCalls  72
+#define PRIMMEF77_stats_numRestartCalls  73
+#define PRIMMEF77_stats_numLockingCalls  74
+#define PRIMMEF77_stats_numConvergenceCalls  75
+#define PRIMMEF77_stats_numInnerSolveCalls  76
+#define PRIMMEF77_stats_numGlobalSumCalls  77
+#define PRIMMEF77_stats_numReorthos  78
+#define PRIMMEF77_stats_numRandomizations  79
+#define PRIMMEF77_stats_bytesGlobalSum  80
+#define PRIMMEF77_traceSize  81
+#define PRIMMEF77_traceCount  82
+#define PRIMMEF77_maxTime  83
+#define PRIMMEF77_autoTune  84
+#define PRIMMEF77_stats_tunedBasisSize  85
+#define PRIMMEF77_stats_tunedRestartSize  86
+#define PRIMMEF77_stats_tunedBlockSize  87
+#define PRIMMEF77_stats_numTunings  88
+#define PRIMMEF77_stats_meanRestartSize  89
+#define PRIMMEF77_stats_meanPrevRetained  90
 
 /*----------------------------------------------------------*/
 /*     Defining easy to remember labels for setting the     */
@@ -116,6 +156,8 @@
 /*-------------------------------------------------------*/
 #define PRIMMEF77_thick  0
 #define PRIMMEF77_dt  1
+#define PRIMMEF77_thick_adaptive  2
+#define PRIMMEF77_krylov_schur  3
 /*-------------------------------------------------------*/
 #define PRIMMEF77_full_LTolerance  0
 #define PRIMMEF77_decreasing_LTolerance  1
@@ -131,7 +173,7 @@ extern "C" {
 
 union f77_value {
    int *int_v;
-   void (*matFunc_v) (void *,void *,int *,struct primme_params *);
+   void (*matFunc_v) (void *,int *,void *,int *,int *,struct primme_params *);
    void *ptr_v;
    void (*globalSumDoubleFunc_v) (void *,void *,int *,struct primme_params *);
    primme_target *target_v;
@@ -143,7 +185,7 @@ union f77_value {
 };
 union f77_value_ptr {
    int int_v;
-   void (*matFunc_v) (void *,void *,int *,struct primme_params *);
+   void (*matFunc_v) (void *,int *,void *,int *,int *,struct primme_params *);
    void *ptr_v;
    void (*globalSumDoubleFunc_v) (void *,void *,int *,struct primme_params *);
    primme_target target_v;
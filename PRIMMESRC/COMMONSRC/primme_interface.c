@@ -56,6 +56,8 @@ void primme_initialize(primme_params *primme) {
    primme->matrixMatvec            = NULL;
    primme->applyPreconditioner     = NULL;
    primme->massMatrixMatvec        = NULL;
+   primme->matrixMatvecBegin       = NULL;
+   primme->matrixMatvecWait        = NULL;
 
    /* Shifts for interior eigenvalues*/
    primme->numTargetShifts         = 0;
@@ -65,6 +67,7 @@ void primme_initialize(primme_params *primme) {
    primme->numProcs                = 1;
    primme->procID                  = 0;
    primme->nLocal                  = 0;
+   primme->ldOPs                   = 0;
    primme->commInfo                = NULL;
    primme->globalSumDouble         = primme_seq_globalSumDouble;
 
@@ -80,6 +83,8 @@ void primme_initialize(primme_params *primme) {
    primme->maxBlockSize                        = 1;
    primme->maxMatvecs                          = INT_MAX;
    primme->maxOuterIterations                  = INT_MAX;
+   primme->maxTime                             = 0.0L;
+   primme->autoTune                            = 0;
    primme->restartingParams.scheme             = primme_thick;
    primme->restartingParams.maxPrevRetain      = 0;
 
@@ -104,6 +109,38 @@ void primme_initialize(primme_params *primme) {
    primme->stats.numMatvecs        = 0;
    primme->stats.numPreconds       = 0;
    primme->stats.elapsedTime       = 0.0L;
+   primme->stats.numPageFaults     = -1;
+   primme->stats.numRemotePages    = -1;
+   primme->stats.bytesStreamed     = -1;
+   primme->stats.timeMatvec        = 0.0L;
+   primme->stats.timePrecond       = 0.0L;
+   primme->stats.timeOrtho         = 0.0L;
+   primme->stats.timeUpdateProjection = 0.0L;
+   primme->stats.timeSolveH        = 0.0L;
+   primme->stats.timeRestart       = 0.0L;
+   primme->stats.timeLocking       = 0.0L;
+   primme->stats.timeConvergence   = 0.0L;
+   primme->stats.timeInnerSolve    = 0.0L;
+   primme->stats.timeGlobalSum     = 0.0L;
+   primme->stats.numMatvecCalls    = 0;
+   primme->stats.numPrecondCalls   = 0;
+   primme->stats.numOrthoCalls     = 0;
+   primme->stats.numUpdateProjectionCalls = 0;
+   primme->stats.numSolveHCalls    = 0;
+   primme->stats.numRestartCalls   = 0;
+   primme->stats.numLockingCalls   = 0;
+   primme->stats.numConvergenceCalls = 0;
+   primme->stats.numInnerSolveCalls = 0;
+   primme->stats.numGlobalSumCalls = 0;
+   primme->stats.numReorthos       = 0;
+   primme->stats.numRandomizations = 0;
+   primme->stats.bytesGlobalSum    = 0;
+   primme->stats.tunedBasisSize    = 0;
+   primme->stats.tunedRestartSize  = 0;
+   primme->stats.tunedBlockSize    = 0;
+   primme->stats.numTunings        = 0;
+   primme->stats.meanRestartSize   = 0.0L;
+   primme->stats.meanPrevRetained  = 0.0L;
 
    /* Optional user defined structures */
    primme->matrix                  = NULL;
@@ -118,6 +155,21 @@ void primme_initialize(primme_params *primme) {
    primme->realWorkSize            = 0;
    primme->intWork                 = NULL;
    primme->realWork                = NULL;
+   primme->allocWork               = NULL;
+   primme->freeWork                = NULL;
+   primme->hugePages               = 0;
+   primme->numTouchParts           = 0;
+   primme->touchRowStarts          = NULL;
+   primme->outOfCoreDir            = NULL;
+   primme->mappedWork              = NULL;
+   primme->traceSize               = 0;
+   primme->traceCount              = 0;
+   primme->trace                   = NULL;
+   primme->traceOwned              = NULL;
+   primme->traceOwnedSize          = 0;
+   primme->timerStart              = 0.0;
+   primme->costModel               = NULL;
+   primme->monitor                 = NULL;
    primme->stackTrace              = NULL;
    primme->ShiftsForPreconditioner = NULL;
 
@@ -132,7 +184,13 @@ void *primme_valloc(size_t byteSize, const char *target) {
 
    void *ptr;
 
-   if ( (ptr = malloc(byteSize)) == NULL) {
+#if defined(_WIN32)
+   ptr = malloc(byteSize);
+#else
+   /* Align to a cache line so that the columns of V and W start on one */
+   if (posix_memalign(&ptr, CACHE_LINE_BYTES, byteSize) != 0) ptr = NULL;
+#endif
+   if (ptr == NULL) {
       perror("primme_alloc");
       fprintf(stderr,
          "ERROR(primme_alloc): Could not allocate %lu bytes for: %s\n",
@@ -166,7 +224,18 @@ void *primme_calloc(size_t nelem, size_t elsize, const char *target) {
 void primme_Free(primme_params *params) {
 
    free(params->intWork);
-   free(params->realWork);
+   if (params->freeWork) {
+      params->freeWork(params->realWork, params);
+   }
+   else {
+      free(params->realWork);
+   }
+   if (params->trace == params->traceOwned) {
+      params->trace     = NULL;
+   }
+   free(params->traceOwned);
+   params->traceOwned   = NULL;
+   params->traceOwnedSize = 0;
    params->intWorkSize  = 0;
    params->realWorkSize = 0;
 
@@ -266,6 +335,7 @@ int primme_set_method(primme_preset_method method, primme_params *params) {
 
    if (method == Arnoldi) {
       params->locking                             = 0;
+      params->restartingParams.scheme             = primme_krylov_schur;
       params->restartingParams.maxPrevRetain      = 0;
       params->correctionParams.precondition       = 0;
       params->correctionParams.maxInnerIterations = 0;
@@ -493,6 +563,11 @@ fprintf(outputFile, "// ---------------------------------------------------\n");
 
 fprintf(outputFile, "primme.n = %d \n",primme.n);
 fprintf(outputFile, "primme.nLocal = %d \n",primme.nLocal);
+fprintf(outputFile, "primme.ldOPs = %d \n",primme.ldOPs);
+fprintf(outputFile, "primme.hugePages = %d \n",primme.hugePages);
+fprintf(outputFile, "primme.traceSize = %d \n",primme.traceSize);
+if (primme.outOfCoreDir != NULL)
+   fprintf(outputFile, "primme.outOfCoreDir = %s \n",primme.outOfCoreDir);
 fprintf(outputFile, "primme.numProcs = %d \n",primme.numProcs);
 fprintf(outputFile, "primme.procID = %d \n",primme.procID);
 
@@ -509,6 +584,8 @@ fprintf(outputFile, "primme.maxBlockSize = %d\n",primme.maxBlockSize);
 fprintf(outputFile,
                 "primme.maxOuterIterations = %d\n",primme.maxOuterIterations);
 fprintf(outputFile, "primme.maxMatvecs = %d\n",primme.maxMatvecs);
+fprintf(outputFile, "primme.maxTime = %e\n",primme.maxTime);
+fprintf(outputFile, "primme.autoTune = %d\n",primme.autoTune);
 switch (primme.target){
    case primme_smallest:
       fprintf(outputFile, "primme.target = primme_smallest\n");
@@ -552,9 +629,15 @@ fprintf(outputFile, "primme.restarting.scheme = ");
 if (primme.restartingParams.scheme == primme_thick) {
   fprintf(outputFile, "primme_thick\n");
 }
-else {
+else if (primme.restartingParams.scheme == primme_dtr) {
   fprintf(outputFile, "primme_dtr\n");
 }
+else if (primme.restartingParams.scheme == primme_thick_adaptive) {
+  fprintf(outputFile, "primme_thick_adaptive\n");
+}
+else {
+  fprintf(outputFile, "primme_krylov_schur\n");
+}
 
 fprintf(outputFile, "primme.restarting.maxPrevRetain = %d\n",
                      primme.restartingParams.maxPrevRetain);
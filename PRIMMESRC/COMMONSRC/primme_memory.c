@@ -0,0 +1,301 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_memory.c
+ *
+ * Purpose - Default allocator of the real workspace, in memory or in a
+ *           memory-mapped file, and queries about the placement of memory
+ *           (page faults, NUMA nodes, storage traffic). The queries
+ *           return -1 where the system does not provide the information.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#  define PRIMME_HAVE_MMAP
+#  include <unistd.h>
+#  include <sys/time.h>
+#  include <sys/resource.h>
+#  include <sys/mman.h>
+#endif
+#if defined (__linux__)
+#  include <sys/syscall.h>
+#endif
+#include "primme.h"
+#include "const.h"
+#include "primme_memory.h"
+
+#define HUGE_PAGE_BYTES (2*1024*1024)
+#define RUSAGE_BLOCK_BYTES 512
+
+#ifdef PRIMME_HAVE_MMAP
+static void *map_file_work(size_t byteSize, const char *dir);
+static void unmap_file_work(void *ptr);
+#endif
+
+/******************************************************************************
+ * Function primme_default_allocWork - Default value of primme.allocWork.
+ *    Returns byteSize bytes aligned to a cache line. If primme.hugePages is
+ *    set, the block is aligned to a huge page and, where madvise supports
+ *    it, the kernel is advised to back it with transparent huge pages.
+ *    If primme.outOfCoreDir is set, the block is a shared mapping of a
+ *    file created in that directory instead.
+ *
+ ******************************************************************************/
+
+void *primme_default_allocWork(size_t byteSize, primme_params *primme) {
+
+   void *ptr;
+   size_t alignment = CACHE_LINE_BYTES;
+
+   if (primme->outOfCoreDir != NULL) {
+#ifdef PRIMME_HAVE_MMAP
+      ptr = map_file_work(byteSize, primme->outOfCoreDir);
+      if (ptr != NULL) primme->mappedWork = ptr;
+      return ptr;
+#else
+      return NULL;
+#endif
+   }
+
+   if (primme->hugePages) alignment = HUGE_PAGE_BYTES;
+
+#if defined(_WIN32)
+   ptr = malloc(byteSize);
+#else
+   if (posix_memalign(&ptr, alignment, byteSize) != 0) ptr = NULL;
+#endif
+
+#ifdef MADV_HUGEPAGE
+   if (ptr != NULL && primme->hugePages) {
+      madvise(ptr, byteSize, MADV_HUGEPAGE);
+   }
+#endif
+
+   return ptr;
+}
+
+/******************************************************************************
+ * Function primme_default_freeWork - Default value of primme.freeWork.
+ *    Unmaps the block if primme_default_allocWork mapped it, as recorded in
+ *    primme.mappedWork, whatever primme.outOfCoreDir is now; otherwise the
+ *    block came from the heap (or from the user) and is freed.
+ *
+ ******************************************************************************/
+
+void primme_default_freeWork(void *ptr, primme_params *primme) {
+
+#ifdef PRIMME_HAVE_MMAP
+   if (ptr != NULL && ptr == primme->mappedWork) {
+      unmap_file_work(ptr);
+      primme->mappedWork = NULL;
+      return;
+   }
+#endif
+   free(ptr);
+}
+
+#ifdef PRIMME_HAVE_MMAP
+
+/******************************************************************************
+ * Function map_file_work - Maps byteSize bytes of a new file in dir. The
+ *    file is unlinked right away, so it disappears when it is unmapped or
+ *    the process ends. The first page of the mapping holds its length, and
+ *    the returned pointer is the start of the second page.
+ *
+ ******************************************************************************/
+
+static void *map_file_work(size_t byteSize, const char *dir) {
+
+   char *path, *ptr;
+   size_t pageSize, mapSize;
+   int fd;
+
+   pageSize = (size_t)sysconf(_SC_PAGESIZE);
+   mapSize = pageSize + byteSize;
+
+   path = (char *)malloc(strlen(dir) + 20);
+   if (path == NULL) return NULL;
+   sprintf(path, "%s/primmeXXXXXX", dir);
+   fd = mkstemp(path);
+   if (fd >= 0) unlink(path);
+   free(path);
+   if (fd < 0) return NULL;
+
+   if (ftruncate(fd, (off_t)mapSize) != 0) {
+      close(fd);
+      return NULL;
+   }
+   ptr = (char *)mmap(NULL, mapSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (ptr == (char *)MAP_FAILED) return NULL;
+
+#ifdef MADV_SEQUENTIAL
+   /* Kernels pass over the basis column by column, front to back */
+   madvise(ptr + pageSize, byteSize, MADV_SEQUENTIAL);
+#endif
+
+   *(size_t *)ptr = mapSize;
+   return ptr + pageSize;
+}
+
+/******************************************************************************
+ * Function unmap_file_work - Releases a block returned by map_file_work.
+ *
+ ******************************************************************************/
+
+static void unmap_file_work(void *ptr) {
+
+   char *base;
+
+   if (ptr == NULL) return;
+   base = (char *)ptr - sysconf(_SC_PAGESIZE);
+   munmap(base, *(size_t *)base);
+}
+
+#endif /* PRIMME_HAVE_MMAP */
+
+/******************************************************************************
+ * Function primme_prefetch - Asks the system to start reading in the
+ *    background the pages overlapping the count blocks of byteSize bytes
+ *    starting at ptr, ptr+stride, ptr+2*stride, ... (e.g., a block of rows
+ *    of a matrix stored by columns). It only makes a difference for
+ *    memory-mapped workspace that is not resident.
+ *
+ ******************************************************************************/
+
+void primme_prefetch(void *ptr, size_t byteSize, size_t stride, int count) {
+
+#if defined (PRIMME_HAVE_MMAP) && defined (MADV_WILLNEED)
+   size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+   char *block, *p;
+   int i;
+
+   if (byteSize == 0) return;
+   for (i = 0; i < count; i++) {
+      block = (char *)ptr + stride*i;
+      p = block - ((size_t)block % pageSize);
+      madvise(p, block + byteSize - p, MADV_WILLNEED);
+   }
+#endif
+}
+
+/******************************************************************************
+ * Function primme_storage_bytes - Returns the bytes read from and written to
+ *    storage by the process so far, or -1 if unknown.
+ *
+ ******************************************************************************/
+
+long int primme_storage_bytes(void) {
+
+#ifdef PRIMME_HAVE_MMAP
+   struct rusage usage;
+
+   if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      return (usage.ru_inblock + usage.ru_oublock)*(long int)RUSAGE_BLOCK_BYTES;
+   }
+#endif
+   return -1;
+}
+
+/******************************************************************************
+ * Function primme_page_faults - Returns the number of page faults (minor and
+ *    major) of the process so far, or -1 if unknown.
+ *
+ ******************************************************************************/
+
+long int primme_page_faults(void) {
+
+#ifdef PRIMME_HAVE_MMAP
+   struct rusage usage;
+
+   if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      return usage.ru_minflt + usage.ru_majflt;
+   }
+#endif
+   return -1;
+}
+
+/******************************************************************************
+ * Function primme_numa_node - Returns the NUMA node of the CPU running the
+ *    calling thread, or -1 if unknown.
+ *
+ ******************************************************************************/
+
+int primme_numa_node(void) {
+
+#if defined (__linux__) && defined (SYS_getcpu)
+   unsigned int cpu, node;
+
+   if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+      return (int)node;
+   }
+#endif
+   return -1;
+}
+
+/******************************************************************************
+ * Function primme_remote_pages - Returns how many of the resident pages
+ *    overlapping ptr[0:byteSize-1] are not on NUMA node, or -1 if the
+ *    placement of pages cannot be queried.
+ *
+ ******************************************************************************/
+
+long int primme_remote_pages(void *ptr, size_t byteSize, int node) {
+
+#if defined (__linux__) && defined (SYS_move_pages)
+   enum { chunk = 512 };
+   void *pages[chunk];
+   int status[chunk];
+   long int pageSize, remote = 0;
+   char *p, *end;
+   int i, count;
+
+   if (node < 0 || byteSize == 0) return -1;
+
+   pageSize = sysconf(_SC_PAGESIZE);
+   p = (char *)ptr - ((size_t)ptr % pageSize);
+   end = (char *)ptr + byteSize;
+
+   while (p < end) {
+      for (count = 0; count < chunk && p < end; count++, p += pageSize) {
+         pages[count] = p;
+      }
+
+      /* With nodes == NULL, move_pages only reports where each page is */
+      if (syscall(SYS_move_pages, 0, (unsigned long)count, pages, NULL,
+               status, 0) != 0) {
+         return -1;
+      }
+
+      for (i = 0; i < count; i++) {
+         if (status[i] >= 0 && status[i] != node) remote++;
+      }
+   }
+
+   return remote;
+#else
+   return -1;
+#endif
+}
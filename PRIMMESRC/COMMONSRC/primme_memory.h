@@ -0,0 +1,50 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_memory.h
+ *
+ * Purpose - Header file containing the memory placement queries used by
+ *           the first-touch initialization of the workspace, and the
+ *           prefetching and traffic queries for out-of-core workspace.
+ *
+ ******************************************************************************/
+
+#ifndef PRIMME_MEMORY_H
+#define PRIMME_MEMORY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+long int primme_page_faults(void);
+int primme_numa_node(void);
+long int primme_remote_pages(void *ptr, size_t byteSize, int node);
+void primme_prefetch(void *ptr, size_t byteSize, size_t stride, int count);
+long int primme_storage_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIMME_MEMORY_H */
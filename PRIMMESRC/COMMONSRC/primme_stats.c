@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_stats.c
+ *
+ * Purpose - Functions that keep the counters and timers of primme_stats.
+ *
+ ******************************************************************************/
+
+#include "primme.h"
+#include "wtime.h"
+#include "primme_stats.h"
+#include "primme_trace.h"
+
+/******************************************************************************
+ * Function primme_reset_stats - Sets to zero the counters and timers that
+ *    dprimme() and zprimme() accumulate during a call.
+ *
+ ******************************************************************************/
+
+void primme_reset_stats(primme_params *primme) {
+
+   primme->stats.numOuterIterations       = 0;
+   primme->stats.numRestarts              = 0;
+   primme->stats.numMatvecs               = 0;
+   primme->stats.numPreconds              = 0;
+   primme->stats.timeMatvec               = 0.0L;
+   primme->stats.timePrecond              = 0.0L;
+   primme->stats.timeOrtho                = 0.0L;
+   primme->stats.timeUpdateProjection     = 0.0L;
+   primme->stats.timeSolveH               = 0.0L;
+   primme->stats.timeRestart              = 0.0L;
+   primme->stats.timeLocking              = 0.0L;
+   primme->stats.timeConvergence          = 0.0L;
+   primme->stats.timeInnerSolve           = 0.0L;
+   primme->stats.timeGlobalSum            = 0.0L;
+   primme->stats.numMatvecCalls           = 0;
+   primme->stats.numPrecondCalls          = 0;
+   primme->stats.numOrthoCalls            = 0;
+   primme->stats.numUpdateProjectionCalls = 0;
+   primme->stats.numSolveHCalls           = 0;
+   primme->stats.numRestartCalls          = 0;
+   primme->stats.numLockingCalls          = 0;
+   primme->stats.numConvergenceCalls      = 0;
+   primme->stats.numInnerSolveCalls       = 0;
+   primme->stats.numGlobalSumCalls        = 0;
+   primme->stats.numReorthos              = 0;
+   primme->stats.numRandomizations        = 0;
+   primme->stats.bytesGlobalSum           = 0;
+   primme->stats.tunedBasisSize           = primme->maxBasisSize;
+   primme->stats.tunedRestartSize         = primme->minRestartSize;
+   primme->stats.tunedBlockSize           = primme->maxBlockSize;
+   primme->stats.numTunings               = 0;
+   primme->stats.meanRestartSize          = 0.0L;
+   primme->stats.meanPrevRetained         = 0.0L;
+}
+
+/******************************************************************************
+ * Function primme_phase_begin - Returns the time at which a phase starts,
+ *    to be passed to primme_phase_end, and traces the event if enabled.
+ *
+ ******************************************************************************/
+
+double primme_phase_begin(primme_phase phase, primme_params *primme) {
+
+   double t = primme_get_wtime();
+
+   if (primme->trace) {
+      primme_trace_record(t, primme_event_begin, phase, 0, 0.0L, 0.0L, primme);
+   }
+   return t;
+}
+
+/******************************************************************************
+ * Function phase_end - Adds the time since tstart to the counter of the
+ *    phase in primme.stats, and one call if countCall is nonzero, and traces
+ *    the event if enabled.
+ *
+ ******************************************************************************/
+
+static void phase_end(primme_phase phase, double tstart, int countCall,
+   primme_params *primme) {
+
+   double t = primme_get_wtime();
+
+   switch (phase) {
+   case primme_phase_matvec:
+      primme->stats.timeMatvec += t - tstart;
+      primme->stats.numMatvecCalls += countCall;
+      break;
+   case primme_phase_precond:
+      primme->stats.timePrecond += t - tstart;
+      primme->stats.numPrecondCalls += countCall;
+      break;
+   case primme_phase_ortho:
+      primme->stats.timeOrtho += t - tstart;
+      primme->stats.numOrthoCalls += countCall;
+      break;
+   case primme_phase_update_projection:
+      primme->stats.timeUpdateProjection += t - tstart;
+      primme->stats.numUpdateProjectionCalls += countCall;
+      break;
+   case primme_phase_solve_H:
+      primme->stats.timeSolveH += t - tstart;
+      primme->stats.numSolveHCalls += countCall;
+      break;
+   case primme_phase_restart:
+      primme->stats.timeRestart += t - tstart;
+      primme->stats.numRestartCalls += countCall;
+      break;
+   case primme_phase_locking:
+      primme->stats.timeLocking += t - tstart;
+      primme->stats.numLockingCalls += countCall;
+      break;
+   case primme_phase_convergence:
+      primme->stats.timeConvergence += t - tstart;
+      primme->stats.numConvergenceCalls += countCall;
+      break;
+   case primme_phase_inner_solve:
+      primme->stats.timeInnerSolve += t - tstart;
+      primme->stats.numInnerSolveCalls += countCall;
+      break;
+   case primme_phase_globalSum:
+      primme->stats.timeGlobalSum += t - tstart;
+      primme->stats.numGlobalSumCalls += countCall;
+   }
+
+   if (primme->trace) {
+      primme_trace_record(t, primme_event_end, phase, 0, 0.0L, 0.0L, primme);
+   }
+}
+
+/******************************************************************************
+ * Function primme_phase_end - Adds the time since tstart and one call to
+ *    the counters of the phase in primme.stats, and traces the event if
+ *    enabled.
+ *
+ ******************************************************************************/
+
+void primme_phase_end(primme_phase phase, double tstart, 
+   primme_params *primme) {
+
+   phase_end(phase, tstart, 1, primme);
+}
+
+/******************************************************************************
+ * Function primme_matvec - Calls primme.matrixMatvec, accounting its time
+ *    and calls in primme.stats. The number of vectors multiplied is left to
+ *    the caller, who adds it to stats.numMatvecs.
+ *
+ ******************************************************************************/
+
+void primme_matvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme) {
+
+   double tstart = primme_phase_begin(primme_phase_matvec, primme);
+
+   (*primme->matrixMatvec)(x, ldx, y, ldy, blockSize, primme);
+
+   primme_phase_end(primme_phase_matvec, tstart, primme);
+}
+
+/******************************************************************************
+ * Function primme_matvec_begin, primme_matvec_wait - Call
+ *    primme.matrixMatvecBegin and primme.matrixMatvecWait, accounting in
+ *    stats.timeMatvec only the time spent inside them, not the time the
+ *    product overlaps with other work. The pair counts as one call.
+ *
+ ******************************************************************************/
+
+void primme_matvec_begin(void *x, int *ldx, void *y, int *ldy, 
+   int *blockSize, void **request, primme_params *primme) {
+
+   double tstart = primme_phase_begin(primme_phase_matvec, primme);
+
+   (*primme->matrixMatvecBegin)(x, ldx, y, ldy, blockSize, request, primme);
+
+   primme_phase_end(primme_phase_matvec, tstart, primme);
+}
+
+void primme_matvec_wait(void **request, primme_params *primme) {
+
+   double tstart = primme_phase_begin(primme_phase_matvec, primme);
+
+   (*primme->matrixMatvecWait)(request, primme);
+
+   phase_end(primme_phase_matvec, tstart, 0, primme);
+}
+
+/******************************************************************************
+ * Function primme_precond - Calls primme.applyPreconditioner, accounting
+ *    its time and calls in primme.stats. The number of vectors is left to
+ *    the caller, who adds it to stats.numPreconds.
+ *
+ ******************************************************************************/
+
+void primme_precond(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme) {
+
+   double tstart = primme_phase_begin(primme_phase_precond, primme);
+
+   (*primme->applyPreconditioner)(x, ldx, y, ldy, blockSize, primme);
+
+   primme_phase_end(primme_phase_precond, tstart, primme);
+}
+
+/******************************************************************************
+ * Function primme_globalSum - Calls primme.globalSumDouble, accounting its
+ *    time, calls and volume in primme.stats. Every reduction in dprimme()
+ *    and zprimme() goes through this function.
+ *
+ ******************************************************************************/
+
+void primme_globalSum(void *sendBuf, void *recvBuf, int *count, 
+   primme_params *primme) {
+
+   double tstart = primme_phase_begin(primme_phase_globalSum, primme);
+
+   (*primme->globalSumDouble)(sendBuf, recvBuf, count, primme);
+
+   primme_phase_end(primme_phase_globalSum, tstart, primme);
+   primme->stats.bytesGlobalSum += (long int)(*count)*sizeof(double);
+}
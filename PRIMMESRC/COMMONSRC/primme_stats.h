@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_stats.h
+ *
+ * Purpose - Header file containing the functions that keep the counters and
+ *           timers of primme_stats.
+ *
+ ******************************************************************************/
+
+#ifndef PRIMME_STATS_H
+#define PRIMME_STATS_H
+
+#include "primme.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void primme_reset_stats(primme_params *primme);
+double primme_phase_begin(primme_phase phase, primme_params *primme);
+void primme_phase_end(primme_phase phase, double tstart, 
+   primme_params *primme);
+void primme_matvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+void primme_matvec_begin(void *x, int *ldx, void *y, int *ldy, 
+   int *blockSize, void **request, primme_params *primme);
+void primme_matvec_wait(void **request, primme_params *primme);
+void primme_precond(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+void primme_globalSum(void *sendBuf, void *recvBuf, int *count, 
+   primme_params *primme);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIMME_STATS_H */
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_trace.c
+ *
+ * Purpose - Event trace of a call to dprimme() or zprimme(). The solver
+ *           appends timestamped events to primme.trace, a ring buffer of
+ *           primme.traceSize events that keeps the most recent ones. The
+ *           solver is the only writer, so recording takes no locks and no
+ *           I/O; the trace is formatted afterwards by primme_write_trace.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "primme.h"
+#include "wtime.h"
+#include "primme_trace.h"
+
+static const char *phaseNames[] = {"matvec", "precond", "ortho",
+   "update_projection", "solve_H", "restart", "locking", "convergence",
+   "inner_solve", "globalSum"};
+
+static const char *sizeNames[] = {"maxBasisSize", "minRestartSize",
+   "maxBlockSize"};
+
+/******************************************************************************
+ * Function primme_trace_reset - Empties the trace. A buffer set by the user
+ *    is taken to hold traceSize events and is never freed. Otherwise the
+ *    buffer allocated by PRIMME in primme.traceOwned is reused, and
+ *    reallocated if traceSize has grown beyond its capacity. Tracing is
+ *    silently disabled if the allocation fails.
+ *
+ ******************************************************************************/
+
+void primme_trace_reset(primme_params *primme) {
+
+   primme->traceCount = 0;
+   if (primme->traceSize <= 0) return;
+   if (primme->trace != NULL && primme->trace != primme->traceOwned) return;
+
+   if (primme->traceOwnedSize < primme->traceSize) {
+      free(primme->traceOwned);
+      primme->traceOwned = (primme_event *)malloc(
+            sizeof(primme_event)*primme->traceSize);
+      primme->traceOwnedSize = primme->traceOwned ? primme->traceSize : 0;
+   }
+   primme->trace = primme->traceOwned;
+}
+
+/******************************************************************************
+ * Function primme_trace_record - Appends an event to the trace, overwriting
+ *    the oldest one if the trace is full. The caller checks that primme.trace
+ *    is not NULL.
+ *
+ ******************************************************************************/
+
+void primme_trace_record(double time, primme_event_type type, 
+   primme_phase phase, int index, double value, double resNorm,
+   primme_params *primme) {
+
+   primme_event *e;
+
+   if (primme->traceSize <= 0) return;
+
+   e = &primme->trace[primme->traceCount % primme->traceSize];
+   e->time = time;
+   e->type = type;
+   e->phase = phase;
+   e->iteration = primme->stats.numOuterIterations;
+   e->index = index;
+   e->value = value;
+   e->resNorm = resNorm;
+   primme->traceCount++;
+}
+
+/******************************************************************************
+ * Function primme_write_trace - Writes the events in primme.trace, oldest
+ *    first, as Chrome trace-event JSON (loadable in chrome://tracing and
+ *    Perfetto) or as JSON lines. Times are relative to the oldest event,
+ *    in microseconds for Chrome and in seconds for JSON lines.
+ *
+ * Return Value
+ * ------------
+ *  0 - Success
+ * -1 - There is no trace
+ *
+ ******************************************************************************/
+
+int primme_write_trace(FILE *f, primme_trace_format format,
+   primme_params *primme) {
+
+   long int i, first, count;
+   double t0;
+   primme_event *e;
+   const char *sep = "";
+
+   if (primme->trace == NULL || primme->traceSize <= 0) return -1;
+
+   count = primme->traceCount < primme->traceSize ? 
+      primme->traceCount : primme->traceSize;
+   first = primme->traceCount - count;
+   t0 = count > 0 ? primme->trace[first % primme->traceSize].time : 0.0L;
+
+   if (format == primme_trace_chrome) {
+      fprintf(f, "{\"traceEvents\":[\n");
+   }
+
+   for (i = first; i < primme->traceCount; i++) {
+      e = &primme->trace[i % primme->traceSize];
+
+      if (format == primme_trace_chrome) {
+         switch (e->type) {
+         case primme_event_begin:
+         case primme_event_end:
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,"
+               "\"pid\":%d,\"tid\":0}", sep, phaseNames[e->phase],
+               e->type == primme_event_begin ? "B" : "E",
+               (e->time - t0)*1e6, primme->procID);
+            break;
+         case primme_event_ritz:
+            fprintf(f, "%s{\"name\":\"residual\",\"ph\":\"C\",\"ts\":%.3f,"
+               "\"pid\":%d,\"args\":{\"%d\":%.6e}},\n", sep,
+               (e->time - t0)*1e6, primme->procID, e->index, e->resNorm);
+            fprintf(f, "{\"name\":\"ritz value\",\"ph\":\"C\",\"ts\":%.3f,"
+               "\"pid\":%d,\"args\":{\"%d\":%.16e}}",
+               (e->time - t0)*1e6, primme->procID, e->index, e->value);
+            break;
+         case primme_event_blockSize:
+            fprintf(f, "%s{\"name\":\"blockSize\",\"ph\":\"C\",\"ts\":%.3f,"
+               "\"pid\":%d,\"args\":{\"blockSize\":%d}}", sep,
+               (e->time - t0)*1e6, primme->procID, (int)e->value);
+            break;
+         case primme_event_method:
+            fprintf(f, "%s{\"name\":\"method switch\",\"ph\":\"i\","
+               "\"s\":\"p\",\"ts\":%.3f,\"pid\":%d,\"tid\":0,"
+               "\"args\":{\"method\":%d,\"ratio\":%.6e}}", sep,
+               (e->time - t0)*1e6, primme->procID, e->index, e->value);
+            break;
+         case primme_event_tune:
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,"
+               "\"pid\":%d,\"args\":{\"%s\":%d}}", sep, sizeNames[e->index],
+               (e->time - t0)*1e6, primme->procID, sizeNames[e->index],
+               (int)e->value);
+            break;
+         case primme_event_restart:
+            fprintf(f, "%s{\"name\":\"restart\",\"ph\":\"C\",\"ts\":%.3f,"
+               "\"pid\":%d,\"args\":{\"restartSize\":%d,"
+               "\"prevRetained\":%d}}", sep, (e->time - t0)*1e6,
+               primme->procID, (int)e->value, e->index);
+         }
+         sep = ",\n";
+      }
+      else {
+         switch (e->type) {
+         case primme_event_begin:
+         case primme_event_end:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"%s\",\"phase\":\"%s\","
+               "\"iteration\":%d}\n", e->time - t0,
+               e->type == primme_event_begin ? "begin" : "end",
+               phaseNames[e->phase], e->iteration);
+            break;
+         case primme_event_ritz:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"ritz\",\"iteration\":%d,"
+               "\"index\":%d,\"value\":%.16e,\"rnorm\":%.6e}\n", e->time - t0,
+               e->iteration, e->index, e->value, e->resNorm);
+            break;
+         case primme_event_blockSize:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"blockSize\","
+               "\"iteration\":%d,\"value\":%d}\n", e->time - t0, e->iteration,
+               (int)e->value);
+            break;
+         case primme_event_method:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"method\",\"iteration\":%d,"
+               "\"index\":%d,\"value\":%.6e}\n", e->time - t0, e->iteration,
+               e->index, e->value);
+            break;
+         case primme_event_tune:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"tune\",\"iteration\":%d,"
+               "\"index\":%d,\"value\":%d}\n", e->time - t0, e->iteration,
+               e->index, (int)e->value);
+            break;
+         case primme_event_restart:
+            fprintf(f, "{\"time\":%.9f,\"event\":\"restart\","
+               "\"iteration\":%d,\"index\":%d,\"value\":%d}\n", e->time - t0,
+               e->iteration, e->index, (int)e->value);
+         }
+      }
+   }
+
+   if (format == primme_trace_chrome) {
+      fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+   }
+
+   return 0;
+}
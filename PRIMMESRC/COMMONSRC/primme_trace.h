@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: primme_trace.h
+ *
+ * Purpose - Header file containing the functions that record events in the
+ *           trace of primme_params.
+ *
+ ******************************************************************************/
+
+#ifndef PRIMME_TRACE_H
+#define PRIMME_TRACE_H
+
+#include "primme.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void primme_trace_reset(primme_params *primme);
+void primme_trace_record(double time, primme_event_type type, 
+   primme_phase phase, int index, double value, double resNorm,
+   primme_params *primme);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIMME_TRACE_H */
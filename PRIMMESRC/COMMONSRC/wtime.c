@@ -39,22 +39,29 @@
 #endif
 
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
-double primme_wTimer(int zeroTimer) {
-   static struct timeval tv;
-   static double StartingTime;
+/* Timer whose starting time is kept by the caller, so that several solvers */
+/* running as threads do not share it                                       */
+double primme_wTimer_r(double *startingTime, int zeroTimer) {
+   struct timeval tv;
    
    if (zeroTimer) {
       gettimeofday(&tv, NULL); 
-      StartingTime = ((double) tv.tv_sec) + ((double) tv.tv_usec )/(double) 1E6;
-      return StartingTime;
+      *startingTime = ((double) tv.tv_sec) + ((double) tv.tv_usec )/(double) 1E6;
+      return *startingTime;
    }
    else {
       gettimeofday(&tv, NULL); 
       return ((double) tv.tv_sec) + ((double) tv.tv_usec ) / (double) 1E6
-           - StartingTime;
+           - *startingTime;
    }
 }
 
+double primme_wTimer(int zeroTimer) {
+   static double StartingTime;
+
+   return primme_wTimer_r(&StartingTime, zeroTimer);
+}
+
 /* In the unlikely event that gettimeofday() is not available, but POSIX is, 
  * we can use the following alternative definition for primme_wTimer, 
  * after including time.h at the top.
@@ -84,7 +91,7 @@ double primme_wTimer(int zeroTimer) {
 
 /* Simply return the microseconds time of day */
 double primme_get_wtime() {
-   static struct timeval tv;
+   struct timeval tv;
 
    gettimeofday(&tv, NULL); 
    return ((double) tv.tv_sec) + ((double) tv.tv_usec ) / (double) 1E6;
@@ -93,7 +100,7 @@ double primme_get_wtime() {
 /* Return user/system times */
 double primme_get_time(double *utime, double *stime) {
    struct rusage usage;
-   static struct timeval utv,stv;
+   struct timeval utv,stv;
 
    getrusage(RUSAGE_SELF, &usage);
    utv = usage.ru_utime;
@@ -106,16 +113,20 @@ double primme_get_time(double *utime, double *stime) {
 }
 #else
 #include <Windows.h>
-double primme_wTimer(int zeroTimer) {
-   static DWORD StartingTime;
-
+double primme_wTimer_r(double *startingTime, int zeroTimer) {
    if (zeroTimer) {
-      StartingTime = GetTickCount();
-      return StartingTime;
+      *startingTime = GetTickCount();
+      return *startingTime;
    }
    else {
-      return GetTickCount() - StartingTime;
+      return GetTickCount() - *startingTime;
    }
 }
 
+double primme_wTimer(int zeroTimer) {
+   static double StartingTime;
+
+   return primme_wTimer_r(&StartingTime, zeroTimer);
+}
+
 #endif
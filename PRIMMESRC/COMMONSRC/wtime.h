@@ -34,6 +34,7 @@ extern "C" {
 #endif
 
 double primme_wTimer(int zeroTimer);
+double primme_wTimer_r(double *startingTime, int zeroTimer);
 extern double primme_get_wtime();
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
 double primme_get_time(double *, double *);
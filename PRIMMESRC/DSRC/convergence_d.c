@@ -34,6 +34,9 @@
 #include "convergence_d.h"
 #include "convergence_private_d.h"
 #include "numerical_d.h"
+#include "primme_memory.h"
+#include "primme_stats.h"
+#include "primme_trace.h"
 
 /*******************************************************************************
  * Subroutine check_convergence - This procedure checks the block vectors for  
@@ -76,6 +79,7 @@ int check_convergence_dprimme(double *V, double *W, double *hVecs,
    double *evecs, double tol, double maxConvTol, double aNormEstimate, 
    double *rwork, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_convergence, primme);
    int i;             /* Loop variable                                        */
    int left, right;   /* Range of block vectors to be checked for convergence */
    int start;         /* starting index in block of converged/tobeProject vecs*/
@@ -166,7 +170,8 @@ int check_convergence_dprimme(double *V, double *W, double *hVecs,
                    primme->printLevel >= 2) { fprintf(primme->outputFile, 
                   "#Converged %d eval[ %d ]= %e norm %e Mvecs %d Time %g\n",
                   numConverged+recentlyConverged, iev[i], hVals[iev[i]], 
-                  blockNorms[i], primme->stats.numMatvecs,primme_wTimer(0));
+                  blockNorms[i], primme->stats.numMatvecs,
+                  primme_wTimer_r(&primme->timerStart, 0));
                   fflush(primme->outputFile);
                } /* printf */
             } /*if */
@@ -192,8 +197,9 @@ int check_convergence_dprimme(double *V, double *W, double *hVecs,
       /* ---------------------------------------------------------------- */
       if (numVacancies > 0 || numToProject > 0) {
 
-         swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, 
-            blockNorms, primme->numOrthoConst + numLocked, *blockSize, left);
+         swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev,
+            flags, blockNorms, primme->numOrthoConst + numLocked, *blockSize,
+            left);
       }
       /* --------------------------------------------------------------- */
       /* Project the TO_BE_PROJECTED residuals and check for practical   */
@@ -224,6 +230,7 @@ int check_convergence_dprimme(double *V, double *W, double *hVecs,
 
    } /* while there are vacancies */
 
+   primme_phase_end(primme_phase_convergence, tstart, primme);
    return recentlyConverged;
 }
 
@@ -259,6 +266,9 @@ static void compute_resnorms(double *V, double *W, double *hVecs,
 
    int i;            /* Loop variable                             */
    int numResiduals; /* Number of residual vectors to be computed */
+   int row, rows;    /* First row and number of rows of a block   */
+   int tileRows;     /* Number of rows of the blocks              */
+   int ldV;          /* Leading dimension of V and W              */
    double *dwork = (double *) rwork;  /* pointer casting rwork to double */
    double ztmp;     /* temp var holding shift                    */
    double tpone = +1.0e+00, tzero = +0.0e+00;       /* constants */
@@ -268,34 +278,57 @@ static void compute_resnorms(double *V, double *W, double *hVecs,
    /* We want to compute residuals r = Ax-hVal*x for the Ritz vectors x */
    /* Eqivalently, r = A*V*hVec - hval*V*hVec = W*hVec - hVal*V*hVec.   */
 
-   /* Compute the Ritz vectors */
+   /* The Ritz vectors, the residuals and their norms are computed on */
+   /* blocks of rows, so the new columns are still in cache for the    */
+   /* axpy and the dot, and V and W are read in a single pass. If the  */
+   /* workspace is out of core, the next block of rows is prefetched.  */
+
+   ldV = primme->ldOPs;
+   tileRows = max(STREAM_TILE_BYTES/(2*numResiduals*(int)sizeof(double)), 1);
+   if (primme->outOfCoreDir != NULL) {
+      primme_prefetch(V, min(tileRows, primme->nLocal)*sizeof(double),
+         ldV*sizeof(double), basisSize);
+      primme_prefetch(W, min(tileRows, primme->nLocal)*sizeof(double),
+         ldV*sizeof(double), basisSize);
+   }
 
-   Num_gemm_dprimme("N", "N", primme->nLocal, numResiduals, basisSize, 
-      tpone, V, primme->nLocal, hVecs, basisSize, tzero,
-      &V[primme->nLocal*(basisSize+left)], primme->nLocal);
+   for (i=left; i <= right; i++) {
+      dwork[i] = 0.0L;
+   }
 
-   /* Compute W*hVecs */
+   for (row=0; row < primme->nLocal; row+=tileRows) {
+      rows = min(tileRows, primme->nLocal-row);
 
-   Num_gemm_dprimme("N", "N", primme->nLocal, numResiduals, basisSize, 
-      tpone, W, primme->nLocal, hVecs, basisSize, tzero,
-      &W[primme->nLocal*(basisSize+left)], primme->nLocal);
+      if (primme->outOfCoreDir != NULL && row+rows < primme->nLocal) {
+         primme_prefetch(&V[row+rows],
+            min(tileRows, primme->nLocal-row-rows)*sizeof(double),
+            ldV*sizeof(double), basisSize);
+         primme_prefetch(&W[row+rows],
+            min(tileRows, primme->nLocal-row-rows)*sizeof(double),
+            ldV*sizeof(double), basisSize);
+      }
 
-   /* Compute the residuals */
+      /* Compute the Ritz vectors and W*hVecs */
 
-   for (i=left; i <= right; i++) {
-      ztmp = -hVals[iev[i]];
-      Num_axpy_dprimme(primme->nLocal, ztmp, &V[primme->nLocal*(basisSize+i)],
-       1, &W[primme->nLocal*(basisSize+i)], 1);
-   }
+      Num_gemm_dprimme("N", "N", rows, numResiduals, basisSize, tpone,
+         &V[row], ldV, hVecs, basisSize, tzero, &V[ldV*(basisSize+left)+row],
+         ldV);
+      Num_gemm_dprimme("N", "N", rows, numResiduals, basisSize, tpone,
+         &W[row], ldV, hVecs, basisSize, tzero, &W[ldV*(basisSize+left)+row],
+         ldV);
 
-   /* Compute the residual norms */
+      /* Compute the residuals and accumulate their squared norms */
 
-   for (i=left; i <= right; i++) {
-      dwork[i] = Num_dot_dprimme(primme->nLocal, 
-      &W[primme->nLocal*(basisSize+i)], 1, &W[primme->nLocal*(basisSize+i)], 1);
+      for (i=left; i <= right; i++) {
+         ztmp = -hVals[iev[i]];
+         Num_axpy_dprimme(rows, ztmp, &V[ldV*(basisSize+i)+row], 1,
+            &W[ldV*(basisSize+i)+row], 1);
+         dwork[i] += Num_dot_dprimme(rows, &W[ldV*(basisSize+i)+row], 1,
+            &W[ldV*(basisSize+i)+row], 1);
+      }
    }
    
-   (*primme->globalSumDouble)(&dwork[left], &blockNorms[left], &numResiduals,
+   primme_globalSum(&dwork[left], &blockNorms[left], &numResiduals,
                               primme);
 
    for (i=left; i <= right; i++) {
@@ -307,7 +340,8 @@ static void compute_resnorms(double *V, double *W, double *hVecs,
 
 /*******************************************************************************
  * Subroutine print_residuals - This function displays the residual norms of 
- *    each Ritz vector computed at this iteration.
+ *    each Ritz vector computed at this iteration, and records them in the
+ *    trace if enabled.
  *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
@@ -328,6 +362,15 @@ static void print_residuals(double *ritzValues, double *blockNorms,
 
    int i;  /* Loop variable */
    int found;  /* Loop variable */
+   double t;   /* Time of the trace events */
+
+   if (primme->trace) {
+      t = primme_get_wtime();
+      for (i=left; i <= right; i++) {
+         primme_trace_record(t, primme_event_ritz, primme_phase_convergence,
+            iev[i], ritzValues[iev[i]], blockNorms[i], primme);
+      }
+   }
 
    if (primme->printLevel >= 3 && primme->procID == 0) {
 
@@ -340,7 +383,8 @@ static void print_residuals(double *ritzValues, double *blockNorms,
          fprintf(primme->outputFile, 
             "OUT %d conv %d blk %d MV %d Sec %E EV %13E |r| %.3E\n",
          primme->stats.numOuterIterations, found, i, primme->stats.numMatvecs,
-         primme_wTimer(0), ritzValues[iev[i]], blockNorms[i]);
+         primme_wTimer_r(&primme->timerStart, 0), ritzValues[iev[i]],
+         blockNorms[i]);
       }
 
       fflush(primme->outputFile);
@@ -364,6 +408,7 @@ static void print_residuals(double *ritzValues, double *blockNorms,
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * nLocal        Number of rows of V assigned to the node
+ * ldV           Leading dimension of V and W
  * basisSize     Number of vectors in the basis V
  * flags         Indicates which of the Ritz vectors have converged/flagged
  * blockSize     Number of block vectors
@@ -377,7 +422,7 @@ static void print_residuals(double *ritzValues, double *blockNorms,
  * blockNorms    the norms for each vector in the block
  ******************************************************************************/
      
-static void swap_UnconvVecs(double *V, double *W, int nLocal, 
+static void swap_UnconvVecs(double *V, double *W, int nLocal, int ldV,
    int basisSize, int *iev, int *flags, double *blockNorms, int dimEvecs, 
    int blockSize, int left) {
 
@@ -425,20 +470,20 @@ static void swap_UnconvVecs(double *V, double *W, int nLocal,
 
          if (flags[iev[left]] != TO_BE_PROJECTED) { 
                 /* replace */
-            Num_dcopy_dprimme(nLocal, &V[nLocal*(basisSize+right)], 1,
-               &V[nLocal*(basisSize+left)], 1);
-            Num_dcopy_dprimme(nLocal, &W[nLocal*(basisSize+right)], 1,
-               &W[nLocal*(basisSize+left)], 1);
+            Num_dcopy_dprimme(nLocal, &V[ldV*(basisSize+right)], 1,
+               &V[ldV*(basisSize+left)], 1);
+            Num_dcopy_dprimme(nLocal, &W[ldV*(basisSize+right)], 1,
+               &W[ldV*(basisSize+left)], 1);
             temp = iev[left];
             iev[left] = iev[right];
             iev[right] = temp;
             blockNorms[left] = blockNorms[right];
          }
          else { /* swap */
-            Num_swap_dprimme(nLocal, &V[nLocal*(basisSize+left)], 1, 
-                              &V[nLocal*(basisSize+right)], 1);
-            Num_swap_dprimme(nLocal, &W[nLocal*(basisSize+left)], 1, 
-                              &W[nLocal*(basisSize+right)], 1);
+            Num_swap_dprimme(nLocal, &V[ldV*(basisSize+left)], 1, 
+                              &V[ldV*(basisSize+right)], 1);
+            Num_swap_dprimme(nLocal, &W[ldV*(basisSize+left)], 1, 
+                              &W[ldV*(basisSize+right)], 1);
             temp = iev[left];
             iev[left] = iev[right];
             iev[right] = temp;
@@ -560,7 +605,7 @@ static void check_practical_convergence(double *V, double *W,
    int *recentlyConverged, int *numVacancies, double *rwork, 
    primme_params *primme) {
 
-   int i, n, dimEvecs;
+   int i, n, ldV, dimEvecs;
    int count; 
    double normPr; 
    double normDiff;
@@ -569,6 +614,7 @@ static void check_practical_convergence(double *V, double *W,
 
    /* convenience variables */
    n        = primme->nLocal;
+   ldV      = primme->ldOPs;
    dimEvecs = primme->numOrthoConst + numLocked;
 
    /* Subdivide rwork */
@@ -587,8 +633,8 @@ static void check_practical_convergence(double *V, double *W,
          flags[iev[i]] = UNCONVERGED;
 
    if (*numVacancies > 0)
-      swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, 
-                   blockNorms, dimEvecs, blockSize, start);
+      swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev,
+                   flags, blockNorms, dimEvecs, blockSize, start);
 
    /* ------------------------------------------------------------------ */
    /* Project the numToProject residuals agaist (I-evecs*evecs')         */
@@ -597,15 +643,15 @@ static void check_practical_convergence(double *V, double *W,
    /* overlaps = evecs'*residuals */
 
    Num_gemm_dprimme("C", "N", dimEvecs, numToProject, n, tpone, evecs, n, 
-                  &W[(basisSize+start)*n], n, tzero, rwork, dimEvecs);
+                  &W[(basisSize+start)*ldV], ldV, tzero, rwork, dimEvecs);
 
    count = dimEvecs*numToProject;
-   (*primme->globalSumDouble)(rwork, overlaps, &count, primme);
+   primme_globalSum(rwork, overlaps, &count, primme);
 
    /* residuals = residuals - evecs*overlaps */
 
    Num_gemm_dprimme("N", "N", n, numToProject, dimEvecs, tmone, evecs, n, 
-                  overlaps, dimEvecs, tpone, &W[(basisSize+start)*n], n);
+                  overlaps, dimEvecs, tpone, &W[(basisSize+start)*ldV], ldV);
 
    /* ------------------------------------------------------------------ */
    /* Compute norms^2 of the projected res and the differences from res  */ 
@@ -617,12 +663,12 @@ static void check_practical_convergence(double *V, double *W,
       rwork[i] = Num_dot_dprimme(dimEvecs, &overlaps[dimEvecs*i], 1, 
                                 &overlaps[dimEvecs*i], 1);
       /* || (I-QQ')res || */
-      rwork[i+numToProject] = Num_dot_dprimme(n, &W[(basisSize+start+i)*n], 1,
-                                &W[(basisSize+start+i)*n], 1);
+      rwork[i+numToProject] = Num_dot_dprimme(n, &W[(basisSize+start+i)*ldV],
+                                1, &W[(basisSize+start+i)*ldV], 1);
    }
    /* global sum ||overlaps|| and ||(I-QQ')r|| */
    count = 2*numToProject;
-   (*primme->globalSumDouble)(rwork, &rwork[count], &count, primme);
+   primme_globalSum(rwork, &rwork[count], &count, primme);
 
    /* ------------------------------------------------------------------ */
    /* For each projected residual check whether there is an accuracy     */
@@ -662,7 +708,7 @@ static void check_practical_convergence(double *V, double *W,
 
    start = blockSize - *numVacancies;
 
-   swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, blockNorms, 
-                         dimEvecs, blockSize, start);
+   swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev, flags,
+                         blockNorms, dimEvecs, blockSize, start);
 
 }
@@ -37,7 +37,7 @@ static void print_residuals(double *ritzValues, double *blockNorms,
    int numConverged, int numLocked, int *iev, int left, int right, 
    primme_params *primme);
 
-static void swap_UnconvVecs(double *V, double *W, int nLocal, 
+static void swap_UnconvVecs(double *V, double *W, int nLocal, int ldV,
    int basisSize, int *iev, int *flag, double *blockNorms, int dimEvecs, 
    int blockSize, int left);
 
@@ -42,8 +42,8 @@ static void mergeSort(double *lockedEvals, int numLocked, double *ritzVals,
 static void Olsen_preconditioner_block(double *r, double *x,
    int blockSize, double *rwork, primme_params *primme) ;
 
-static void apply_preconditioner_block(double *v, double *result,
-   int blockSize, primme_params *primme);
+static void apply_preconditioner_block(double *v, int ldv, double *result,
+   int ldresult, int blockSize, primme_params *primme);
 
 static void setup_JD_projectors(double *x, double *r, double *evecs,
    double *evecsHat, double *Kinvx, double *xKinvx,
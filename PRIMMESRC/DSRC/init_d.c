@@ -39,6 +39,7 @@
 #include "factorize_d.h"
 #include "numerical_d.h"
 #include "wtime.h"                       /* Needed for CostModel */
+#include "primme_stats.h"
 
 
 /*******************************************************************************
@@ -162,11 +163,12 @@ int init_basis_dprimme(double *V, double *W, double *evecs,
 
       if (UDU != NULL) {
 
-         (*primme->applyPreconditioner)
-            (evecs, evecsHat, &primme->numOrthoConst, primme); 
+         primme_precond(evecs, &primme->nLocal, evecsHat,
+            &primme->nLocal, &primme->numOrthoConst, primme); 
          primme->stats.numPreconds += primme->numOrthoConst;
 
-         update_projection_dprimme(evecs, evecsHat, M, 0, 
+         update_projection_dprimme(evecs, primme->nLocal, evecsHat,
+            primme->nLocal, M, 0, 
             primme->numOrthoConst+primme->numEvals, primme->numOrthoConst, 
             rwork, primme);
 
@@ -210,12 +212,12 @@ int init_basis_dprimme(double *V, double *W, double *evecs,
       /* the user                                                     */
 
          /* Copy over the initial guesses provided by the user */
-         Num_dcopy_dprimme(primme->nLocal*primme->initSize, 
-            &evecs[primme->numOrthoConst*primme->nLocal], 1, V, 1);
+         Num_copy_matrix_dprimme(&evecs[primme->numOrthoConst*primme->nLocal],
+            primme->nLocal, primme->initSize, primme->nLocal, V, primme->ldOPs);
 
          /* Orthonormalize the guesses provided by the user */ 
 
-         ret = ortho_dprimme(V, primme->nLocal, 0, primme->initSize-1, 
+         ret = ortho_dprimme(V, primme->ldOPs, 0, primme->initSize-1, 
             evecs, primme->nLocal, primme->numOrthoConst, primme->nLocal, 
             primme->iseed, machEps, rwork, rworkSize, primme);
 
@@ -271,10 +273,10 @@ int init_basis_dprimme(double *V, double *W, double *evecs,
 
       if (primme->initSize > 0) {
          currentSize = min(primme->initSize, primme->minRestartSize);
-         Num_dcopy_dprimme(primme->nLocal*currentSize, 
-            &evecs[primme->numOrthoConst*primme->nLocal], 1, V, 1);
+         Num_copy_matrix_dprimme(&evecs[primme->numOrthoConst*primme->nLocal],
+            primme->nLocal, currentSize, primme->nLocal, V, primme->ldOPs);
 
-         ret = ortho_dprimme(V, primme->nLocal, 0, currentSize-1, evecs,
+         ret = ortho_dprimme(V, primme->ldOPs, 0, currentSize-1, evecs,
             primme->nLocal, primme->numOrthoConst, primme->nLocal,
             primme->iseed, machEps, rwork, rworkSize, primme);
 
@@ -317,11 +319,12 @@ int init_basis_dprimme(double *V, double *W, double *evecs,
    /* Put dummy results in the first open space of W (currentSize)*/
    /* ----------------------------------------------------------- */
    if (primme->dynamicMethodSwitch) {
-      currentSize = primme->nLocal*(*basisSize);
+      currentSize = primme->ldOPs*(*basisSize);
       ret = 1;
-      *timeForMV = primme_wTimer(0);
-       (*primme->matrixMatvec)(V, &W[currentSize], &ret, primme);
-      *timeForMV = primme_wTimer(0) - *timeForMV;
+      *timeForMV = primme_wTimer_r(&primme->timerStart, 0);
+       primme_matvec(V, &primme->ldOPs, &W[currentSize],
+          &primme->ldOPs, &ret, primme);
+      *timeForMV = primme_wTimer_r(&primme->timerStart, 0) - *timeForMV;
       primme->stats.numMatvecs += 1;
    }
       
@@ -382,8 +385,8 @@ static int init_block_krylov(double *V, double *W, int dv1, int dv2,
 
       /* Create and orthogonalize the inital vectors */
 
-      Num_larnv_dprimme(2, primme->iseed,primme->nLocal,&V[primme->nLocal*dv1]);
-      ret = ortho_dprimme(V, primme->nLocal, dv1, dv1, locked, 
+      Num_larnv_dprimme(2, primme->iseed,primme->nLocal,&V[primme->ldOPs*dv1]);
+      ret = ortho_dprimme(V, primme->ldOPs, dv1, dv1, locked, 
          primme->nLocal, numLocked, primme->nLocal, primme->iseed, machEps, 
          rwork, rworkSize, primme);
 
@@ -396,11 +399,11 @@ static int init_block_krylov(double *V, double *W, int dv1, int dv2,
       /* Generate the remainder of the Krylov space. */
 
       for (i = dv1; i < dv2; i++) {
-         (*primme->matrixMatvec)
-           (&V[primme->nLocal*i], &V[primme->nLocal*(i+1)], &ONE, primme);
-         Num_dcopy_dprimme(primme->nLocal, &V[primme->nLocal*(i+1)], 1,
-            &W[primme->nLocal*i], 1);
-         ret = ortho_dprimme(V, primme->nLocal, i+1, i+1, locked, 
+         primme_matvec(&V[primme->ldOPs*i], &primme->ldOPs,
+            &V[primme->ldOPs*(i+1)], &primme->ldOPs, &ONE, primme);
+         Num_dcopy_dprimme(primme->nLocal, &V[primme->ldOPs*(i+1)], 1,
+            &W[primme->ldOPs*i], 1);
+         ret = ortho_dprimme(V, primme->ldOPs, i+1, i+1, locked, 
             primme->nLocal, numLocked, primme->nLocal, primme->iseed, machEps,
             rwork, rworkSize, primme);
       
@@ -420,21 +423,23 @@ static int init_block_krylov(double *V, double *W, int dv1, int dv2,
    /* Generate the initial vectors.                                        */
    /*----------------------------------------------------------------------*/
 
-      Num_larnv_dprimme(2, primme->iseed, primme->nLocal*primme->maxBlockSize,
-         &V[primme->nLocal*dv1]);
-      ret = ortho_dprimme(V, primme->nLocal, dv1, 
+      for (i = dv1; i < dv1+primme->maxBlockSize; i++) {
+         Num_larnv_dprimme(2, primme->iseed, primme->nLocal,
+            &V[primme->ldOPs*i]);
+      }
+      ret = ortho_dprimme(V, primme->ldOPs, dv1, 
          dv1+primme->maxBlockSize-1, locked, primme->nLocal, numLocked, 
          primme->nLocal, primme->iseed, machEps, rwork, rworkSize, primme);
 
       /* Generate the remaining vectors in the sequence */
 
       for (i = dv1+primme->maxBlockSize; i <= dv2; i++) {
-         (*primme->matrixMatvec)(&V[primme->nLocal*(i-primme->maxBlockSize)], 
-            &V[primme->nLocal*i], &ONE, primme);
-         Num_dcopy_dprimme(primme->nLocal, &V[primme->nLocal*i], 1,
-            &W[primme->nLocal*(i-primme->maxBlockSize)], 1);
+         primme_matvec(&V[primme->ldOPs*(i-primme->maxBlockSize)], 
+            &primme->ldOPs, &V[primme->ldOPs*i], &primme->ldOPs, &ONE, primme);
+         Num_dcopy_dprimme(primme->nLocal, &V[primme->ldOPs*i], 1,
+            &W[primme->ldOPs*(i-primme->maxBlockSize)], 1);
 
-         ret = ortho_dprimme(V, primme->nLocal, i, i, locked, 
+         ret = ortho_dprimme(V, primme->ldOPs, i, i, locked, 
             primme->nLocal, numLocked, primme->nLocal, primme->iseed, machEps,
             rwork, rworkSize, primme);
 
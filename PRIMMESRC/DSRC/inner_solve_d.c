@@ -35,6 +35,7 @@
 #include "inner_solve_private_d.h"
 #include "factorize_d.h"
 #include "numerical_d.h"
+#include "primme_stats.h"
 
 
 /*******************************************************************************
@@ -96,7 +97,7 @@
  * machEps     machine precision
  *
  * rwork       Real workspace of size 
- *             4*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals)
+ *             3*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals)
  *
  * rworkSize   Size of the rwork array
  *
@@ -105,8 +106,8 @@
  *
  * Input/Output parameters
  * -----------------------
- * r       The residual with respect to the Ritz vector.  May be altered upon
- *         return.
+ * r       The residual with respect to the Ritz vector. It is overwritten
+ *         with the residual of the linear system during the iteration.
  * rnorm   On input, the 2 norm of r. No need to recompute it initially.
  *         On output, the estimated 2 norm of the updated eigenvalue residual
  * 
@@ -129,6 +130,7 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
    double eresTol, double aNormEstimate, double machEps, double *rwork, 
    int rworkSize, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_inner_solve, primme);
    int i;             /* loop variable                                       */
    int numIts;        /* Number of inner iterations                          */
    int ret;           /* Return value used for error checking.               */
@@ -164,8 +166,8 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
    /* Subdivide the workspace into needed arrays */
    /* -------------------------------------------*/
 
-   g      = rwork;
-   d      = g + primme->nLocal;
+   g      = r;     /* Assume zero initial guess; iterate on r in place */
+   d      = rwork;
    delta  = d + primme->nLocal;
    w      = delta + primme->nLocal;
    workSpace = w + primme->nLocal; /* This needs at least 2*numOrth+NumEvals) */
@@ -222,9 +224,6 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
    /* Rest of initializations                                 */
    /* --------------------------------------------------------*/
 
-   /* Assume zero initial guess */
-   Num_dcopy_dprimme(primme->nLocal, r, 1, g, 1);
-
    ret = apply_projected_preconditioner(g, evecs, RprojectorQ, 
            x, RprojectorX, sizeRprojectorQ, sizeRprojectorX, 
            xKinvx, UDU, ipivot, d, workSpace, primme);
@@ -377,7 +376,8 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
          if (primme->printLevel >= 4 && primme->procID == 0) {
             fprintf(primme->outputFile,
            "INN MV %d Sec %e Eval %e Lin|r| %.3e EV|r| %.3e\n", primme->stats.
-            numMatvecs, primme_wTimer(0), eval_updated, tau, eres_updated);
+            numMatvecs, primme_wTimer_r(&primme->timerStart, 0), eval_updated,
+            tau, eres_updated);
             fflush(primme->outputFile);
          }
 
@@ -388,7 +388,7 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
         /* Report for non adaptive inner iterations */
         fprintf(primme->outputFile,
            "INN MV %d Sec %e Lin|r| %e\n", primme->stats.numMatvecs,
-           primme_wTimer(0),tau);
+           primme_wTimer_r(&primme->timerStart, 0),tau);
         fflush(primme->outputFile);
       }
 
@@ -428,6 +428,7 @@ int inner_solve_dprimme(double *x, double *r, double *rnorm,
      /* --------------------------------------------------------*/
 
    *rnorm = eres_updated;
+   primme_phase_end(primme_phase_inner_solve, tstart, primme);
    return 0;
 }
    
@@ -488,7 +489,8 @@ static int apply_projected_preconditioner(double *v, double *Q,
 
    if (primme->correctionParams.precondition) {
       /* Place K^{-1}v in result */
-      (*primme->applyPreconditioner)(v, result, &ONE, primme);
+      primme_precond(v, &primme->nLocal, result,
+         &primme->nLocal, &ONE, primme);
       primme->stats.numPreconds += 1;
    }
    else {
@@ -585,7 +587,7 @@ static int apply_skew_projector(double *Q, double *Qhat, double *UDU,
 
          /* Global sum: overlaps = Q'*v */
          count = numCols;
-         (*primme->globalSumDouble)(workSpace, overlaps, &count, primme);   
+         primme_globalSum(workSpace, overlaps, &count, primme);   
 
          /* --------------------------------------------*/
          /* Backsolve only if there is a skew projector */
@@ -647,7 +649,8 @@ static void apply_projected_matrix(double *v, double shift, double *Q,
    
    int ONE = 1;   /* For passing it by reference in matrixMatvec */
 
-   (*primme->matrixMatvec)(v, result, &ONE, primme);
+   primme_matvec(v, &primme->nLocal, result, &primme->nLocal, &ONE,
+      primme);
    Num_axpy_dprimme(primme->nLocal, -shift, v, 1, result, 1); 
    if (dimQ > 0)
       apply_projector(Q, dimQ, result, rwork, primme); 
@@ -692,7 +695,7 @@ static void apply_projector(double *Q, int numCols, double *v,
    Num_gemv_dprimme("C", primme->nLocal, numCols, tpone, Q, primme->nLocal,
       v, 1, tzero, workSpace, 1);
    count = numCols;
-   (*primme->globalSumDouble)(workSpace, overlaps, &count, primme);   
+   primme_globalSum(workSpace, overlaps, &count, primme);   
    Num_gemv_dprimme("N", primme->nLocal, numCols, tmone, Q, primme->nLocal,
       overlaps, 1, tpone, v, 1);
 
@@ -724,7 +727,7 @@ static double dist_dot(double *x, int incx,
                                                                                 
    temp = Num_dot_dprimme(primme->nLocal, x, incx, y, incy);
    count = 1;
-   (*primme->globalSumDouble)(&temp, &product, &count, primme);
+   primme_globalSum(&temp, &product, &count, primme);
    return product;
                                                                                 
 }
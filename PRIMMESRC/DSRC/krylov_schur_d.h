@@ -0,0 +1,38 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: krylov_schur.h
+ *
+ * Purpose - Prototypes for the Krylov-Schur engine in krylov_schur.c
+ *
+ ******************************************************************************/
+
+#ifndef KRYLOV_SCHUR_H
+#define KRYLOV_SCHUR_H
+
+int krylov_schur_applies_dprimme(primme_params *primme);
+
+int krylov_schur_dprimme(double *evals, int *perm, double *evecs,
+   double *resNorms, double machEps, int *intWork, void *realWork, 
+   primme_params *primme);
+
+#endif /* KRYLOV_SCHUR_H */
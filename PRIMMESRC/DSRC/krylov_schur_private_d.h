@@ -0,0 +1,45 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: krylov_schur_private.h
+ *
+ * Purpose - Definitions used exclusively by krylov_schur.c
+ *
+ ******************************************************************************/
+
+#ifndef KRYLOV_SCHUR_PRIVATE_H
+#define KRYLOV_SCHUR_PRIVATE_H
+
+/* Failure codes returned by krylov_schur, as those of main_iter */
+
+#define MAX_ITERATIONS_REACHED    -1
+#define ORTHO_FAILURE             -3
+#define SOLVE_H_FAILURE           -4
+
+static double next_vector_coefficient(double *v, double *w, 
+   primme_params *primme);
+
+static int krylov_resnorms(double *hVecs, double *hVals, int basisSize,
+   double beta, double tol, double largestRitzValue, double *resNorms, 
+   primme_params *primme);
+
+#endif /* KRYLOV_SCHUR_PRIVATE_H */
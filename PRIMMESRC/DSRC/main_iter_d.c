@@ -44,6 +44,8 @@
 #include "update_projection_d.h"
 #include "update_W_d.h"
 #include "numerical_d.h"
+#include "primme_stats.h"
+#include "primme_trace.h"
 
 /******************************************************************************
  * Subroutine main_iter - This routine implements a more general, parallel, 
@@ -102,6 +104,9 @@
  *              only primme.initSize vectors in evecs.
  *           Without locking all numEvals approximations are in evecs
  *              but only the initSize ones are converged.
+ *           When stopped by the monitor or by maxTime, it stores instead
+ *              the number of pairs returned in evals, evecs and resNorms;
+ *              the remaining entries are undefined.
  *           During the execution, access to primme.initSize gives 
  *              the number of converged pairs up to that point. The pairs
  *              are available in evals and evecs, but only when locking is used
@@ -116,6 +121,10 @@
  *       -5 if solve_correction failed
  *       -6 if restart failed
  *       -7 if lock_vectors failed
+ *        2 if primme.monitor requested to stop. The first initSize pairs
+ *          returned are the locked pairs followed by the current
+ *          approximations; resNorms tells which are converged
+ *        3 if primme.maxTime was about to be exceeded. Returns as above
  *       
  ******************************************************************************/
 
@@ -137,10 +146,14 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
    int numConvergedStored;  /* Numb of Ritzvecs temporarily stored in evecs  */
                             /*    to allow for skew projectors w/o locking   */
    int converged;           /* True when all required Ritz vals. converged   */
+   int numValid;            /* Number of pairs returned when stopping early  */
    int LockingProblem;      /* Flag==1 if practically converged pairs locked */
    int restartLimitReached; /* True when maximum restarts performed          */
+   int stop;                /* MONITOR_STOP or DEADLINE_STOP to return the   */
+                            /* current approximations, 0 to continue         */
    int numPrevRetained;     /* Number of vectors retained using recurrence-  */
                             /* based restarting.                             */
+   int restartSize;         /* Ritz vectors to restart with, as tuned        */
    int maxEvecsSize;        /* Maximum capacity of evecs array               */
    int doubleSize;          /* sizeof the three double arrays hVals,         */
                             /*                      prevRitzVals, blockNorms */
@@ -153,6 +166,7 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
    int *ipivot;             /* The pivot for the UDU factorization of M      */
    int *iev;                /* Evalue index each block vector corresponds to */
    int ONE = 1;             /* To be passed by reference in matrixMatvec     */
+   void *mvRequest;         /* Handle of the split-phase matvec in update_W */
 
    double largestRitzValue; /* The largest modulus of any Ritz value computed*/
    double tol;              /* Required tolerance for residual norms         */
@@ -174,14 +188,23 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                             /* by robust shifting algorithm in correction.c  */
    double *blockNorms;      /* Residual norms corresponding to current block */
                             /* vectors.                                      */
+   double targetResNorm = 0.0L; /* Residual norm of the first block vector   */
+                            /* at the last convergence check; the correction */
+                            /* overwrites blockNorms with estimates          */
    double tpone = +1.0e+00;/* constant 1.0 of type double */
    double tzero = +0.0e+00;/* constant 0.0 of type double */
 
    /* Runtime measurement variables for dynamic method switching             */
    primme_CostModel CostModel; /* Structure holding the runtime estimates of */
                             /* the parameters of the model.Only visible here */
+   int dynamicModel = FALSE;/* True if CostModel is in use                   */
    double timeForMV;        /* Measures time for 1 matvec operation          */
    double tstart;           /* Timing variable for accumulative time spent   */
+   int sumsStart = 0;       /* stats.numGlobalSumCalls before the correction */
+   long int bytesStart = 0; /* stats.bytesGlobalSum before the correction    */
+   double tLastCheck = 0.0L;/* Elapsed time at the last check of maxTime     */
+   primme_TuneModel Tune;   /* Sizes in use and measurements for autoTune    */
+   primme_RestartModel Adapt; /* State of the adaptive restarting policy     */
 
    /* -------------------------------------------------------------- */
    /* Subdivide the workspace                                        */
@@ -190,8 +213,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
    maxEvecsSize = primme->numOrthoConst + primme->numEvals;
 
    V             = (double *) realWork;
-   W             = V + primme->nLocal*primme->maxBasisSize;
-   H             = W + primme->nLocal*primme->maxBasisSize;
+   W             = V + primme->ldOPs*primme->maxBasisSize;
+   H             = W + primme->ldOPs*primme->maxBasisSize;
    hVecs         = H + primme->maxBasisSize*primme->maxBasisSize;
    previousHVecs = hVecs + primme->maxBasisSize*primme->maxBasisSize;
    if (! (primme->correctionParams.precondition && 
@@ -233,11 +256,11 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
    /* Initialize counters and flags                                  */
    /* -------------------------------------------------------------- */
 
-   primme->stats.numOuterIterations = 0;
-   primme->stats.numRestarts = 0;
-   primme->stats.numMatvecs = 0;
+   primme_reset_stats(primme);
+   primme_trace_reset(primme);
    numLocked = 0;
    converged = FALSE;
+   stop = 0;
    LockingProblem = 0;
 
    numPrevRetained = 0;
@@ -267,7 +290,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
 
    if (primme->n == 1) {
       evecs[0] = tpone;
-      (*primme->matrixMatvec)(&evecs[0], W, &ONE, primme);
+      primme_matvec(&evecs[0], &primme->nLocal, W, &primme->ldOPs,
+         &ONE, primme);
       evals[0] = W[0];
       V[0] = tpone;
 
@@ -302,14 +326,27 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
       else
          primme->dynamicMethodSwitch = 3;   /* Start GD+k for 1st pair */
       primme->correctionParams.maxInnerIterations = 0; 
+      dynamicModel = TRUE;
+
+      /* Skip the tentative GD+k phase with a model from a previous run */
+      if (primme->costModel && primme->costModel->calibrated) {
+         load_model(&CostModel, primme->costModel, primme);
+      }
    }
 
+   /* --------------------------------------------------------------- */
+   /* The basis, restart and block sizes start as given by the user;  */
+   /* with autoTune they are revised at every restart                 */
+   /* --------------------------------------------------------------- */
+   initializeTune(&Tune, primme);
+   initializeRestartModel(&Adapt, primme);
+
    /* ---------------------------------------------------------------------- */
    /* Outer most loop                                                        */
    /* Without locking, restarting can cause converged Ritz values to become  */
    /* unconverged. Keep performing JD iterations until they remain converged */
    /* ---------------------------------------------------------------------- */
-   while (!converged &&
+   while (!converged && !stop &&
           ( primme->maxMatvecs == 0 || 
             primme->stats.numMatvecs < primme->maxMatvecs ) &&
           ( primme->maxOuterIterations == 0 ||
@@ -322,8 +359,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
 
       /* Compute the initial H and solve for its eigenpairs */
    
-      update_projection_dprimme(V, W, H, 0,primme->maxBasisSize,basisSize,
-         hVecs,primme);
+      update_projection_dprimme(V, primme->ldOPs, W, primme->ldOPs, H, 0,
+         primme->maxBasisSize, basisSize, hVecs, primme);
       ret = solve_H_dprimme(H, hVecs, hVals, basisSize, primme->maxBasisSize,
          &largestRitzValue, numLocked, rworkSize, rwork, iwork, primme);
 
@@ -337,7 +374,7 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
       /* Begin the iterative process.  Keep restarting until all of the */
       /* required eigenpairs have been found (no verification)          */
       /* -------------------------------------------------------------- */
-      while (numConverged < primme->numEvals &&
+      while (numConverged < primme->numEvals && !stop &&
              ( primme->maxMatvecs == 0 || 
                primme->stats.numMatvecs < primme->maxMatvecs ) &&
              ( primme->maxOuterIterations == 0 ||
@@ -349,7 +386,7 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
          /* maximum size or the basis plus the locked vectors span the entire */
          /* space. Once this happens, restart with a smaller basis.           */
          /* ----------------------------------------------------------------- */
-         while (basisSize < primme->maxBasisSize &&
+         while (basisSize < Tune.basisSize &&
                 basisSize < primme->n - primme->numOrthoConst - numLocked &&
                 ( primme->maxMatvecs == 0 || 
                   primme->stats.numMatvecs < primme->maxMatvecs) &&
@@ -362,8 +399,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
             /* Adjust the block size if necessary. Remember the available for */
             /* expansion slots in the basis, as blockSize may be reduced later*/
 
-            adjust_blockSize(iev, flag, &blockSize, primme->maxBlockSize, 
-               &ievMax, basisSize, primme->maxBasisSize, numLocked, 
+            adjust_blockSize(iev, flag, &blockSize, Tune.blockSize, 
+               &ievMax, basisSize, Tune.basisSize, numLocked, 
                numConverged, primme->numEvals, primme->n);
             AvailableBlockSize = blockSize;
 
@@ -373,6 +410,12 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                hVals, flag, basisSize, iev, &ievMax, blockNorms, &blockSize, 
                numConverged, numLocked, evecs, tol, maxConvTol, 
                largestRitzValue, rwork, primme);
+            targetResNorm = blockNorms[0];
+
+            if (primme->trace) {
+               primme_trace_record(primme_get_wtime(), primme_event_blockSize,
+                  primme_phase_convergence, 0, blockSize, 0.0L, primme);
+            }
 
             /* If the total number of converged pairs, including the     */
             /* recentlyConverged ones, are greater than or equal to the  */
@@ -382,6 +425,18 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
 
             numConverged += recentlyConverged;
 
+            if (primme->monitor && (*primme->monitor)(hVals, flag, basisSize,
+                     iev, blockNorms, blockSize, evals, numLocked, 
+                     numConverged, primme)) {
+               stop = MONITOR_STOP;
+               break;
+            }
+
+            if (primme->maxTime > 0.0L && deadline_near(&tLastCheck, primme)) {
+               stop = DEADLINE_STOP;
+               break;
+            }
+
             if (numConverged >= primme->numEvals ||
                 (primme->locking && recentlyConverged > 0
                     && primme->target != primme_smallest
@@ -399,8 +454,10 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
 
             if (blockSize == 0) {
                blockSize = AvailableBlockSize;
-               Num_scal_dprimme(blockSize*primme->nLocal, tzero,
-                  &V[primme->nLocal*basisSize], 1);
+               for (i=basisSize; i < basisSize+blockSize; i++) {
+                  Num_scal_dprimme(primme->nLocal, tzero,
+                     &V[primme->ldOPs*i], 1);
+               }
             }
             else {
 
@@ -410,7 +467,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                /* - - - - - - - - - - - - - - - - - - - - - - - - - - -  */
                /* If dynamic method switching, time the inner method     */
                if (primme->dynamicMethodSwitch > 0) {
-                  tstart = primme_wTimer(0); /* accumulate correction time */
+                  /* accumulate correction time */
+                  tstart = primme_wTimer_r(&primme->timerStart, 0);
 
                   if (CostModel.resid_0 == -1.0L)       /* remember the very */
                      CostModel.resid_0 = blockNorms[0]; /* first residual */
@@ -429,6 +487,9 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                         case 2: case 4: switch_from_JDQMR(&CostModel,primme);
                      } /* of if-switch */
                   } /* of recentlyConv > 0 || dyn==2 */
+
+                  sumsStart = primme->stats.numGlobalSumCalls;
+                  bytesStart = primme->stats.bytesGlobalSum;
                } /* dynamic switching */
                /* - - - - - - - - - - - - - - - - - - - - - - - - - - -  */
 
@@ -447,15 +508,21 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                /* ------------------------------------------------------ */
                /* If dynamic method switch, accumulate inner method time */
                /* ------------------------------------------------------ */
-               if (primme->dynamicMethodSwitch > 0) 
-                  CostModel.time_in_inner += primme_wTimer(0) - tstart;
+               if (primme->dynamicMethodSwitch > 0) {
+                  CostModel.time_in_inner +=
+                     primme_wTimer_r(&primme->timerStart, 0) - tstart;
+                  CostModel.sums_in_inner += 
+                     primme->stats.numGlobalSumCalls - sumsStart;
+                  CostModel.bytes_in_inner += 
+                     primme->stats.bytesGlobalSum - bytesStart;
+               }
 
             } /* end of else blocksize=0 */
 
             /* Orthogonalize the corrections with respect to each other */
             /* and the current basis.                                   */
 
-            ret = ortho_dprimme(V, primme->nLocal, basisSize, 
+            ret = ortho_dprimme(V, primme->ldOPs, basisSize, 
                basisSize+blockSize-1, evecs, primme->nLocal, 
                primme->numOrthoConst+numLocked, primme->nLocal, primme->iseed, 
                machEps, rwork, rworkSize,primme);
@@ -466,17 +533,26 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                return ORTHO_FAILURE;
             }
            
-            /* Compute W = A*V for the orthogonalized corrections */
+            /* Start W = A*V for the orthogonalized corrections. While */
+            /* the product is in flight, retain the coefficients of the */
+            /* previous Ritz vectors, which does not depend on W.       */
 
-            update_W_dprimme(V, W, basisSize, blockSize, primme);
+            Tune.timeMV_0 = primme->stats.timeMatvec;
+            update_W_begin_dprimme(V, W, basisSize, blockSize, &mvRequest,
+               primme);
+            numPrevRetained = retain_previous_coefficients(hVecs, 
+               previousHVecs, basisSize, Tune.basisSize, Adapt.prevRetain,
+               iev, blockSize, primme);
+            update_W_wait_dprimme(&mvRequest, primme);
+            if (primme->autoTune) {
+               tune_matvec(&Tune, basisSize, blockSize, primme);
+            }
 
             /* Extend H by blockSize columns and rows and solve the */
             /* eigenproblem for the new H.                          */
 
-            numPrevRetained = retain_previous_coefficients(hVecs, 
-               previousHVecs, basisSize, iev, blockSize, primme);
-            update_projection_dprimme(V, W, H, basisSize, 
-               primme->maxBasisSize, blockSize, hVecs, primme);
+            update_projection_dprimme(V, primme->ldOPs, W, primme->ldOPs, H,
+               basisSize, primme->maxBasisSize, blockSize, hVecs, primme);
             basisSize = basisSize + blockSize;
             ret = solve_H_dprimme(H, hVecs, hVals, basisSize, 
                primme->maxBasisSize, &largestRitzValue, numLocked, rworkSize, 
@@ -496,10 +572,16 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
          /* Restart the basis  */
          /* ------------------ */
 
+         restartSize = Tune.restartSize;
+         if (primme->restartingParams.scheme == primme_thick_adaptive) {
+            restartSize = adapt_restart(&Adapt, hVals, iev, basisSize, 
+               numConverged, targetResNorm, &Tune, primme);
+         }
+
          basisSize = restart_dprimme(V, W, H, hVecs, hVals, flag, iev, 
             evecs, evecsHat, M, UDU, ipivot, basisSize, numConverged, 
-            &numConvergedStored, numLocked, numGuesses, previousHVecs, 
-            numPrevRetained, machEps, rwork, rworkSize, primme);
+            &numConvergedStored, numLocked, numGuesses, restartSize, 
+            previousHVecs, numPrevRetained, machEps, rwork, rworkSize, primme);
 
          if (basisSize <= 0) {
             primme_PushErrorMessage(Primme_main_iter, Primme_restart, 
@@ -507,6 +589,20 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
             return RESTART_FAILURE;
          }
 
+         primme->stats.meanRestartSize = (primme->stats.meanRestartSize*
+            primme->stats.numRestarts + basisSize)/(primme->stats.numRestarts+1);
+         primme->stats.meanPrevRetained = (primme->stats.meanPrevRetained*
+            primme->stats.numRestarts + numPrevRetained)/
+            (primme->stats.numRestarts+1);
+         if (primme->trace) {
+            primme_trace_record(primme_get_wtime(), primme_event_restart,
+               primme_phase_restart, numPrevRetained, basisSize, 0.0L, primme);
+         }
+
+         if (primme->autoTune) {
+            tune_sizes(&Tune, basisSize, targetResNorm, numConverged, primme);
+         }
+
          /* ----------------------------------------------------------- */
          /* If locking is engaged, then call the lock vectors routine,  */
          /* else mark all non target Ritz values as unconverged.        */
@@ -525,12 +621,30 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                                ret, __FILE__, __LINE__, primme);
                return LOCK_VECTORS_FAILURE;
             }
+
+            if (!stop && primme->monitor && (*primme->monitor)(hVals, flag,
+                     basisSize, NULL, NULL, 0, evals, numLocked, numConverged,
+                     primme)) {
+               stop = MONITOR_STOP;
+            }
             
          }
          else {
             /* reset_flags_dprimme(flag, primme->numEvals, primme->maxBasisSize-1);*/
             check_reset_flags_dprimme(flag, &numConverged, hVals, 
                prevRitzVals, numPrevRitzVals, tol, largestRitzValue, primme);
+
+            /* Drop from evecs the pairs that are not converged anymore */
+            if (numConverged < numConvergedStored) {
+               ret = pseudolock_vectors_dprimme(V, flag, evecs, evecsHat, M,
+                  UDU, ipivot, numConverged, &numConvergedStored, rwork,
+                  rworkSize, primme);
+               if (ret != 0) {
+                  primme_PushErrorMessage(Primme_main_iter, Primme_restart, 
+                                  ret, __FILE__, __LINE__, primme);
+                  return RESTART_FAILURE;
+               }
+            }
          }
 
          primme->stats.numRestarts++;
@@ -541,7 +655,7 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
          /* restart. GD+k is also evaluated if a pair converges.          */
          /* ------------------------------------------------------------- */
          if (primme->dynamicMethodSwitch == 1 ) {
-            tstart = primme_wTimer(0);
+            tstart = primme_wTimer_r(&primme->timerStart, 0);
             ret = update_statistics(&CostModel, primme, tstart, 0, 1,
                numConverged, blockNorms[0], largestRitzValue); 
             switch_from_GDpk(&CostModel, primme);
@@ -561,6 +675,11 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
 
       if (primme->locking) {
 
+         /* Leave the model for future runs */
+         if (dynamicModel && primme->costModel) {
+            save_model(&CostModel, primme->costModel);
+         }
+
          /* if dynamic method, give method recommendation for future runs */
          if (primme->dynamicMethodSwitch > 0 ) {
             if (CostModel.accum_jdq_gdk < 0.96) 
@@ -581,6 +700,13 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
             if (primme->aNorm <= 0.0L) primme->aNorm = largestRitzValue;
             return 0;
          }
+         else if (stop) {
+            /* Return the current approximations after the locked pairs */
+            numValid = copy_unconverged_pairs(V, W, hVecs, hVals, basisSize,
+               numLocked, evecs, evals, resNorms, perm, rwork, primme);
+            primme->initSize = numLocked + numValid;
+            return stop;
+         }
          else {
             return MAX_ITERATIONS_REACHED;
          }
@@ -588,10 +714,14 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
       }
       else {      /* no locking. Verify that everything is converged  */
 
-         /* Determine if the maximum number of matvecs has been reached */
+         /* Determine if the maximum number of matvecs or outer iterations */
+         /* has been reached                                              */
 
-         restartLimitReached = primme->maxMatvecs > 0 && 
-                               primme->stats.numMatvecs >= primme->maxMatvecs;
+         restartLimitReached = 
+            (primme->maxMatvecs > 0 && 
+             primme->stats.numMatvecs >= primme->maxMatvecs) ||
+            (primme->maxOuterIterations > 0 && 
+             primme->stats.numOuterIterations >= primme->maxOuterIterations);
 
          /* ---------------------------------------------------------- */
          /* The norms of the converged Ritz vectors must be recomputed */
@@ -609,17 +739,22 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
          /* If the convergence limit is reached or the target vectors  */
          /* have remained converged, then copy the current Ritz values */
          /* and vectors to the output arrays and return, else continue */
-         /* iterating.                                                 */
+         /* iterating. When stopping, skip the reorthogonalization and */
+         /* the recomputation of W, and return what there is.          */
          /* ---------------------------------------------------------- */
 
-         if (restartLimitReached || converged) {
+         if (restartLimitReached || converged || stop) {
+            /* Before the basis grows to numEvals vectors, only basisSize */
+            /* pairs exist; the rest of evals and evecs is left undefined */
+            numValid = min(primme->numEvals, basisSize);
             for (i=0; i < primme->numEvals; i++) {
-               evals[i] = hVals[i];
+               if (i < numValid) evals[i] = hVals[i];
                perm[i] = i;
             }
 
-            Num_dcopy_dprimme(primme->nLocal*primme->numEvals, V, 1, 
-               &evecs[primme->nLocal*primme->numOrthoConst], 1);
+            Num_copy_matrix_dprimme(V, primme->nLocal, numValid,
+               primme->ldOPs, &evecs[primme->nLocal*primme->numOrthoConst],
+               primme->nLocal);
 
             /* The target values all remained converged, then return */
             /* successfully, else return with a failure code.        */
@@ -627,6 +762,11 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
  
             primme->initSize = numConverged;
 
+            /* Leave the model for future runs */
+            if (dynamicModel && primme->costModel) {
+               save_model(&CostModel, primme->costModel);
+            }
+
             /* if dynamic method, give method recommendation for future runs */
             if (primme->dynamicMethodSwitch > 0 ) {
                if (CostModel.accum_jdq_gdk < 0.96) 
@@ -641,6 +781,11 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
                if (primme->aNorm <= 0.0L) primme->aNorm = largestRitzValue;
                return 0;
             }
+            else if (stop) {
+               /* Report the pairs returned; resNorms tells which converged */
+               primme->initSize = numValid;
+               return stop;
+            }
             else {
                return MAX_ITERATIONS_REACHED;
             }
@@ -652,7 +797,7 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs,
             /* outer while loop, resolving the epairs. Slow, but robust!    */
             /* ------------------------------------------------------------ */
 
-            ret = ortho_dprimme(V, primme->nLocal,0, basisSize-1, evecs, 
+            ret = ortho_dprimme(V, primme->ldOPs, 0, basisSize-1, evecs, 
                primme->nLocal, primme->numOrthoConst+numLocked, primme->nLocal,
                primme->iseed, machEps, rwork, rworkSize, primme);
             if (ret < 0) {
@@ -759,6 +904,10 @@ static void adjust_blockSize(int *iev, int *flag, int *blockSize,
  *
  * basisSize  The current size of the basis
  *
+ * basisLimit The basis size at which the basis is restarted
+ *
+ * numToRetain The number of coefficients to retain, at most maxPrevRetain
+ *
  * iev        Array of size block size.  It maps the block index to the Ritz
  *            value index each block vector corresponds to.
  *
@@ -769,7 +918,9 @@ static void adjust_blockSize(int *iev, int *flag, int *blockSize,
  *
  * Output parameters
  * -----------------
- * previousHVecs  The coefficients to be retained
+ * previousHVecs  The coefficients to be retained, padded with zeros to the
+ *                size of the basis at restart, basisSize+blockSize, which is
+ *                also their leading dimension as restart expects
  *
  *
  * Return value
@@ -779,7 +930,8 @@ static void adjust_blockSize(int *iev, int *flag, int *blockSize,
  ******************************************************************************/
 
 static int retain_previous_coefficients(double *hVecs, double *previousHVecs, 
-   int basisSize, int *iev, int blockSize, primme_params *primme) {
+   int basisSize, int basisLimit, int numToRetain, int *iev, int blockSize, 
+   primme_params *primme) {
 
    int i, j;            /* Loop indices                                  */
    int index;           /* The index of some coefficient vector in hVecs */ 
@@ -789,10 +941,10 @@ static int retain_previous_coefficients(double *hVecs, double *previousHVecs,
    numPrevRetained = 0;
 
    /* If coefficient vectors are to be retained and its the iteration  */
-   /* before restart occurs, then retain at most maxPrevRetain vectors */
+   /* before restart occurs, then retain at most numToRetain vectors   */
  
-   if (primme->restartingParams.maxPrevRetain > 0 && 
-       basisSize+blockSize >= primme->maxBasisSize)
+   if (numToRetain > 0 && 
+       basisSize+blockSize >= basisLimit)
    {
       index = -1;
 
@@ -801,7 +953,7 @@ static int retain_previous_coefficients(double *hVecs, double *previousHVecs,
       /* vectors as possible.                                          */
       /* ------------------------------------------------------------- */
 
-      for (i = 0; i < primme->restartingParams.maxPrevRetain; i++) {
+      for (i = 0; i < numToRetain; i++) {
 
          /* First, retain coefficient vectors corresponding to current block */
          /* vectors.  If all of those have been retained, then retain the    */ 
@@ -818,12 +970,12 @@ static int retain_previous_coefficients(double *hVecs, double *previousHVecs,
 
          if (index < basisSize) {
             Num_dcopy_dprimme(basisSize, &hVecs[basisSize*index], 1, 
-               &previousHVecs[primme->maxBasisSize*numPrevRetained], 1);
+               &previousHVecs[(basisSize+blockSize)*numPrevRetained], 1);
 
-            /* Zero the maxBasisSize-basisSize last elements of the buffer */
+            /* Zero the blockSize last elements of the buffer */
 
-            for (j = basisSize; j < primme->maxBasisSize; j++) {
-               previousHVecs[primme->maxBasisSize*numPrevRetained+j] = tzero;
+            for (j = basisSize; j < basisSize+blockSize; j++) {
+               previousHVecs[(basisSize+blockSize)*numPrevRetained+j] = tzero;
             } 
 
             numPrevRetained++;
@@ -849,6 +1001,9 @@ static int retain_previous_coefficients(double *hVecs, double *previousHVecs,
  *    to have become unconverged by checking hVals[i]-prevRitzVals[i] < tol
  *    If not, it flags it UNCONVERGED and lets it be targeted again. This avoids 
  *    early converged but unwanted evs preventing wanted from being targeted.
+ *    The Ritz values of the reset pairs are remembered in prevRitzVals, so
+ *    that a pair is not reset again by the next restart unless it moves; if
+ *    no correction is done in between, it would reset the same pair forever.
  ******************************************************************************/
 
 void check_reset_flags_dprimme(int *flag, int *numConverged, 
@@ -867,6 +1022,7 @@ void check_reset_flags_dprimme(int *flag, int *numConverged,
       if ((flag[i] == CONVERGED) && (fabs(hVals[i]-prevRitzVals[i]) > tol)) {
          (*numConverged)--;
          flag[i] = UNCONVERGED;
+         prevRitzVals[i] = hVals[i];
       }
    }
 
@@ -918,7 +1074,8 @@ void check_reset_flags_dprimme(int *flag, int *numConverged,
  * RETURN VALUE
  * ------------
  * TRUE if the numReqEvals Ritz values have remained converged after restarting,
- * FALSE otherwise.
+ * FALSE otherwise. Only the first min(numEvals, basisSize) pairs are checked;
+ * with fewer than numEvals pairs in the basis it returns FALSE.
  ******************************************************************************/
    
 static int verify_norms(double *V, double *W, double *hVecs, 
@@ -927,11 +1084,12 @@ static int verify_norms(double *V, double *W, double *hVecs,
 
    int i;         /* Loop varible                                      */
    int converged; /* True when all requested Ritz values are converged */
-   int nev, n;    /* convenience integers for numEvals and nLocal      */
+   int nev, n, ldV; /* convenience integers for numEvals, nLocal, ldOPs */
    double *dwork = (double *) rwork; /* pointer to cast rwork to double*/
 
-   nev = primme->numEvals;
+   nev = min(primme->numEvals, basisSize);
    n   = primme->nLocal;
+   ldV = primme->ldOPs;
 
    /* Set up the tolerance if necessary */
 
@@ -942,13 +1100,13 @@ static int verify_norms(double *V, double *W, double *hVecs,
    /* Compute the residual vectors */
 
    for (i=0; i < nev; i++) {
-      Num_axpy_dprimme(n, -hVals[i], &V[n*i], 1, &W[n*i], 1);
-      dwork[nev+i] = Num_dot_dprimme(n, &W[n*i], 1, &W[n*i], 1);
+      Num_axpy_dprimme(n, -hVals[i], &V[ldV*i], 1, &W[ldV*i], 1);
+      dwork[nev+i] = Num_dot_dprimme(n, &W[ldV*i], 1, &W[ldV*i], 1);
 
    }
       
-   (*primme->globalSumDouble)(&dwork[nev], &dwork[0], &nev, primme); 
-   converged = 1;
+   primme_globalSum(&dwork[nev], &dwork[0], &nev, primme); 
+   converged = nev == primme->numEvals;
 
    /* Check for convergence of the residual norms. */
 
@@ -970,6 +1128,105 @@ static int verify_norms(double *V, double *W, double *hVecs,
    return converged;
 }
 
+/******************************************************************************
+ * Function deadline_near - Returns true if another outer iteration, taking as
+ *    long as the time since the last call, would exceed primme.maxTime.
+ *    In parallel runs the elapsed time is averaged over the processes, so
+ *    that all of them take the same decision.
+ *
+ * INPUT/OUTPUT
+ * ------------
+ * tLastCheck  Elapsed time at the last call; 0 for the first one
+ *
+ ******************************************************************************/
+
+static int deadline_near(double *tLastCheck, primme_params *primme) {
+
+   double t, elapsed, iterTime;
+   int ONE = 1;
+
+   t = primme_wTimer_r(&primme->timerStart, 0);
+   if (primme->numProcs > 1) {
+      primme_globalSum(&t, &elapsed, &ONE, primme);
+      elapsed /= primme->numProcs;
+   }
+   else {
+      elapsed = t;
+   }
+
+   iterTime = elapsed - *tLastCheck;
+   *tLastCheck = elapsed;
+
+   return elapsed + iterTime >= primme->maxTime;
+}
+
+/******************************************************************************
+ * Function copy_unconverged_pairs - When the solver stops with locking before
+ *    all pairs are locked, it appends to the numLocked locked pairs the
+ *    first min(numEvals-numLocked, basisSize) Ritz pairs of the basis, with
+ *    their residual norms. V and W are overwritten.
+ *
+ * INPUT
+ * -----
+ * V, W        The basis and W=A*V
+ * hVecs       The eigenvectors of H
+ * hVals       The eigenvalues of H
+ * basisSize   Current size of the basis
+ * numLocked   Number of locked pairs
+ * rwork       Workspace of size 2*numEvals
+ *
+ * OUTPUT
+ * ------
+ * evecs, evals, resNorms  Entries numLocked to numLocked+k-1, with k the
+ *                         return value; the following ones are undefined
+ * perm        Entries numLocked to numEvals-1 set to the identity, so that
+ *             the undefined ones are not moved by permute_evecs
+ *
+ * Return value
+ * ------------
+ * The number k of pairs appended
+ *
+ ******************************************************************************/
+
+static int copy_unconverged_pairs(double *V, double *W, double *hVecs, 
+   double *hVals, int basisSize, int numLocked, double *evecs, double *evals,
+   double *resNorms, int *perm, void *rwork, primme_params *primme) {
+
+   int i, k, n, ldV;
+   double *X = &evecs[primme->nLocal*(primme->numOrthoConst+numLocked)];
+   double *dwork = (double *) rwork; /* pointer to cast rwork to double*/
+   double tpone = +1.0e+00, tzero = +0.0e+00;
+
+   n   = primme->nLocal;
+   ldV = primme->ldOPs;
+   k   = min(primme->numEvals - numLocked, basisSize);
+
+   for (i=numLocked; i < primme->numEvals; i++) {
+      perm[i] = i;
+   }
+   if (k <= 0) return 0;
+
+   /* X = V*hVecs and R = W*hVecs - X*diag(hVals), in place of V */
+
+   Num_gemm_dprimme("N", "N", n, k, basisSize, tpone, V, ldV, hVecs, 
+      basisSize, tzero, X, n);
+   Num_gemm_dprimme("N", "N", n, k, basisSize, tpone, W, ldV, hVecs, 
+      basisSize, tzero, V, ldV);
+   for (i=0; i < k; i++) {
+      Num_axpy_dprimme(n, -hVals[i], &X[n*i], 1, &V[ldV*i], 1);
+      dwork[k+i] = Num_dot_dprimme(n, &V[ldV*i], 1, &V[ldV*i], 1);
+   }
+
+   primme_globalSum(&dwork[k], &dwork[0], &k, primme); 
+
+   for (i=0; i < k; i++) {
+      evals[numLocked+i] = hVals[i];
+      resNorms[numLocked+i] = sqrt(dwork[i]);
+   }
+
+   return k;
+}
+
 /******************************************************************************
            Dynamic Method Switching uses the following functions 
     ---------------------------------------------------------------------
@@ -1035,7 +1292,7 @@ static void switch_from_JDQMR(primme_CostModel *model, primme_params *primme) {
 
       /* If more many procs, make sure that all have the same ratio */
       if (primme->numProcs > 1) {
-         (*primme->globalSumDouble)(&ratio, &globalRatio, &one, primme); 
+         primme_globalSum(&ratio, &globalRatio, &one, primme); 
          ratio = globalRatio/primme->numProcs;
       }
 
@@ -1043,6 +1300,9 @@ static void switch_from_JDQMR(primme_CostModel *model, primme_params *primme) {
          /* Always use GD+k. No further model updates */
          primme->dynamicMethodSwitch = -1;
          primme->correctionParams.maxInnerIterations = 0;
+         if (primme->trace) primme_trace_record(primme_get_wtime(),
+            primme_event_method, primme_phase_convergence, 
+            primme->dynamicMethodSwitch, ratio, 0.0L, primme);
          if (primme->printLevel >= 3 && primme->procID == 0) 
             fprintf(primme->outputFile, 
             "Ratio: %e Switching permanently to GD+k\n", ratio);
@@ -1066,13 +1326,16 @@ static void switch_from_JDQMR(primme_CostModel *model, primme_params *primme) {
 
    /* If more many procs, make sure that all have the same ratio */
    if (primme->numProcs > 1) {
-      (*primme->globalSumDouble)(&ratio, &globalRatio, &one, primme); 
+      primme_globalSum(&ratio, &globalRatio, &one, primme); 
       ratio = globalRatio/primme->numProcs;
    }
    
    if (ratio > 1.05) {
       primme->dynamicMethodSwitch = switchto; 
       primme->correctionParams.maxInnerIterations = 0;
+      if (primme->trace) primme_trace_record(primme_get_wtime(),
+         primme_event_method, primme_phase_convergence,
+         primme->dynamicMethodSwitch, ratio, 0.0L, primme);
    }
 
    model->accum_jdq += model->gdk_plus_MV_PR*ratio;
@@ -1147,6 +1410,9 @@ static void switch_from_GDpk(primme_CostModel *model, primme_params *primme) {
    if (model->qmr_only == 0.0) {
       primme->dynamicMethodSwitch = switchto;
       primme->correctionParams.maxInnerIterations = -1;
+      if (primme->trace) primme_trace_record(primme_get_wtime(),
+         primme_event_method, primme_phase_convergence,
+         primme->dynamicMethodSwitch, 0.0L, 0.0L, primme);
       if (primme->printLevel >= 3 && primme->procID == 0) 
          fprintf(primme->outputFile, 
          "Ratio: N/A  GD+k switched to JDQMR (first time)\n");
@@ -1163,13 +1429,16 @@ static void switch_from_GDpk(primme_CostModel *model, primme_params *primme) {
 
    /* If more many procs, make sure that all have the same ratio */
    if (primme->numProcs > 1) {
-      (*primme->globalSumDouble)(&ratio, &globalRatio, &one, primme); 
+      primme_globalSum(&ratio, &globalRatio, &one, primme); 
       ratio = globalRatio/primme->numProcs;
    }
 
    if (ratio < 0.95) {
       primme->dynamicMethodSwitch = switchto;
       primme->correctionParams.maxInnerIterations = -1;
+      if (primme->trace) primme_trace_record(primme_get_wtime(),
+         primme_event_method, primme_phase_convergence,
+         primme->dynamicMethodSwitch, ratio, 0.0L, primme);
    } 
 
    model->accum_jdq += model->gdk_plus_MV_PR*ratio;
@@ -1199,6 +1468,9 @@ static void switch_from_GDpk(primme_CostModel *model, primme_params *primme) {
  *    in terms of matrix-vector operations.
  *    Times are averaged with one previous measurement, and convergence
  *    rates are averaged over a window which is reset over 10 converged pairs.
+ *    The times of MV and PR come from the stats of the operators, and the
+ *    global reductions of the outer and QMR steps are modeled apart from
+ *    their computation (see update_network).
  *
  *    The function is called right before switch_from_JDQMR/switch_from_GDpk.
  *    Depending on the current method running, this is at two points:
@@ -1276,7 +1548,8 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
    double currentResNorm, double aNormEst) {
 
    double low_res, elapsed_time, time_in_outer, kinn;
-   int kout, nMV;
+   double sums, bytes, comp;
+   int kout, nMV, nPR;
 
    /* ------------------------------------------------------- */
    /* Time in outer and inner iteration since last update     */
@@ -1325,11 +1598,43 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
    /* Update model timings and parameters                     */
    /* ------------------------------------------------------- */
 
+   /* Fit latency and bandwidth with the reductions since last update */
+   sums  = primme->stats.numGlobalSumCalls - model->numSums_0;
+   bytes = primme->stats.bytesGlobalSum - model->bytesSums_0;
+   update_network(model, sums, bytes, 
+      primme->stats.timeGlobalSum - model->timeSums_0);
+
+   /* Time of one MV and one PR. Average last two updates */
+   if (nMV > 0) {
+      model->MV = (model->MV + 
+         (primme->stats.timeMatvec - model->timeMV_0)/nMV)/2.0L;
+   }
+   nPR = primme->stats.numPreconds - model->numPR_0;
+   if (nPR > 0) {
+      if (model->PR == 0.0L) 
+         model->PR = (primme->stats.timePrecond - model->timePR_0)/nPR;
+      else 
+         model->PR = (model->PR + 
+            (primme->stats.timePrecond - model->timePR_0)/nPR)/2.0L;
+   }
+   model->MV_PR = model->MV + model->PR;
+
    /* update outer iteration time for both GD+k,JDQMR.Average last two updates*/
-   if (model->gdk_plus_MV == 0.0L) 
-      model->gdk_plus_MV = time_in_outer/kout;
-   else 
-      model->gdk_plus_MV = (model->gdk_plus_MV + time_in_outer/kout)/2.0L;
+   /* The reductions of the outer iteration are those not in solve_correction */
+   sums  = (sums - model->sums_in_inner)/kout;
+   bytes = (bytes - model->bytes_in_inner)/kout;
+   comp  = max(0.0L, time_in_outer/kout - sums*model->latency 
+                                        - bytes*model->invBandwidth);
+   if (model->gdk_comp == 0.0L && model->gdk_sums == 0.0L) {
+      model->gdk_comp  = comp;
+      model->gdk_sums  = sums;
+      model->gdk_bytes = bytes;
+   }
+   else {
+      model->gdk_comp  = (model->gdk_comp + comp)/2.0L;
+      model->gdk_sums  = (model->gdk_sums + sums)/2.0L;
+      model->gdk_bytes = (model->gdk_bytes + bytes)/2.0L;
+   }
 
    /* ---------------------------------------------------------------- *
     * Reset the conv rate averaging window every 10 converged pairs. 
@@ -1356,14 +1661,6 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
    switch (primme->dynamicMethodSwitch) {
 
       case 1: case 3: /* Currently running GD+k */
-        /* Update Precondition times */
-        if (model->PR == 0.0L) 
-           model->PR          = model->time_in_inner/kout;
-        else 
-           model->PR          = (model->PR + model->time_in_inner/kout)/2.0L;
-        model->gdk_plus_MV_PR = model->gdk_plus_MV + model->PR;
-        model->MV_PR          = model->MV + model->PR;
-
         /* update convergence rate.
          * ---------------------------------------------------------------- *
          * Note 2: This is NOT a geometric average of piecemeal rates. 
@@ -1385,19 +1682,30 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
 
       case 2: case 4: /* Currently running JDQMR */
         /* Basic timings for QMR iteration (average of last two updates) */
-        if (model->qmr_plus_MV_PR == 0.0L) {
-           model->qmr_plus_MV_PR=(model->time_in_inner/kout- model->MV_PR)/kinn;
-           model->ratio_MV_outer = ((double) nMV)/kout;
+        /* QMR steps are split in computation and reductions */
+        if (kinn != 0.0) {
+           sums  = model->sums_in_inner/(kout*kinn);
+           bytes = model->bytes_in_inner/(kout*kinn);
+           comp  = max(0.0L, (model->time_in_inner/kout - model->MV_PR)/kinn
+                 - model->MV_PR - sums*model->latency 
+                 - bytes*model->invBandwidth);
+           if (model->qmr_plus_MV_PR == 0.0L) {
+              model->qmr_comp  = comp;
+              model->qmr_sums  = sums;
+              model->qmr_bytes = bytes;
+           }
+           else {
+              model->qmr_comp  = (model->qmr_comp + comp)/2.0L;
+              model->qmr_sums  = (model->qmr_sums + sums)/2.0L;
+              model->qmr_bytes = (model->qmr_bytes + bytes)/2.0L;
+           }
+           /* Mark QMR as measured; apply_network sets its time */
+           model->qmr_plus_MV_PR = 1.0L;
         }
-        else {
-           if (kinn != 0.0) model->qmr_plus_MV_PR = (model->qmr_plus_MV_PR  + 
-              (model->time_in_inner/kout - model->MV_PR)/kinn )/2.0L;
+        if (model->ratio_MV_outer == 0.0L) 
+           model->ratio_MV_outer = ((double) nMV)/kout;
+        else 
            model->ratio_MV_outer =(model->ratio_MV_outer+((double) nMV)/kout)/2;
-        }
-        model->qmr_only = model->qmr_plus_MV_PR - model->MV_PR;
-
-        /* Update the cost of a hypothetical GD+k, as measured outer + PR */
-        model->gdk_plus_MV_PR = model->gdk_plus_MV + model->PR;
 
         /* update convergence rate */
         if (low_res <= model->resid_0) 
@@ -1407,6 +1715,7 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
                                    /model->jdq_sum_MV);
         break;
    }
+   apply_network(model);
    update_slowdown(model);
 
    /* ------------------------------------------------------- */
@@ -1418,6 +1727,14 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
    model->timer_0 = current_time;      
    model->time_in_inner = 0.0;
    model->resid_0 = currentResNorm;
+   model->numSums_0 = primme->stats.numGlobalSumCalls;
+   model->bytesSums_0 = primme->stats.bytesGlobalSum;
+   model->timeSums_0 = primme->stats.timeGlobalSum;
+   model->timeMV_0 = primme->stats.timeMatvec;
+   model->numPR_0 = primme->stats.numPreconds;
+   model->timePR_0 = primme->stats.timePrecond;
+   model->sums_in_inner = 0.0L;
+   model->bytes_in_inner = 0.0L;
 
    return 1;
 }
@@ -1480,6 +1797,501 @@ static void update_slowdown(primme_CostModel *model) {
   model->JDQMR_slowdown = max(1.1, min(slowdown, 2.5));
 }
 
+/******************************************************************************
+ * Function update_network -
+ *    Fits the model of the time of a global reduction of b bytes,
+ *           latency + b*invBandwidth,
+ *    by least squares to all measurements so far, each one the time of
+ *    sums reductions with bytes bytes in total. If the measurements do not
+ *    tell latency and bandwidth apart (e.g., all reductions are of similar
+ *    size) or give negative values, the whole time is taken as latency.
+ *
+ ******************************************************************************/
+static void update_network(primme_CostModel *model, double sums, double bytes,
+   double time) {
+
+   double det;
+
+   if (sums <= 0.0L) return;
+
+   model->net_cc += sums*sums;
+   model->net_cb += sums*bytes;
+   model->net_bb += bytes*bytes;
+   model->net_ct += sums*time;
+   model->net_bt += bytes*time;
+
+   det = model->net_cc*model->net_bb - model->net_cb*model->net_cb;
+   if (det > 1e-6*model->net_cc*model->net_bb) {
+      model->latency = (model->net_bb*model->net_ct 
+                        - model->net_cb*model->net_bt)/det;
+      model->invBandwidth = (model->net_cc*model->net_bt 
+                             - model->net_cb*model->net_ct)/det;
+      if (model->latency >= 0.0L && model->invBandwidth >= 0.0L) return;
+   }
+   model->latency = model->net_ct/model->net_cc;
+   model->invBandwidth = 0.0L;
+}
+
+/******************************************************************************
+ * Function apply_network -
+ *    Sets the times of a GD+k outer step and of a QMR step (if measured) as
+ *    their computation plus their reductions at the current latency and
+ *    bandwidth.
+ *
+ ******************************************************************************/
+static void apply_network(primme_CostModel *model) {
+
+   model->gdk_plus_MV = model->gdk_comp + model->gdk_sums*model->latency 
+                      + model->gdk_bytes*model->invBandwidth;
+   model->gdk_plus_MV_PR = model->gdk_plus_MV + model->PR;
+
+   if (model->qmr_plus_MV_PR != 0.0L) {
+      model->qmr_only = model->qmr_comp + model->qmr_sums*model->latency 
+                      + model->qmr_bytes*model->invBandwidth;
+      model->qmr_plus_MV_PR = model->qmr_only + model->MV_PR;
+   }
+}
+
+/******************************************************************************
+ * Function initializeTune - Starts the online tuning with the sizes given
+ *    by the user, which are also the upper bounds of the tuned sizes. The
+ *    basis size may go down to the size needed to restart with half of
+ *    minRestartSize (or numEvals without locking), maxPrevRetain and a
+ *    full block, as long as the convergence does not slow down.
+ *
+ ******************************************************************************/
+static void initializeTune(primme_TuneModel *tune, primme_params *primme) {
+
+   int i;
+
+   tune->basisSize       = primme->maxBasisSize;
+   tune->restartSize     = primme->minRestartSize;
+   tune->blockSize       = primme->maxBlockSize;
+   tune->userRestartSize = primme->minRestartSize;
+   tune->minRestartSize  = (primme->minRestartSize + 1)/2;
+   if (!primme->locking) tune->minRestartSize = max(tune->minRestartSize,
+         min(primme->minRestartSize, primme->numEvals));
+   tune->minBasisSize    = min(primme->maxBasisSize, tune->minRestartSize + 
+         primme->restartingParams.maxPrevRetain + primme->maxBlockSize);
+
+   for (i=1; i < TUNE_MAX_CLASSES && (1<<(i-1)) < primme->maxBlockSize; i++);
+   tune->numClasses      = i;
+   for (i=0; i < TUNE_MAX_CLASSES; i++) tune->timeMV[i] = 0.0L;
+   tune->trying          = tune->numClasses-1;
+
+   tune->denseRate       = 0.0L;
+   tune->restartRate     = 0.0L;
+   tune->work            = 0.0L;
+   tune->lastBasisSize   = 0;
+   tune->timeDense_0     = primme->stats.timeOrtho + 
+      primme->stats.timeUpdateProjection + primme->stats.timeSolveH + 
+      primme->stats.timeConvergence;
+   tune->timeRestart_0   = primme->stats.timeRestart;
+   tune->timeMV_0        = primme->stats.timeMatvec;
+
+   tune->floorBasisSize  = tune->minBasisSize;
+   tune->prevBasisSize   = 0;
+   tune->prevRate        = 0.0L;
+   tune->prevRateMV      = 0.0L;
+   tune->resid_0         = -1.0L;
+   tune->numConverged_0  = -1;
+   tune->time_0          = primme_wTimer_r(&primme->timerStart, 0);
+   tune->matvecs_0       = primme->stats.numMatvecs;
+   tune->convLog         = 0.0L;
+   tune->convTime        = 0.0L;
+   tune->convMV          = 0;
+   tune->convCycles      = 0;
+   tune->trialBasisSize  = 0;
+   tune->trialRate       = 0.0L;
+   tune->trialRateMV     = 0.0L;
+}
+
+/******************************************************************************
+ * Function tune_matvec - Accounts for the expansion of the basis of size
+ *    basisSize with blockSize vectors, after computing W for them.
+ *
+ ******************************************************************************/
+static void tune_matvec(primme_TuneModel *tune, int basisSize, int blockSize,
+   primme_params *primme) {
+
+   int i;
+   double t;
+
+   t = (primme->stats.timeMatvec - tune->timeMV_0)/blockSize;
+   for (i=0; i+1 < tune->numClasses && 
+             min(1<<(i+1), primme->maxBlockSize) <= blockSize; i++);
+   if (tune->timeMV[i] <= 0.0L) 
+      tune->timeMV[i] = t;
+   else 
+      tune->timeMV[i] = (tune->timeMV[i] + t)/2.0L;
+
+   tune->work += (double)basisSize*blockSize;
+   tune->lastBasisSize = basisSize + blockSize;
+}
+
+/******************************************************************************
+ * Function tune_sizes - Chooses the sizes for the next cycle after a
+ *    restart to restartSize vectors.
+ *
+ *    Block size: every block size 1, 2, 4, ..., maxBlockSize is used for
+ *    one cycle, from the largest down. Then the smallest one whose matvec
+ *    time per vector is within 10% of the best is used, as larger blocks
+ *    only pay off through the throughput of matrixMatvec. The block size
+ *    in use is kept while it stays within 10% of the best.
+ *
+ *    Basis and restart size: the balanced basis size is the largest one
+ *    (with the restart size in the proportion given by the user) for which
+ *    the dense work on the basis and the restart, per new vector, does not
+ *    exceed the time of applying the operator (MV and PR) to it. A larger
+ *    basis is not worth its overhead, but a smaller one may need many more
+ *    iterations. So the basis grows to the balanced size right away, but
+ *    a size halfway to it is only tried. The convergence rate of the
+ *    target, log(resid_0/resid) per second and per matvec, is measured
+ *    over windows of TUNE_MIN_CYCLES cycles in which no pair converged:
+ *    one with the current size, one with the trial size, and one with the
+ *    current size again, since the convergence usually speeds up along the
+ *    run. The trial size is kept only if both of its rates are above the
+ *    ones of the other two windows; otherwise the basis size does not go
+ *    below the current size anymore.
+ *
+ *    Measurements are averaged over processes, so all take the same
+ *    decisions.
+ *
+ ******************************************************************************/
+static void tune_sizes(primme_TuneModel *tune, int restartSize,
+   double resNorm, int numConverged, primme_params *primme) {
+
+   int i, best, n, basisSize, blockSize, balanced, measured;
+   double t, op, timeDense, now, rate, rateMV;
+   double sendBuf[TUNE_MAX_CLASSES+4], recvBuf[TUNE_MAX_CLASSES+4];
+
+   /* Nothing to learn from a restart right after another one */
+
+   if (tune->work == 0.0L) {
+      tune->timeRestart_0 = primme->stats.timeRestart;
+      return;
+   }
+
+   /* Update the rates of dense and restart work with the last cycle */
+
+   timeDense = primme->stats.timeOrtho + primme->stats.timeUpdateProjection +
+      primme->stats.timeSolveH + primme->stats.timeConvergence;
+   t = (timeDense - tune->timeDense_0)/tune->work;
+   tune->denseRate = tune->denseRate == 0.0L ? t : (tune->denseRate + t)/2.0L;
+   if (tune->lastBasisSize > 0 && restartSize > 0) {
+      t = (primme->stats.timeRestart - tune->timeRestart_0)/
+         ((double)tune->lastBasisSize*restartSize);
+      tune->restartRate = tune->restartRate == 0.0L ? t : 
+         (tune->restartRate + t)/2.0L;
+   }
+   tune->work = 0.0L;
+   tune->timeDense_0 = timeDense;
+   tune->timeRestart_0 = primme->stats.timeRestart;
+
+   /* Convergence of the target in the last cycle, if no pair converged */
+
+   now = primme_wTimer_r(&primme->timerStart, 0);
+   if (numConverged == tune->numConverged_0 && tune->resid_0 > 0.0L &&
+         resNorm > 0.0L) {
+      tune->convLog += log(tune->resid_0/resNorm);
+      tune->convTime += now - tune->time_0;
+      tune->convMV += primme->stats.numMatvecs - tune->matvecs_0;
+      tune->convCycles++;
+   }
+   tune->resid_0 = resNorm;
+   tune->numConverged_0 = numConverged;
+   tune->time_0 = now;
+   tune->matvecs_0 = primme->stats.numMatvecs;
+
+   /* A block size used for a cycle without forming a full block of */
+   /* that size is not considered again                              */
+
+   if (tune->timeMV[tune->trying] == 0.0L) tune->timeMV[tune->trying] = -1.0L;
+
+   /* Average the measurements over processes */
+
+   n = tune->numClasses;
+   for (i=0; i < n; i++) sendBuf[i] = tune->timeMV[i];
+   sendBuf[n] = tune->denseRate;
+   sendBuf[n+1] = tune->restartRate;
+   sendBuf[n+2] = primme->stats.numPreconds > 0 ? 
+      primme->stats.timePrecond/primme->stats.numPreconds : 0.0L;
+   sendBuf[n+3] = tune->convTime;
+   n += 4;
+   if (primme->numProcs > 1) {
+      primme_globalSum(sendBuf, recvBuf, &n, primme);
+      for (i=0; i < n; i++) recvBuf[i] /= primme->numProcs;
+   }
+   else {
+      for (i=0; i < n; i++) recvBuf[i] = sendBuf[i];
+   }
+
+   /* Convergence rates with the sizes in use, per second and per matvec */
+
+   measured = tune->convCycles >= TUNE_MIN_CYCLES && tune->convLog > 0.0L &&
+      recvBuf[n-1] > 0.0L && tune->convMV > 0;
+   rate = measured ? tune->convLog/recvBuf[n-1] : 0.0L;
+   rateMV = measured ? tune->convLog/tune->convMV : 0.0L;
+
+   /* Block size: try the next one not measured, or keep the best */
+
+   for (i=tune->numClasses-1; i >= 0 && recvBuf[i] != 0.0L; i--);
+   if (i >= 0) {
+      tune->trying = i;
+   }
+   else {
+      best = -1;
+      for (i=0; i < tune->numClasses; i++) {
+         if (recvBuf[i] > 0.0L && (best < 0 || recvBuf[i] < recvBuf[best]))
+            best = i;
+      }
+      /* Change only if the block size in use is 10% slower than the best */
+      if (best >= 0 && !(recvBuf[tune->trying] > 0.0L &&
+               recvBuf[tune->trying] <= 1.1L*recvBuf[best])) {
+         for (i=0; i < best && 
+              !(recvBuf[i] > 0.0L && recvBuf[i] <= 1.1L*recvBuf[best]); i++);
+         tune->trying = i;
+      }
+   }
+   blockSize = min(1<<tune->trying, primme->maxBlockSize);
+
+   /* Basis size: the cost of the operator on a vector comes from the block */
+   /* size in use, or from the best one measured so far                     */
+
+   op = recvBuf[tune->trying];
+   for (i=0; i < tune->numClasses; i++) {
+      if (recvBuf[i] > 0.0L && (op <= 0.0L || recvBuf[i] < op)) op = recvBuf[i];
+   }
+   basisSize = tune->basisSize;
+   if (op > 0.0L && recvBuf[tune->numClasses] > 0.0L) {
+      op += recvBuf[tune->numClasses+2];
+      tune->denseRate = recvBuf[tune->numClasses];
+      tune->restartRate = recvBuf[tune->numClasses+1];
+      for (balanced = primme->maxBasisSize; balanced > tune->floorBasisSize 
+            && tune_overhead(tune, balanced, 
+               tune_restartSize(tune, balanced, blockSize, primme)) > op;
+            balanced--);
+
+      if (tune->trialBasisSize > 0) {
+         /* Measure the trial size, then the previous one again, and keep */
+         /* the trial size only if it beats the previous size both before */
+         /* and after the trial                                           */
+         if (measured && basisSize == tune->trialBasisSize) {
+            tune->trialRate = rate;
+            tune->trialRateMV = rateMV;
+            basisSize = tune->prevBasisSize;
+         }
+         else if (measured) {
+            if (tune->trialRate >= max(tune->prevRate, rate) &&
+                  tune->trialRateMV >= max(tune->prevRateMV, rateMV)) {
+               basisSize = tune->trialBasisSize;
+            }
+            else {
+               tune->floorBasisSize = basisSize;
+            }
+            tune->trialBasisSize = 0;
+         }
+      }
+      else if (balanced > basisSize) {
+         basisSize = balanced;
+      }
+      else if (balanced < basisSize && measured) {
+         tune->prevBasisSize = basisSize;
+         tune->prevRate = rate;
+         tune->prevRateMV = rateMV;
+         basisSize -= (basisSize - balanced + 1)/2;
+         tune->trialBasisSize = basisSize;
+      }
+   }
+
+   /* Rates are measured over windows of TUNE_MIN_CYCLES cycles */
+
+   if (measured) {
+      tune->convLog = tune->convTime = 0.0L;
+      tune->convMV = tune->convCycles = 0;
+   }
+
+   /* Apply the new sizes */
+
+   if (basisSize != tune->basisSize || blockSize != tune->blockSize) {
+      tune->basisSize = basisSize;
+      tune->blockSize = blockSize;
+      tune->restartSize = tune_restartSize(tune, basisSize, blockSize, primme);
+      tune->convLog = tune->convTime = 0.0L;
+      tune->convMV = tune->convCycles = 0;
+      primme->stats.numTunings++;
+
+      if (primme->trace) {
+         t = primme_get_wtime();
+         primme_trace_record(t, primme_event_tune, primme_phase_restart, 0,
+            tune->basisSize, 0.0L, primme);
+         primme_trace_record(t, primme_event_tune, primme_phase_restart, 1,
+            tune->restartSize, 0.0L, primme);
+         primme_trace_record(t, primme_event_tune, primme_phase_restart, 2,
+            tune->blockSize, 0.0L, primme);
+      }
+      if (primme->printLevel >= 3 && primme->procID == 0) 
+         fprintf(primme->outputFile, "Tuned sizes: maxBasisSize %d "
+            "minRestartSize %d maxBlockSize %d\n", tune->basisSize,
+            tune->restartSize, tune->blockSize);
+   }
+
+   primme->stats.tunedBasisSize = tune->basisSize;
+   primme->stats.tunedRestartSize = tune->restartSize;
+   primme->stats.tunedBlockSize = tune->blockSize;
+}
+
+/******************************************************************************
+ * Function tune_restartSize - Returns the restart size for a basis of
+ *    basisSize vectors, in the proportion to maxBasisSize given by the user,
+ *    leaving room for maxPrevRetain vectors and a block.
+ *
+ ******************************************************************************/
+static int tune_restartSize(primme_TuneModel *tune, int basisSize, 
+   int blockSize, primme_params *primme) {
+
+   int restartSize;
+
+   restartSize = (int)((double)basisSize*tune->userRestartSize/
+                       primme->maxBasisSize + 0.5);
+   restartSize = min(restartSize, basisSize - blockSize - 
+                     primme->restartingParams.maxPrevRetain);
+   restartSize = max(restartSize, tune->minRestartSize);
+   return min(restartSize, tune->userRestartSize);
+}
+
+/******************************************************************************
+ * Function tune_overhead - Returns the expected time of the dense work on
+ *    the basis and the restart per new vector, in a cycle that expands the
+ *    basis from restartSize to basisSize vectors.
+ *
+ ******************************************************************************/
+static double tune_overhead(primme_TuneModel *tune, int basisSize, 
+   int restartSize) {
+
+   return tune->denseRate*(basisSize + restartSize)/2.0L + 
+      tune->restartRate*basisSize*restartSize/max(1, basisSize - restartSize);
+}
+
+/******************************************************************************
+ * Function initializeRestartModel - Starts the adaptive restarting policy
+ *    retaining maxPrevRetain previous vectors, trying fewer first.
+ *
+ ******************************************************************************/
+static void initializeRestartModel(primme_RestartModel *model, 
+   primme_params *primme) {
+
+   model->prevRetain     = primme->restartingParams.maxPrevRetain;
+   model->step           = -1;
+   model->prevRetain_0   = -1;
+   model->lastRate       = -1.0L;
+   model->resid_0        = -1.0L;
+   model->numConverged_0 = -1;
+   model->time_0         = primme_wTimer_r(&primme->timerStart, 0);
+   model->restartWork    = 0.0L;
+}
+
+/******************************************************************************
+ * Function adapt_restart - Called before restarting a basis of basisSize
+ *    vectors. It returns the number of current Ritz vectors to restart with
+ *    and sets the number of previous vectors to retain before the next
+ *    restart (model->prevRetain).
+ *
+ *    Previous vectors: the convergence rate of the target, log(resid_0/resid)
+ *    per second, is measured over every restart cycle in which no pair
+ *    converged. Once a cycle has run with the last value of prevRetain, the
+ *    value moves one step further if the rate improved on the one of the
+ *    previous value, and one step back otherwise.
+ *
+ *    Current vectors: for the extreme targets, restarting with l vectors is
+ *    expected to reduce the residual in the next cycle by a factor of
+ *    exp(-(basisSize-l)*sqrt(gap(l))), with
+ *           gap(l) = |hVals[l] - hVals[iev[0]]|/|hVals[basisSize-1] - hVals[l]|,
+ *    as in dtr, and to take (basisSize-l)/blockSize outer iterations plus a
+ *    restart with basisSize*(l+prevRetain) work. The l that maximizes the
+ *    reduction per unit of time, with the measured times of an outer
+ *    iteration and of the restart work, is taken between the restart sizes
+ *    allowed in tune.
+ *
+ *    Timings are averaged over processes, so all take the same decisions.
+ *
+ ******************************************************************************/
+static int adapt_restart(primme_RestartModel *model, double *hVals, 
+   int *iev, int basisSize, int numConverged, double resNorm, 
+   primme_TuneModel *tune, primme_params *primme) {
+
+   int l, lMin, lMax, lOpt, n, prevRetain;
+   double now, gap, val, optVal, sendBuf[3], recvBuf[3];
+
+   /* Measurements of the last cycle */
+
+   now = primme_wTimer_r(&primme->timerStart, 0);
+   sendBuf[0] = model->time_0 < now ? now - model->time_0 : 0.0L;
+   sendBuf[1] = (now - primme->stats.timeRestart)/
+      max(1, primme->stats.numOuterIterations);
+   sendBuf[2] = model->restartWork > 0.0L ? 
+      primme->stats.timeRestart/model->restartWork : 0.0L;
+   n = 3;
+   if (primme->numProcs > 1) {
+      primme_globalSum(sendBuf, recvBuf, &n, primme);
+      for (l=0; l < n; l++) recvBuf[l] /= primme->numProcs;
+   }
+   else {
+      for (l=0; l < n; l++) recvBuf[l] = sendBuf[l];
+   }
+
+   /* Previous vectors */
+
+   prevRetain = model->prevRetain;
+   if (numConverged == model->numConverged_0 && model->resid_0 > 0.0L && 
+       resNorm > 0.0L && recvBuf[0] > 0.0L && 
+       model->prevRetain_0 == prevRetain) {
+
+      val = log(model->resid_0/resNorm)/recvBuf[0];
+      if (model->lastRate >= 0.0L && val < model->lastRate) 
+         model->step = -model->step;
+      model->lastRate = max(0.0L, val);
+      if (prevRetain + model->step < 0 || 
+          prevRetain + model->step > primme->restartingParams.maxPrevRetain)
+         model->step = -model->step;
+      model->prevRetain = max(0, min(prevRetain + model->step, 
+         primme->restartingParams.maxPrevRetain));
+   }
+   model->prevRetain_0 = prevRetain;
+   model->resid_0 = resNorm;
+   model->numConverged_0 = numConverged;
+   model->time_0 = now;
+
+   /* Current vectors */
+
+   lMax = min(tune->restartSize, basisSize - 1);
+   lMin = min(lMax, max(tune->minRestartSize, iev[0] + 1));
+   lOpt = lMax;
+   if (recvBuf[2] > 0.0L && (primme->target == primme_smallest || 
+                             primme->target == primme_largest)) {
+      optVal = 0.0L;
+      for (l = lMax; l >= lMin; l--) {
+         if (hVals[basisSize-1] == hVals[l]) continue;
+         gap = fabs((hVals[l] - hVals[iev[0]])/(hVals[basisSize-1] - hVals[l]));
+         val = (basisSize - l)*sqrt(gap)/
+            ((double)(basisSize - l)/tune->blockSize*recvBuf[1] +
+             recvBuf[2]*basisSize*(l + prevRetain));
+         if (val > optVal) {
+            optVal = val;
+            lOpt = l;
+         }
+      }
+   }
+   model->restartWork += (double)basisSize*(lOpt + prevRetain);
+
+   if (primme->printLevel >= 5 && primme->procID == 0) {
+      fprintf(primme->outputFile, "Adaptive restart size: %d prevRetain: %d\n",
+         lOpt, model->prevRetain);
+   }
+
+   return lOpt;
+}
+
 /******************************************************************************
  * Function initializeModel - Initializes model members
  ******************************************************************************/
@@ -1509,15 +2321,141 @@ static void initializeModel(primme_CostModel *model, primme_params *primme) {
 
    model->numMV_0 = primme->stats.numMatvecs;
    model->numIt_0 = primme->stats.numOuterIterations+1;
-   model->timer_0 = primme_wTimer(0);
+   model->timer_0 = primme_wTimer_r(&primme->timerStart, 0);
    model->time_in_inner  = 0.0L;
    model->resid_0        = -1.0L;
 
+   model->latency        = 0.0L;
+   model->invBandwidth   = 0.0L;
+   model->net_cc = model->net_cb = model->net_bb = 0.0L;
+   model->net_ct = model->net_bt = 0.0L;
+   model->qmr_comp       = 0.0L;
+   model->qmr_sums       = 0.0L;
+   model->qmr_bytes      = 0.0L;
+   model->gdk_comp       = 0.0L;
+   model->gdk_sums       = 0.0L;
+   model->gdk_bytes      = 0.0L;
+
+   model->numSums_0      = primme->stats.numGlobalSumCalls;
+   model->bytesSums_0    = primme->stats.bytesGlobalSum;
+   model->timeSums_0     = primme->stats.timeGlobalSum;
+   model->timeMV_0       = primme->stats.timeMatvec;
+   model->numPR_0        = primme->stats.numPreconds;
+   model->timePR_0       = primme->stats.timePrecond;
+   model->sums_in_inner  = 0.0L;
+   model->bytes_in_inner = 0.0L;
+
    model->accum_jdq      = 0.0L;
    model->accum_gdk      = 0.0L;
    model->accum_jdq_gdk  = 1.0L;
 }
 
+/******************************************************************************
+ * Function load_model - Initializes the model with the estimates in saved,
+ *    keeping the matvec time measured in this run, and starts with the
+ *    method that the model favors. The ratio is averaged over processes so
+ *    that all of them start with the same method.
+ *    The saved times of the outer and QMR steps are split in computation
+ *    and global sums with the saved latency and bandwidth, and the global
+ *    sums are priced again with those measured so far in this run, so that
+ *    a model saved with another number of processes or network still
+ *    predicts well.
+ *
+ ******************************************************************************/
+static void load_model(primme_CostModel *model, primme_cost_model *saved,
+   primme_params *primme) {
+
+   int one = 1;
+   double ratio, globalRatio;
+
+   if (model->MV == 0.0L) model->MV = saved->MV;
+   model->PR             = saved->PR;
+   model->MV_PR          = model->MV + model->PR;
+
+   /* Computation of the steps with the saved network */
+   model->latency        = saved->latency;
+   model->invBandwidth   = saved->bandwidth > 0.0L ? 1.0L/saved->bandwidth : 0.0L;
+   model->qmr_sums       = saved->qmr_globalSums;
+   model->qmr_bytes      = saved->qmr_globalSumBytes;
+   model->gdk_sums       = saved->gdk_globalSums;
+   model->gdk_bytes      = saved->gdk_globalSumBytes;
+   model->qmr_comp       = max(0.0L, saved->qmr_only 
+         - model->qmr_sums*model->latency - model->qmr_bytes*model->invBandwidth);
+   model->gdk_comp       = max(0.0L, saved->gdk_plus_MV 
+         - model->gdk_sums*model->latency - model->gdk_bytes*model->invBandwidth);
+
+   /* Network of this run, from the global sums done so far (init_basis) */
+   update_network(model, primme->stats.numGlobalSumCalls, 
+      primme->stats.bytesGlobalSum, primme->stats.timeGlobalSum);
+   model->qmr_plus_MV_PR = saved->qmr_plus_MV_PR;
+   apply_network(model);
+
+   model->gdk_conv_rate  = saved->gdk_conv_rate;
+   model->jdq_conv_rate  = saved->jdq_conv_rate;
+   model->JDQMR_slowdown = saved->JDQMR_slowdown;
+   model->ratio_MV_outer = saved->ratio_MV_outer;
+   model->gdk_sum_logResReductions = saved->gdk_sum_logResReductions;
+   model->gdk_sum_MV     = saved->gdk_sum_MV;
+   model->jdq_sum_logResReductions = saved->jdq_sum_logResReductions;
+   model->jdq_sum_MV     = saved->jdq_sum_MV;
+   model->nevals_by_gdk  = 1;
+   model->nevals_by_jdq  = 1;
+
+   ratio = ratio_JDQMR_GDpk(model, 0, model->JDQMR_slowdown, 
+                                  model->ratio_MV_outer);
+   if (primme->numProcs > 1) {
+      primme_globalSum(&ratio, &globalRatio, &one, primme); 
+      ratio = globalRatio/primme->numProcs;
+   }
+
+   /* Switch 1->2 or 3->4 as switch_from_GDpk would */
+   if (ratio < 0.95) {
+      primme->dynamicMethodSwitch++;
+      primme->correctionParams.maxInnerIterations = -1;
+   }
+   if (primme->trace) primme_trace_record(primme_get_wtime(),
+      primme_event_method, primme_phase_convergence, 
+      primme->dynamicMethodSwitch, ratio, 0.0L, primme);
+   if (primme->printLevel >= 3 && primme->procID == 0) 
+      fprintf(primme->outputFile, "Ratio: %e Start with %s (saved model)\n",
+         ratio, ratio < 0.95 ? "JDQMR" : "GD+k");
+}
+
+/******************************************************************************
+ * Function save_model - Copies the model into saved, scaling the sums of
+ *    the convergence rates to the weight of one converged pair, as the
+ *    periodic reset of update_statistics does.
+ *
+ ******************************************************************************/
+static void save_model(primme_CostModel *model, primme_cost_model *saved) {
+
+   double gdkWeight = max(1, model->nevals_by_gdk);
+   double jdqWeight = max(1, model->nevals_by_jdq);
+
+   saved->calibrated     = model->gdk_plus_MV > 0.0L && 
+                           model->qmr_plus_MV_PR > 0.0L;
+   saved->MV             = model->MV;
+   saved->PR             = model->PR;
+   saved->qmr_only       = model->qmr_only;
+   saved->qmr_plus_MV_PR = model->qmr_plus_MV_PR;
+   saved->gdk_plus_MV    = model->gdk_plus_MV;
+   saved->gdk_conv_rate  = model->gdk_conv_rate;
+   saved->jdq_conv_rate  = model->jdq_conv_rate;
+   saved->JDQMR_slowdown = model->JDQMR_slowdown;
+   saved->ratio_MV_outer = model->ratio_MV_outer;
+   saved->gdk_sum_logResReductions = model->gdk_sum_logResReductions/gdkWeight;
+   saved->gdk_sum_MV     = model->gdk_sum_MV/gdkWeight;
+   saved->jdq_sum_logResReductions = model->jdq_sum_logResReductions/jdqWeight;
+   saved->jdq_sum_MV     = model->jdq_sum_MV/jdqWeight;
+   saved->latency        = model->latency;
+   saved->bandwidth      = model->invBandwidth > 0.0L ? 
+                           1.0L/model->invBandwidth : 0.0L;
+   saved->qmr_globalSums = model->qmr_sums;
+   saved->qmr_globalSumBytes = model->qmr_bytes;
+   saved->gdk_globalSums = model->gdk_sums;
+   saved->gdk_globalSumBytes = model->gdk_bytes;
+}
+
 #if 0
 /******************************************************************************
  *
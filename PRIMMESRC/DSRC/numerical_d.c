@@ -44,6 +44,24 @@ void Num_dcopy_dprimme(int n, double *x, int incx, double *y, int incy) {
    DCOPY(&ln, x, &lincx, y, &lincy);
 }
 /******************************************************************************/
+/* Copy the m x n matrix x with leading dimension ldx into y with leading     */
+/* dimension ldy. Used to move blocks of vectors between V (ldOPs) and evecs  */
+/* (nLocal).                                                                  */
+
+void Num_copy_matrix_dprimme(double *x, int m, int n, int ldx, double *y, int ldy) {
+
+   int i;
+
+   if (ldx == m && ldy == m) {
+      Num_dcopy_dprimme(m*n, x, 1, y, 1);
+   }
+   else {
+      for (i=0; i<n; i++) {
+         Num_dcopy_dprimme(m, &x[ldx*i], 1, &y[ldy*i], 1);
+      }
+   }
+}
+/******************************************************************************/
 
 void Num_gemm_dprimme(const char *transa, const char *transb, int m, int n, int k, 
    double alpha, double *a, int lda, double *b, int ldb, 
@@ -46,6 +46,7 @@ void Num_dsytrs_dprimme(const char *uplo, int n, int nrhs, double *a, int lda,
    int *ipivot, double *b, int ldb, int *info);
 
 void Num_dcopy_dprimme(int n, double *x, int incx, double *y, int incy);
+void Num_copy_matrix_dprimme(double *x, int m, int n, int ldx, double *y, int ldy);
 double Num_dot_dprimme(int n, double *x, int incx, double *y, int incy);
 void Num_gemm_dprimme(const char *transa, const char *transb, int m, int n, int k, 
    double alpha, double *a, int lda, double *b, int ldb, 
@@ -55,6 +55,7 @@
 #include "primme.h"         
 #include "numerical_d.h"
 #include "ortho_d.h"
+#include "primme_stats.h"
  
 
 /**********************************************************************
@@ -104,7 +105,8 @@
 int ortho_dprimme(double *basis, int ldBasis, int b1, int b2, 
    double *locked, int ldLocked, int numLocked, int nLocal, int *iseed, 
    double machEps, double *rwork, int rworkSize, primme_params *primme) {
-              
+
+   double tstart;           /* Start time of the phase */
    int i;                   /* Loop indices */
    int count;
    int returnValue;
@@ -149,6 +151,8 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
    if (rworkSize < minWorkSize) {
       return(minWorkSize);
    }
+
+   tstart = primme_phase_begin(primme_phase_ortho, primme);
    
    tol = sqrt(2.0L)/2.0L;
 
@@ -174,6 +178,7 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
 
             Num_larnv_dprimme(2, iseed, nLocal, &basis[ldBasis*i]); 
             randomizations++;
+            primme->stats.numRandomizations++;
             nOrth = 0;
          }
 
@@ -197,7 +202,7 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
          rwork[i+numLocked] = ztmp;
          overlaps = &rwork[i+numLocked+1];
          count = i + numLocked + 1;
-         (*primme->globalSumDouble)(rwork, overlaps, &count, primme);
+         primme_globalSum(rwork, overlaps, &count, primme);
 
          if (numLocked > 0) { /* locked array most recently accessed */
             Num_gemv_dprimme("N", nLocal, numLocked, tmone, locked, ldLocked, 
@@ -226,7 +231,7 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
             temp = Num_dot_dprimme(nLocal, &basis[ldBasis*i], 1, 
                                            &basis[ldBasis*i], 1);
             count = 1;
-            (*primme->globalSumDouble)(&temp, &s1, &count, primme);
+            primme_globalSum(&temp, &s1, &count, primme);
             s1 = sqrt(s1);
          }
 
@@ -242,6 +247,7 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
                fprintf(outputFile, "Reorthogonalizing: %d\n", i-b1);
             }
             /* No numerical benefit in normalizing the vector before reortho */
+            primme->stats.numReorthos++;
             s0 = s1;
             s02 = s1*s1;
          }
@@ -254,6 +260,7 @@ int ortho_dprimme(double *basis, int ldBasis, int b1, int b2,
       }
    }
          
+   primme_phase_end(primme_phase_ortho, tstart, primme);
    return 0;
 }
 
@@ -37,6 +37,8 @@
 #include "factorize_d.h"
 #include "update_projection_d.h"
 #include "numerical_d.h"
+#include "primme_memory.h"
+#include "primme_stats.h"
 
 
 /*******************************************************************************
@@ -61,6 +63,10 @@
  *
  * numGuesses       Number of remaining initial guesses
  *
+ * minRestartSize   The number of Ritz vectors to restart with, or the minimum
+ *                  with dtr. It is primme->minRestartSize unless autoTune or
+ *                  primme_thick_adaptive chose another one
+ *
  * previousHVecs    Coefficient vectors retained from the previous iteration
  *
  * numPrevRetained  The number of coefficient vectors in previousHVecs
@@ -119,17 +125,17 @@
 int restart_dprimme(double *V, double *W, double *H, double *hVecs,
    double *hVals, int *flags, int *iev, double *evecs, double *evecsHat, 
    double *M, double *UDU, int *ipivot, int basisSize, int numConverged, 
-   int *numConvergedStored, int numLocked, int numGuesses, 
+   int *numConvergedStored, int numLocked, int numGuesses, int minRestartSize,
    double *previousHVecs, int numPrevRetained, double machEps, 
    double *rwork, int rworkSize, primme_params *primme) {
-  
+
+   double tstart = primme_phase_begin(primme_phase_restart, primme);
    int numFree;             /* The number of basis vectors to be left free    */
    int numPacked;           /* The number of coefficient vectors moved to the */
                             /* end of the hVecs array.                        */
    int restartSize;         /* The number of vectors to restart with          */
    int indexOfPreviousVecs=0; /* Position within hVecs array the previous       */
                             /* coefficient vectors will be stored             */
-   int i, n, eStart;        /* various variables                              */
    int ret;                 /* Return value                                   */
 
    numPacked = 0;
@@ -144,11 +150,11 @@ int restart_dprimme(double *V, double *W, double *H, double *hVecs,
 
    if (primme->restartingParams.scheme == primme_dtr) {
       numFree = numPrevRetained+max(3, primme->maxBlockSize);
-      restartSize = dtr(numLocked, hVecs, hVals, flags, basisSize, numFree, 
-                        iev, rwork, primme);
+      restartSize = dtr(numLocked, hVecs, hVals, flags, basisSize, 
+                        minRestartSize, numFree, iev, rwork, primme);
    }
    else {
-      restartSize = min(basisSize, primme->minRestartSize);
+      restartSize = min(basisSize, minRestartSize);
    }
 
    /* ----------------------------------------------------------------------- */
@@ -185,13 +191,15 @@ int restart_dprimme(double *V, double *W, double *H, double *hVecs,
    /* Restart V by replacing it with the current Ritz vectors. */
    /* -------------------------------------------------------- */
 
-   restart_X(V, hVecs, primme->nLocal, basisSize, restartSize, rwork,rworkSize);
+   restart_X_dprimme(V, primme->ldOPs, hVecs, primme->nLocal, basisSize,
+      restartSize, rwork, rworkSize, primme);
    
    /* ------------------------------------------------------------ */
    /* Restart W by replacing it with W times the eigenvectors of H */
    /* ------------------------------------------------------------ */
 
-   restart_X(W, hVecs, primme->nLocal, basisSize, restartSize, rwork,rworkSize);
+   restart_X_dprimme(W, primme->ldOPs, hVecs, primme->nLocal, basisSize,
+      restartSize, rwork, rworkSize, primme);
 
    /* ---------------------------------------------------------------- */
    /* Because we have replaced V by the Ritz vectors, V'*A*V should be */
@@ -210,73 +218,125 @@ int restart_dprimme(double *V, double *W, double *H, double *hVecs,
 
    /* --------------------------------------------------------------------- */
    /* If the user requires (I-QQ') projectors in JDQMR without locking,     */
-   /* the converged eigenvectors are copied temporarily to evecs. There     */
-   /* they stay locked  for use in (I-QQ') and (I-K^{-1}Q () Q') projectors.*/
-   /* NOTE THIS IS NOT LOCKING! The Ritz vectors remain in the basis, and   */
-   /* they will overwrite evecs at the end.                                 */
-   /* We recommend against this type of usage. It's better to use locking.  */
+   /* the converged eigenvectors are copied temporarily to evecs.           */
    /* --------------------------------------------------------------------- */
 
-   /* Andreas NOTE: is done inefficiently for the moment. We should only */
-   /* add the recently converged. But we need to differentiate them      */
-   /* from flags...                                                      */
-
    if (!primme->locking && primme->correctionParams.maxInnerIterations != 0 && 
         numConverged > 0 &&
         (primme->correctionParams.projectors.LeftQ ||
          primme->correctionParams.projectors.RightQ )  ) {
 
-       n = primme->nLocal;
-       *numConvergedStored = 0;
-       eStart = primme->numOrthoConst;
-
-       for (i=0;i<primme->numEvals;i++) {
-           if (flags[i] == CONVERGED) {
-              if (*numConvergedStored < numConverged) {
-                 Num_dcopy_dprimme(n, &V[i*n], 1, 
-                              &evecs[(eStart+*numConvergedStored)*n], 1);
-                 (*numConvergedStored)++;
-              }
-           } /* if converged */
-       } /* for */
-       if (*numConvergedStored != numConverged) {
-          if (primme->printLevel >= 1 && primme->procID == 0) {
-             fprintf(primme->outputFile, 
-             "Flags and converged eigenpairs do not correspond %d %d\n",
-                numConverged, *numConvergedStored);
-          }
-          return PSEUDOLOCK_FAILURE;
-       }
-
-      /* Update also the M = K^{-1}evecs and its udu factorization if needed */
-      if (UDU != NULL) {
-
-         apply_preconditioner_block(&evecs[eStart*n], &evecsHat[eStart*n], 
-                                    numConverged, primme );
-         /* rwork must be maxEvecsSize*numEvals! */
-         update_projection_dprimme(evecs, evecsHat, M, eStart*n,
-           primme->numOrthoConst+primme->numEvals, numConverged, rwork, primme);
+      ret = pseudolock_vectors_dprimme(V, flags, evecs, evecsHat, M, UDU,
+         ipivot, numConverged, numConvergedStored, rwork, rworkSize, primme);
+      if (ret != 0) return ret;
+   }
+
+   primme_phase_end(primme_phase_restart, tstart, primme);
+   return restartSize;
+}
 
-         ret = UDUDecompose_dprimme(M, UDU, ipivot, eStart+numConverged, 
-                         rwork, rworkSize, primme);
-         if (ret != 0) {
-            primme_PushErrorMessage(Primme_lock_vectors,Primme_ududecompose,ret,
-               __FILE__, __LINE__, primme);
-            return UDUDECOMPOSE_FAILURE;
+
+/*******************************************************************************
+ * Subroutine pseudolock_vectors - Copies the Ritz vectors in V flagged as
+ *    converged to evecs, after the orthogonalization constraints. There
+ *    they stay locked for use in (I-QQ') and (I-K^{-1}Q () Q') projectors.
+ *    NOTE THIS IS NOT LOCKING! The Ritz vectors remain in the basis, and
+ *    they will overwrite evecs at the end.
+ *    We recommend against this type of usage. It's better to use locking.
+ *
+ *    It is called at restart, and again after soft locking flags a stored
+ *    pair as unconverged, so that evecs holds only the converged ones.
+ *
+ * Input parameters
+ * ----------------
+ * V            The basis, with the Ritz vectors in the first columns
+ *
+ * flags        Array indicating the convergence of the Ritz vectors
+ *
+ * numConverged The number of Ritz vectors flagged as converged
+ *
+ * rwork        Real work array; it must be maxEvecsSize*numEvals
+ *
+ * rworkSize    The size of rwork
+ *
+ * Output parameters
+ * -----------------
+ * evecs, evecsHat, M, UDU, ipivot   As in restart
+ *
+ * numConvergedStored The # of converged vectors copied to evecs
+ *
+ * Return value
+ * ------------
+ * int  0 on success
+ *     -4 factorization of M failed
+ *     -5 flags do not correspond to converged pairs
+ *
+ ******************************************************************************/
+
+int pseudolock_vectors_dprimme(double *V, int *flags, double *evecs, 
+   double *evecsHat, double *M, double *UDU, int *ipivot, int numConverged,
+   int *numConvergedStored, double *rwork, int rworkSize, 
+   primme_params *primme) {
+
+   int i, n, eStart, ret;
+
+   /* Andreas NOTE: is done inefficiently for the moment. We should only */
+   /* add the recently converged. But we need to differentiate them      */
+   /* from flags...                                                      */
+
+   n = primme->nLocal;
+   *numConvergedStored = 0;
+   eStart = primme->numOrthoConst;
+
+   for (i=0;i<primme->numEvals;i++) {
+      if (flags[i] == CONVERGED) {
+         if (*numConvergedStored < numConverged) {
+            Num_dcopy_dprimme(n, &V[i*primme->ldOPs], 1, 
+                         &evecs[(eStart+*numConvergedStored)*n], 1);
+            (*numConvergedStored)++;
          }
-      } /* if UDU factorization is needed */
-   } /* if this pseudo locking should take place */
+      } /* if converged */
+   } /* for */
+   if (*numConvergedStored != numConverged) {
+      if (primme->printLevel >= 1 && primme->procID == 0) {
+         fprintf(primme->outputFile, 
+         "Flags and converged eigenpairs do not correspond %d %d\n",
+            numConverged, *numConvergedStored);
+      }
+      return PSEUDOLOCK_FAILURE;
+   }
 
-   return restartSize;
+   /* Update also the M = K^{-1}evecs and its udu factorization if needed */
+   if (UDU != NULL && eStart+numConverged > 0) {
+
+      if (numConverged > 0) {
+         apply_preconditioner_block(&evecs[eStart*n], n, &evecsHat[eStart*n],
+                                    n, numConverged, primme );
+         update_projection_dprimme(evecs, n, evecsHat, n, M, eStart*n,
+           primme->numOrthoConst+primme->numEvals, numConverged, rwork, primme);
+      }
+
+      ret = UDUDecompose_dprimme(M, UDU, ipivot, eStart+numConverged, 
+                      rwork, rworkSize, primme);
+      if (ret != 0) {
+         primme_PushErrorMessage(Primme_lock_vectors,Primme_ududecompose,ret,
+            __FILE__, __LINE__, primme);
+         return UDUDECOMPOSE_FAILURE;
+      }
+   } /* if UDU factorization is needed */
+
+   return 0;
 }
 
 
 /*******************************************************************************
- * Subroutine restart_X - This subroutine computes X*hVecs and places 
+ * Subroutine restart_X_dprimme - This subroutine computes X*hVecs and places 
  *    the result in X.
  *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
+ * ldX          The leading dimension of X
+ *
  * nLocal       Number of rows of V assigned to the node
  *
  * basisSize    Current size of the basis V
@@ -290,6 +350,8 @@ int restart_dprimme(double *V, double *W, double *H, double *hVecs,
  *              (AvailRows * restartSize) = rworkSize
  *              Therefore rworkSize must be at least restartSize.
  *
+ * primme       Structure containing various solver parameters
+ *
  * INPUT/OUTPUT ARRAYS
  * -------------------
  * X      Holds either V or W before and after restarting
@@ -298,22 +360,34 @@ int restart_dprimme(double *V, double *W, double *H, double *hVecs,
  *
  ******************************************************************************/
   
-static void restart_X(double *X, double *hVecs, int nLocal, 
-   int basisSize, int restartSize, double *rwork, int rworkSize) {
+void restart_X_dprimme(double *X, int ldX, double *hVecs, int nLocal, 
+   int basisSize, int restartSize, double *rwork, int rworkSize,
+   primme_params *primme) {
 
    int i, k;  /* Loop variables */
    int AvailRows = min(rworkSize/restartSize, nLocal);
    double tpone = +1.0e+00, tzero = +0.0e+00;
    i = 0;
 
+   if (primme->outOfCoreDir != NULL) {
+      primme_prefetch(X, AvailRows*sizeof(double), ldX*sizeof(double), basisSize);
+   }
+
    while (i < nLocal) {
+      /* Start reading the next block of rows of an out-of-core X */
+      if (primme->outOfCoreDir != NULL && i+AvailRows < nLocal) {
+         primme_prefetch(&X[i+AvailRows],
+            min(AvailRows, nLocal-i-AvailRows)*sizeof(double), ldX*sizeof(double),
+            basisSize);
+      }
+
       /* Block matrix multiply */
       Num_gemm_dprimme("N", "N", AvailRows, restartSize, basisSize, tpone,
-         &X[i], nLocal, hVecs, basisSize, tzero, rwork, AvailRows );
+         &X[i], ldX, hVecs, basisSize, tzero, rwork, AvailRows );
 
       /* Copy the result in the desired location of X */
       for (k=0; k < restartSize; k++) {
-         Num_dcopy_dprimme(AvailRows, &rwork[AvailRows*k],1, &X[i+nLocal*k], 1);
+         Num_dcopy_dprimme(AvailRows, &rwork[AvailRows*k],1, &X[i+ldX*k], 1);
       }
       i = i+AvailRows;
       AvailRows = min(AvailRows, nLocal-i);
@@ -467,6 +541,8 @@ static int restart_H(double *H, double *hVecs, double *hVals,
  * 
  * basisSize  The current size of the basis
  *
+ * minRestartSize The minimum number of Ritz vectors to retain
+ *
  * numFree    Number of vacancies to be left in the basis
  *
  * iev        Array of size blockSize that determines index Ritz value index 
@@ -494,7 +570,8 @@ static int restart_H(double *H, double *hVecs, double *hVals,
 
 
 static int dtr(int numLocked, double *hVecs, double *hVals, int *flags, 
-  int basisSize, int numFree, int *iev, double *rwork, primme_params *primme)
+  int basisSize, int minRestartSize, int numFree, int *iev, 
+  double *rwork, primme_params *primme)
 {
 
    int i;                 /* Loop variable */
@@ -515,7 +592,7 @@ static int dtr(int numLocked, double *hVecs, double *hVals, int *flags,
 
    /* If locking is engaged, then lMin must be large enough to retain */
    /* the coefficient vector associated with a converged target.      */
-   /* lMin should be no smaller than primme->minRestartSize.            */
+   /* lMin should be no smaller than minRestartSize.                    */
 
    if (primme->locking) {
 
@@ -531,11 +608,11 @@ static int dtr(int numLocked, double *hVecs, double *hVals, int *flags,
          }
       }
 
-      lMin = max(lMin, min(basisSize, primme->minRestartSize));
+      lMin = max(lMin, min(basisSize, minRestartSize));
 
    }
    else {
-      lMin = min(basisSize, primme->minRestartSize);
+      lMin = min(basisSize, minRestartSize);
    }
 
    
@@ -908,7 +985,8 @@ static int combine_retained_vectors(double *hVals, int *flags, double *hVecs,
  *    
  * Input parameters
  * ----------------
- * previousHVecs   The coefficient vectors retained from the previous iteration
+ * previousHVecs   The coefficient vectors retained from the previous iteration,
+ *                 with leading dimension basisSize
  *
  * numPrevRetained  Number of previous vectors retained
  *
@@ -934,7 +1012,7 @@ static void compute_submatrix(double *previousHVecs, int numPrevRetained,
    double tpone = +1.0e+00, tzero = +0.0e+00;
 
    Num_symm_dprimme("L", "U", basisSize, numPrevRetained, tpone, H, 
-      maxBasisSize, previousHVecs, maxBasisSize, tzero, rwork, basisSize);
+      maxBasisSize, previousHVecs, basisSize, tzero, rwork, basisSize);
    
    Num_gemm_dprimme("C", "N", numPrevRetained, numPrevRetained, basisSize,
       tpone, previousHVecs, basisSize, rwork, basisSize, tzero, subMatrix, 
@@ -1072,6 +1150,10 @@ void reset_flags_dprimme(int *flag, int first, int last) {
  * ----------------
  * v         The vectors the preconditioner will be applied to.
  *
+ * ldv       The leading dimension of v
+ *
+ * ldresult  The leading dimension of result
+ *
  * blockSize The number of vectors in the blocks v, result
  *
  * primme      Structure containing various solver parameters
@@ -1082,16 +1164,18 @@ void reset_flags_dprimme(int *flag, int first, int last) {
  *
  ******************************************************************************/
 
-static void apply_preconditioner_block(double *v, double *result, 
-                int blockSize, primme_params *primme) {
+static void apply_preconditioner_block(double *v, int ldv, double *result, 
+                int ldresult, int blockSize, primme_params *primme) {
          
    if (primme->correctionParams.precondition) {
 
-      (*primme->applyPreconditioner)(v, result, &blockSize, primme);
+      primme_precond(v, &ldv, result, &ldresult, &blockSize,
+         primme);
       primme->stats.numPreconds += blockSize;
    }
    else {
-      Num_dcopy_dprimme(primme->nLocal*blockSize, v, 1, result, 1);
+      Num_copy_matrix_dprimme(v, primme->nLocal, blockSize, ldv, result,
+         ldresult);
    }
 
 }
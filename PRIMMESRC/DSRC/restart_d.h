@@ -34,8 +34,17 @@ void reset_flags_dprimme(int *flag, int first, int last);
 int restart_dprimme(double *V, double *W, double *H, double *hVecs, 
    double *hVals, int *flags, int *iev, double *evecs, double *evecsHat, 
    double *M, double *UDU, int *ipivot, int basisSize, int numConverged, 
-   int *numConvergedStored, int numLocked, int numGuesses, 
+   int *numConvergedStored, int numLocked, int numGuesses, int minRestartSize,
    double *previousHVecs, int numPrevRetained, double machEps, 
    double *rwork, int rworkSize, primme_params *primme);
 
+int pseudolock_vectors_dprimme(double *V, int *flags, double *evecs, 
+   double *evecsHat, double *M, double *UDU, int *ipivot, int numConverged,
+   int *numConvergedStored, double *rwork, int rworkSize, 
+   primme_params *primme);
+
+void restart_X_dprimme(double *X, int ldX, double *hVecs, int nLocal, 
+   int basisSize, int restartSize, double *rwork, int rworkSize,
+   primme_params *primme);
+
 #endif
@@ -35,16 +35,14 @@
 #define UDUDECOMPOSE_FAILURE     -4
 #define PSEUDOLOCK_FAILURE       -5
 
-static void restart_X(double *X, double *hVecs, int nLocal, 
-   int basisSize, int restartSize, double *rwork, int rworkSize);
-
 static int restart_H(double *H, double *hVecs, double *hVals, 
    int restartSize, int basisSize, double *previousHVecs, 
    int numPrevRetained, int indexOfPreviousVecs, int rworkSize, 
    double *rwork, primme_params *primme);
 
 static int dtr(int numLocked, double *hVecs, double *hVals, int *flags, 
- int basisSize, int numFree, int *iev, double *rwork, primme_params *primme);
+ int basisSize, int minRestartSize, int numFree, int *iev, 
+ double *rwork, primme_params *primme);
 
 static int pack_converged_coefficients(int *restartSize, int basisSize, 
    int *numPrevRetained, int numLocked, int numGuesses, double *hVecs, 
@@ -63,7 +61,7 @@ static int insert_submatrix(double *H, double *hVals, double *hVecs,
    int indexOfPreviousVecs, int rworkSize, double *rwork, 
    primme_params *primme);
 
-static void apply_preconditioner_block(double *v, double *result,
-   int blockSize, primme_params *primme);
+static void apply_preconditioner_block(double *v, int ldv, double *result,
+   int ldresult, int blockSize, primme_params *primme);
 
 #endif /* RESTART_PRIVATE_H */
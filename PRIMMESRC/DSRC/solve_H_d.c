@@ -31,6 +31,7 @@
 #include "solve_H_d.h"
 #include "solve_H_private_d.h"
 #include "numerical_d.h"
+#include "primme_stats.h"
 
 /*******************************************************************************
  * Subroutine solve_H - This procedure solves the eigenproblem for the
@@ -64,6 +65,7 @@ int solve_H_dprimme(double *H, double *hVecs, double *hVals,
    int basisSize, int maxBasisSize, double *largestRitzValue, int numLocked, 
    int lrwork, double *rwork, int *iwork, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_solve_H, primme);
    int i, j; /* Loop variables    */
    int info; /* dsyev error value */
    int index;
@@ -159,8 +161,10 @@ int solve_H_dprimme(double *H, double *hVecs, double *hVals,
    /* target:  smallest/Largest or interior closest abs/leq/geq to a shift   */
    /* ---------------------------------------------------------------------- */
 
-   if (primme->target == primme_smallest) 
+   if (primme->target == primme_smallest) {
+      primme_phase_end(primme_phase_solve_H, tstart, primme);
       return 0;
+   }
 
    if (primme->target == primme_largest) {
       for (i = 0; i < basisSize; i++) {
@@ -249,6 +253,7 @@ int solve_H_dprimme(double *H, double *hVecs, double *hVals,
    }
 
 
+   primme_phase_end(primme_phase_solve_H, tstart, primme);
    return 0;   
 }
 
@@ -29,6 +29,7 @@
 
 #include "primme.h"
 #include "update_W_d.h"
+#include "primme_stats.h"
 
 
 /*******************************************************************************
@@ -49,9 +50,63 @@
 void update_W_dprimme(double *V, double *W, int basisSize, int blockSize,
    primme_params *primme) {
 
-   (*primme->matrixMatvec)(&V[primme->nLocal*basisSize],
-                         &W[primme->nLocal*basisSize], &blockSize, primme);
+   void *request;
+
+   update_W_begin_dprimme(V, W, basisSize, blockSize, &request, primme);
+   update_W_wait_dprimme(&request, primme);
+
+}
+
+/*******************************************************************************
+ * Subroutine update_W_begin - Starts A*V(:,nv+1) through A*V(:,nv+blksze).
+ *           If the user provided matrixMatvecBegin and matrixMatvecWait, the
+ *           product may still be in progress on return, and W(:,nv+1:nv+blksze)
+ *           must not be read until update_W_wait is called. Otherwise the
+ *           product is computed synchronously with matrixMatvec.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * V          The orthonormal basis
+ * basisSize  Number of vectors in V
+ * blockSize  The current block size
+ * 
+ * OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------
+ * W          A*V (completed by update_W_wait)
+ * request    Handle of the operation to be passed to update_W_wait
+ ******************************************************************************/
+
+void update_W_begin_dprimme(double *V, double *W, int basisSize, 
+   int blockSize, void **request, primme_params *primme) {
+
+   *request = NULL;
+
+   if (primme->matrixMatvecBegin && primme->matrixMatvecWait) {
+      primme_matvec_begin(&V[primme->ldOPs*basisSize],
+            &primme->ldOPs, &W[primme->ldOPs*basisSize], &primme->ldOPs,
+            &blockSize, request, primme);
+   }
+   else {
+      primme_matvec(&V[primme->ldOPs*basisSize], &primme->ldOPs,
+            &W[primme->ldOPs*basisSize], &primme->ldOPs, &blockSize, primme);
+   }
 
    primme->stats.numMatvecs += blockSize;
 
 }
+
+/*******************************************************************************
+ * Subroutine update_W_wait - Completes the product started by update_W_begin.
+ *
+ * INPUT/OUTPUT PARAMETERS
+ * -----------------------
+ * request    Handle returned by update_W_begin
+ ******************************************************************************/
+
+void update_W_wait_dprimme(void **request, primme_params *primme) {
+
+   if (primme->matrixMatvecBegin && primme->matrixMatvecWait) {
+      primme_matvec_wait(request, primme);
+   }
+
+}
@@ -32,5 +32,8 @@
 
 void update_W_dprimme(double *V, double *W, int basisSize, int blockSize,
    primme_params *primme);
+void update_W_begin_dprimme(double *V, double *W, int basisSize, 
+   int blockSize, void **request, primme_params *primme);
+void update_W_wait_dprimme(void **request, primme_params *primme);
 
 #endif
@@ -31,6 +31,7 @@
 #include "const.h"
 #include "update_projection_d.h"
 #include "numerical_d.h"
+#include "primme_stats.h"
 
 /*******************************************************************************
  * Subroutine update_projection - Z = X'*Y. It assumes Z is a hermitian matrix 
@@ -41,7 +42,9 @@
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * X             Some nLocal x numCols matrix
+ * ldX           The leading dimension of X
  * Y             Some nLocal x numCols matrix
+ * ldY           The leading dimension of Y
  * numCols       Number of rows and columns in Z
  * maxCols       Maximum (leading) dimension of Z
  * blockSize     Number of rows and columns to be added to Z
@@ -52,10 +55,11 @@
  * rwork  Must be at least maxCols*blockSize in length
  ******************************************************************************/
 
-void update_projection_dprimme(double *X, double *Y, double *Z, 
-   int numCols, int maxCols, int blockSize, double *rwork, 
+void update_projection_dprimme(double *X, int ldX, double *Y, int ldY,
+   double *Z, int numCols, int maxCols, int blockSize, double *rwork, 
    primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_update_projection, primme);
    int j;    /* Loop variable  */ 
    int count;
    double tpone = +1.0e+00, tzero = +0.0e+00;
@@ -73,7 +77,7 @@ void update_projection_dprimme(double *X, double *Y, double *Z,
    /* --------------------------------------------------------------------- */
 
    Num_gemm_dprimme("C", "N", numCols+blockSize, blockSize, primme->nLocal, tpone, 
-      X, primme->nLocal, &Y[primme->nLocal*numCols], primme->nLocal, 
+      X, ldX, &Y[ldY*numCols], ldY, 
       tzero, rwork, maxCols);
 
    /* -------------------------------------------------------------- */
@@ -85,11 +89,13 @@ void update_projection_dprimme(double *X, double *Y, double *Z,
    /*
    for (j = numCols; j < numCols+blockSize; j++) {
       Num_gemv_dprimme("C", primme->nLocal, j-numCols+1, tpone,
-         &X[primme->nLocal*numCols], primme->nLocal, &Y[primme->nLocal*j], 1, 
+         &X[ldX*numCols], ldX, &Y[ldY*j], 1, 
          tzero, &rwork[maxCols*(j-numCols)+numCols], 1);  
    }
    */
    
    count = maxCols*blockSize;
-   (*primme->globalSumDouble)(rwork, &Z[maxCols*numCols], &count, primme);
+   primme_globalSum(rwork, &Z[maxCols*numCols], &count, primme);
+
+   primme_phase_end(primme_phase_update_projection, tstart, primme);
 }
@@ -34,6 +34,9 @@
 #include "convergence_z.h"
 #include "convergence_private_z.h"
 #include "numerical_z.h"
+#include "primme_memory.h"
+#include "primme_stats.h"
+#include "primme_trace.h"
 
 /*******************************************************************************
  * Subroutine check_convergence - This procedure checks the block vectors for  
@@ -76,6 +79,7 @@ int check_convergence_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
    Complex_Z *evecs, double tol, double maxConvTol, double aNormEstimate, 
    Complex_Z *rwork, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_convergence, primme);
    int i;             /* Loop variable                                        */
    int left, right;   /* Range of block vectors to be checked for convergence */
    int start;         /* starting index in block of converged/tobeProject vecs*/
@@ -166,7 +170,8 @@ int check_convergence_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
                    primme->printLevel >= 2) { fprintf(primme->outputFile, 
                   "#Converged %d eval[ %d ]= %e norm %e Mvecs %d Time %g\n",
                   numConverged+recentlyConverged, iev[i], hVals[iev[i]], 
-                  blockNorms[i], primme->stats.numMatvecs,primme_wTimer(0));
+                  blockNorms[i], primme->stats.numMatvecs,
+                  primme_wTimer_r(&primme->timerStart, 0));
                   fflush(primme->outputFile);
                } /* printf */
             } /*if */
@@ -192,8 +197,9 @@ int check_convergence_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
       /* ---------------------------------------------------------------- */
       if (numVacancies > 0 || numToProject > 0) {
 
-         swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, 
-            blockNorms, primme->numOrthoConst + numLocked, *blockSize, left);
+         swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev,
+            flags, blockNorms, primme->numOrthoConst + numLocked, *blockSize,
+            left);
       }
       /* --------------------------------------------------------------- */
       /* Project the TO_BE_PROJECTED residuals and check for practical   */
@@ -224,6 +230,7 @@ int check_convergence_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
 
    } /* while there are vacancies */
 
+   primme_phase_end(primme_phase_convergence, tstart, primme);
    return recentlyConverged;
 }
 
@@ -259,6 +266,9 @@ static void compute_resnorms(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
 
    int i;            /* Loop variable                             */
    int numResiduals; /* Number of residual vectors to be computed */
+   int row, rows;    /* First row and number of rows of a block   */
+   int tileRows;     /* Number of rows of the blocks              */
+   int ldV;          /* Leading dimension of V and W              */
    double *dwork = (double *) rwork;  /* pointer casting rwork to double */
    Complex_Z ztmp;     /* temp var holding shift                    */
    Complex_Z tpone = {+1.0e+00,+0.0e00}, tzero = {+0.0e+00,+0.0e00};       /* constants */
@@ -268,35 +278,58 @@ static void compute_resnorms(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
    /* We want to compute residuals r = Ax-hVal*x for the Ritz vectors x */
    /* Eqivalently, r = A*V*hVec - hval*V*hVec = W*hVec - hVal*V*hVec.   */
 
-   /* Compute the Ritz vectors */
+   /* The Ritz vectors, the residuals and their norms are computed on */
+   /* blocks of rows, so the new columns are still in cache for the    */
+   /* axpy and the dot, and V and W are read in a single pass. If the  */
+   /* workspace is out of core, the next block of rows is prefetched.  */
+
+   ldV = primme->ldOPs;
+   tileRows = max(STREAM_TILE_BYTES/(2*numResiduals*(int)sizeof(Complex_Z)), 1);
+   if (primme->outOfCoreDir != NULL) {
+      primme_prefetch(V, min(tileRows, primme->nLocal)*sizeof(Complex_Z),
+         ldV*sizeof(Complex_Z), basisSize);
+      primme_prefetch(W, min(tileRows, primme->nLocal)*sizeof(Complex_Z),
+         ldV*sizeof(Complex_Z), basisSize);
+   }
 
-   Num_gemm_zprimme("N", "N", primme->nLocal, numResiduals, basisSize, 
-      tpone, V, primme->nLocal, hVecs, basisSize, tzero,
-      &V[primme->nLocal*(basisSize+left)], primme->nLocal);
+   for (i=left; i <= right; i++) {
+      dwork[i] = 0.0L;
+   }
 
-   /* Compute W*hVecs */
+   for (row=0; row < primme->nLocal; row+=tileRows) {
+      rows = min(tileRows, primme->nLocal-row);
 
-   Num_gemm_zprimme("N", "N", primme->nLocal, numResiduals, basisSize, 
-      tpone, W, primme->nLocal, hVecs, basisSize, tzero,
-      &W[primme->nLocal*(basisSize+left)], primme->nLocal);
+      if (primme->outOfCoreDir != NULL && row+rows < primme->nLocal) {
+         primme_prefetch(&V[row+rows],
+            min(tileRows, primme->nLocal-row-rows)*sizeof(Complex_Z),
+            ldV*sizeof(Complex_Z), basisSize);
+         primme_prefetch(&W[row+rows],
+            min(tileRows, primme->nLocal-row-rows)*sizeof(Complex_Z),
+            ldV*sizeof(Complex_Z), basisSize);
+      }
 
-   /* Compute the residuals */
+      /* Compute the Ritz vectors and W*hVecs */
 
-   for (i=left; i <= right; i++) {
-      {ztmp.r = -hVals[iev[i]]; ztmp.i = 0.0L;}
-      Num_axpy_zprimme(primme->nLocal, ztmp, &V[primme->nLocal*(basisSize+i)],
-       1, &W[primme->nLocal*(basisSize+i)], 1);
-   }
+      Num_gemm_zprimme("N", "N", rows, numResiduals, basisSize, tpone,
+         &V[row], ldV, hVecs, basisSize, tzero, &V[ldV*(basisSize+left)+row],
+         ldV);
+      Num_gemm_zprimme("N", "N", rows, numResiduals, basisSize, tpone,
+         &W[row], ldV, hVecs, basisSize, tzero, &W[ldV*(basisSize+left)+row],
+         ldV);
 
-   /* Compute the residual norms */
+      /* Compute the residuals and accumulate their squared norms */
 
-   for (i=left; i <= right; i++) {
-      ztmp = Num_dot_zprimme(primme->nLocal, &W[primme->nLocal*(basisSize+i)],
-         1, &W[primme->nLocal*(basisSize+i)] , 1);
-      dwork[i] = ztmp.r;
+      for (i=left; i <= right; i++) {
+         {ztmp.r = -hVals[iev[i]]; ztmp.i = 0.0L;}
+         Num_axpy_zprimme(rows, ztmp, &V[ldV*(basisSize+i)+row], 1,
+            &W[ldV*(basisSize+i)+row], 1);
+         ztmp = Num_dot_zprimme(rows, &W[ldV*(basisSize+i)+row], 1,
+            &W[ldV*(basisSize+i)+row], 1);
+         dwork[i] += ztmp.r;
+      }
    }
    
-   (*primme->globalSumDouble)(&dwork[left], &blockNorms[left], &numResiduals,
+   primme_globalSum(&dwork[left], &blockNorms[left], &numResiduals,
                               primme);
 
    for (i=left; i <= right; i++) {
@@ -308,7 +341,8 @@ static void compute_resnorms(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs,
 
 /*******************************************************************************
  * Subroutine print_residuals - This function displays the residual norms of 
- *    each Ritz vector computed at this iteration.
+ *    each Ritz vector computed at this iteration, and records them in the
+ *    trace if enabled.
  *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
@@ -329,6 +363,15 @@ static void print_residuals(double *ritzValues, double *blockNorms,
 
    int i;  /* Loop variable */
    int found;  /* Loop variable */
+   double t;   /* Time of the trace events */
+
+   if (primme->trace) {
+      t = primme_get_wtime();
+      for (i=left; i <= right; i++) {
+         primme_trace_record(t, primme_event_ritz, primme_phase_convergence,
+            iev[i], ritzValues[iev[i]], blockNorms[i], primme);
+      }
+   }
 
    if (primme->printLevel >= 3 && primme->procID == 0) {
 
@@ -341,7 +384,8 @@ static void print_residuals(double *ritzValues, double *blockNorms,
          fprintf(primme->outputFile, 
             "OUT %d conv %d blk %d MV %d Sec %E EV %13E |r| %.3E\n",
          primme->stats.numOuterIterations, found, i, primme->stats.numMatvecs,
-         primme_wTimer(0), ritzValues[iev[i]], blockNorms[i]);
+         primme_wTimer_r(&primme->timerStart, 0), ritzValues[iev[i]],
+         blockNorms[i]);
       }
 
       fflush(primme->outputFile);
@@ -365,6 +409,7 @@ static void print_residuals(double *ritzValues, double *blockNorms,
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * nLocal        Number of rows of V assigned to the node
+ * ldV           Leading dimension of V and W
  * basisSize     Number of vectors in the basis V
  * flags         Indicates which of the Ritz vectors have converged/flagged
  * blockSize     Number of block vectors
@@ -378,7 +423,7 @@ static void print_residuals(double *ritzValues, double *blockNorms,
  * blockNorms    the norms for each vector in the block
  ******************************************************************************/
      
-static void swap_UnconvVecs(Complex_Z *V, Complex_Z *W, int nLocal, 
+static void swap_UnconvVecs(Complex_Z *V, Complex_Z *W, int nLocal, int ldV,
    int basisSize, int *iev, int *flags, double *blockNorms, int dimEvecs, 
    int blockSize, int left) {
 
@@ -426,20 +471,20 @@ static void swap_UnconvVecs(Complex_Z *V, Complex_Z *W, int nLocal,
 
          if (flags[iev[left]] != TO_BE_PROJECTED) { 
                 /* replace */
-            Num_zcopy_zprimme(nLocal, &V[nLocal*(basisSize+right)], 1,
-               &V[nLocal*(basisSize+left)], 1);
-            Num_zcopy_zprimme(nLocal, &W[nLocal*(basisSize+right)], 1,
-               &W[nLocal*(basisSize+left)], 1);
+            Num_zcopy_zprimme(nLocal, &V[ldV*(basisSize+right)], 1,
+               &V[ldV*(basisSize+left)], 1);
+            Num_zcopy_zprimme(nLocal, &W[ldV*(basisSize+right)], 1,
+               &W[ldV*(basisSize+left)], 1);
             temp = iev[left];
             iev[left] = iev[right];
             iev[right] = temp;
             blockNorms[left] = blockNorms[right];
          }
          else { /* swap */
-            Num_swap_zprimme(nLocal, &V[nLocal*(basisSize+left)], 1, 
-                              &V[nLocal*(basisSize+right)], 1);
-            Num_swap_zprimme(nLocal, &W[nLocal*(basisSize+left)], 1, 
-                              &W[nLocal*(basisSize+right)], 1);
+            Num_swap_zprimme(nLocal, &V[ldV*(basisSize+left)], 1, 
+                              &V[ldV*(basisSize+right)], 1);
+            Num_swap_zprimme(nLocal, &W[ldV*(basisSize+left)], 1, 
+                              &W[ldV*(basisSize+right)], 1);
             temp = iev[left];
             iev[left] = iev[right];
             iev[right] = temp;
@@ -561,7 +606,7 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
    int *recentlyConverged, int *numVacancies, Complex_Z *rwork, 
    primme_params *primme) {
 
-   int i, n, dimEvecs;
+   int i, n, ldV, dimEvecs;
    int count; 
    double normPr; 
    double normDiff;
@@ -570,6 +615,7 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
 
    /* convenience variables */
    n        = primme->nLocal;
+   ldV      = primme->ldOPs;
    dimEvecs = primme->numOrthoConst + numLocked;
 
    /* Subdivide rwork */
@@ -588,8 +634,8 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
          flags[iev[i]] = UNCONVERGED;
 
    if (*numVacancies > 0)
-      swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, 
-                   blockNorms, dimEvecs, blockSize, start);
+      swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev,
+                   flags, blockNorms, dimEvecs, blockSize, start);
 
    /* ------------------------------------------------------------------ */
    /* Project the numToProject residuals agaist (I-evecs*evecs')         */
@@ -598,16 +644,16 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
    /* overlaps = evecs'*residuals */
 
    Num_gemm_zprimme("C", "N", dimEvecs, numToProject, n, tpone, evecs, n, 
-                  &W[(basisSize+start)*n], n, tzero, rwork, dimEvecs);
+                  &W[(basisSize+start)*ldV], ldV, tzero, rwork, dimEvecs);
 
    /* In Complex, the size of the array to globalSum is twice as large */
    count = 2*(dimEvecs*numToProject);
-   (*primme->globalSumDouble)(rwork, overlaps, &count, primme);
+   primme_globalSum(rwork, overlaps, &count, primme);
 
    /* residuals = residuals - evecs*overlaps */
 
    Num_gemm_zprimme("N", "N", n, numToProject, dimEvecs, tmone, evecs, n, 
-                  overlaps, dimEvecs, tpone, &W[(basisSize+start)*n], n);
+                  overlaps, dimEvecs, tpone, &W[(basisSize+start)*ldV], ldV);
 
    /* ------------------------------------------------------------------ */
    /* Compute norms^2 of the projected res and the differences from res  */ 
@@ -619,13 +665,13 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
       rwork[i] = Num_dot_zprimme(dimEvecs, &overlaps[dimEvecs*i], 1, 
                                 &overlaps[dimEvecs*i], 1);
       /* || (I-QQ')res || */
-      rwork[i+numToProject] = Num_dot_zprimme(n, &W[(basisSize+start+i)*n], 1,
-                                &W[(basisSize+start+i)*n], 1);
+      rwork[i+numToProject] = Num_dot_zprimme(n, &W[(basisSize+start+i)*ldV],
+                                1, &W[(basisSize+start+i)*ldV], 1);
    }
    /* global sum ||overlaps|| and ||(I-QQ')r|| */
    /* In Complex, the size of the array to globalSum is twice as large */
    count = 2*(2*numToProject);
-   (*primme->globalSumDouble)(rwork, &rwork[count], &count, primme);
+   primme_globalSum(rwork, &rwork[count], &count, primme);
 
    /* ------------------------------------------------------------------ */
    /* For each projected residual check whether there is an accuracy     */
@@ -665,7 +711,7 @@ static void check_practical_convergence(Complex_Z *V, Complex_Z *W,
 
    start = blockSize - *numVacancies;
 
-   swap_UnconvVecs(V, W, primme->nLocal, basisSize, iev, flags, blockNorms, 
-                         dimEvecs, blockSize, start);
+   swap_UnconvVecs(V, W, primme->nLocal, primme->ldOPs, basisSize, iev, flags,
+                         blockNorms, dimEvecs, blockSize, start);
 
 }
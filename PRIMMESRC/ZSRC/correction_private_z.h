@@ -42,8 +42,8 @@ static void mergeSort(double *lockedEvals, int numLocked, double *ritzVals,
 static void Olsen_preconditioner_block(Complex_Z *r, Complex_Z *x,
    int blockSize, Complex_Z *rwork, primme_params *primme) ;
 
-static void apply_preconditioner_block(Complex_Z *v, Complex_Z *result,
-   int blockSize, primme_params *primme);
+static void apply_preconditioner_block(Complex_Z *v, int ldv, Complex_Z *result,
+   int ldresult, int blockSize, primme_params *primme);
 
 static void setup_JD_projectors(Complex_Z *x, Complex_Z *r, Complex_Z *evecs,
    Complex_Z *evecsHat, Complex_Z *Kinvx, Complex_Z *xKinvx,
@@ -34,6 +34,7 @@
 #include "correction_private_z.h"
 #include "inner_solve_z.h"
 #include "numerical_z.h"
+#include "primme_stats.h"
 
 /*******************************************************************************
  * Subroutine solve_correction - This routine solves the correction equation
@@ -84,7 +85,7 @@
  *                        *----------------------------------------------------*
  *                        | The following are optional and mutually exclusive: |
  *                        *------------------------------+                     |
- *                + 4*primme->nLocal + primme->nLocal    | For QMR work and sol|
+ *                + 3*primme->nLocal + primme->nLocal    | For QMR work and sol|
  *                + primme->nLocal*primme->maxBlockSize  | OLSEN for Kinvx     |
  *                                                       *---------------------*
  *
@@ -193,7 +194,7 @@ int solve_correction_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *evecs,
       linSolverRWork = sol + primme->nLocal;      /* sol needed in innerJD */
       neededRsize = neededRsize + primme->nLocal;
       linSolverRWorkSize =                        /* Inner solver worksize */
-              4*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals);
+              3*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals);
       neededRsize = neededRsize + linSolverRWorkSize;
    }
    sortedRitzVals = (double *)(linSolverRWork + linSolverRWorkSize);
@@ -337,8 +338,8 @@ int solve_correction_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *evecs,
       /* This is Generalized Davidson or approximate Olsen's method. */
       /* Perform block preconditioning (with or without projections) */
       
-      r = &W[primme->nLocal*basisSize];    /* All the block residuals    */
-      x = &V[primme->nLocal*basisSize];    /* All the block Ritz vectors */
+      r = &W[primme->ldOPs*basisSize];     /* All the block residuals    */
+      x = &V[primme->ldOPs*basisSize];     /* All the block Ritz vectors */
       
       if ( primme->correctionParams.projectors.RightX &&
            primme->correctionParams.projectors.SkewX    ) {    
@@ -356,13 +357,14 @@ int solve_correction_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *evecs,
                /* Compute r_i = r_i - err_i * x_i */
                {tmpShift.r = -approxOlsenEps[blockIndex]; tmpShift.i = 0.0L;}
                Num_axpy_zprimme(primme->nLocal, tmpShift,
-               &x[primme->nLocal*blockIndex],1,&r[primme->nLocal*blockIndex],1);
+               &x[primme->ldOPs*blockIndex],1,&r[primme->ldOPs*blockIndex],1);
             } /* for */
          }
 
          /* GD: compute K^{-1}r , or approx.Olsen: K^{-1}(r-ex) */
 
-         apply_preconditioner_block(r, x, blockSize, primme );
+         apply_preconditioner_block(r, primme->ldOPs, x, primme->ldOPs,
+            blockSize, primme );
       }
    }
    /* ------------------------------------------------------------ */
@@ -374,8 +376,8 @@ int solve_correction_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *evecs,
 
       for (blockIndex = 0; blockIndex < blockSize; blockIndex++) {
 
-         r = &W[primme->nLocal*(basisSize+blockIndex)];
-         x = &V[primme->nLocal*(basisSize+blockIndex)];
+         r = &W[primme->ldOPs*(basisSize+blockIndex)];
+         x = &V[primme->ldOPs*(basisSize+blockIndex)];
 
          /* Set up the left/right/skew projectors for JDQMR.        */
          /* The pointers Lprojector, Rprojector(Q/X) point to the   */
@@ -406,8 +408,7 @@ int solve_correction_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *evecs,
             return (INNER_SOLVE_FAILURE);
          }
 
-         Num_zcopy_zprimme(primme->nLocal, sol, 1, 
-            &V[primme->nLocal*(basisSize+blockIndex)], 1);
+         Num_zcopy_zprimme(primme->nLocal, sol, 1, x, 1);
 
       } /* end for each block vector */
    } /* JDqmr variants */
@@ -633,6 +634,10 @@ static void mergeSort(double *lockedEvals, int numLocked, double *ritzVals,
  * ----------------
  * v         The vectors the preconditioner will be applied to.
  *
+ * ldv       The leading dimension of v
+ *
+ * ldresult  The leading dimension of result
+ *
  * blockSize The number of vectors in the blocks v, result
  *
  * primme      Structure containing various solver parameters
@@ -643,16 +648,18 @@ static void mergeSort(double *lockedEvals, int numLocked, double *ritzVals,
  *
  ******************************************************************************/
 
-static void apply_preconditioner_block(Complex_Z *v, Complex_Z *result, 
-                int blockSize, primme_params *primme) {
+static void apply_preconditioner_block(Complex_Z *v, int ldv, Complex_Z *result, 
+                int ldresult, int blockSize, primme_params *primme) {
          
    if (primme->correctionParams.precondition) {
 
-      (*primme->applyPreconditioner)(v, result, &blockSize, primme);
+      primme_precond(v, &ldv, result, &ldresult, &blockSize,
+         primme);
       primme->stats.numPreconds += blockSize;
    }
    else {
-      Num_zcopy_zprimme(primme->nLocal*blockSize, v, 1, result, 1);
+      Num_copy_matrix_zprimme(v, primme->nLocal, blockSize, ldv, result,
+         ldresult);
    }
 
 }
@@ -700,7 +707,8 @@ static void Olsen_preconditioner_block(Complex_Z *r, Complex_Z *x,
    /* Compute K^{-1}x for block x. Kinvx memory requirement (blockSize*nLocal)*/
    /*------------------------------------------------------------------ */
 
-   apply_preconditioner_block(x, Kinvx, blockSize, primme );
+   apply_preconditioner_block(x, primme->ldOPs, Kinvx, primme->nLocal,
+      blockSize, primme );
 
    /*------------------------------------------------------------------ */
    /* Compute local x^TK^{-1}x and x^TK^{-1}r = (K^{-1}x)^Tr for each vector */
@@ -708,20 +716,21 @@ static void Olsen_preconditioner_block(Complex_Z *r, Complex_Z *x,
 
    for (blockIndex = 0; blockIndex < blockSize; blockIndex++) {
       xKinvx_local[blockIndex] =
-        Num_dot_zprimme(primme->nLocal, &x[primme->nLocal*blockIndex],1, 
+        Num_dot_zprimme(primme->nLocal, &x[primme->ldOPs*blockIndex],1, 
                            &Kinvx[primme->nLocal*blockIndex],1);
       xKinvr_local[blockIndex] =
         Num_dot_zprimme(primme->nLocal, &Kinvx[primme->nLocal*blockIndex],1,
-                                   &r[primme->nLocal*blockIndex],1);
+                                   &r[primme->ldOPs*blockIndex],1);
    }      
    count = 4*blockSize;
-   (*primme->globalSumDouble)(xKinvx_local, xKinvx, &count, primme);
+   primme_globalSum(xKinvx_local, xKinvx, &count, primme);
 
    /*------------------------------------------------------------------*/
    /* Compute K^{-1}r                                                  */
    /*------------------------------------------------------------------*/
 
-   apply_preconditioner_block(r, x, blockSize, primme );
+   apply_preconditioner_block(r, primme->ldOPs, x, primme->ldOPs, blockSize,
+      primme );
 
    /*------------------------------------------------------------------*/
    /* Compute K^(-1)r  - ( xKinvr/xKinvx ) K^(-1)r for each vector     */
@@ -738,7 +747,7 @@ static void Olsen_preconditioner_block(Complex_Z *r, Complex_Z *x,
          alpha = tzero;
 
       Num_axpy_zprimme(primme->nLocal,alpha,&Kinvx[primme->nLocal*blockIndex],
-                                       1, &x[primme->nLocal*blockIndex],1);
+                                       1, &x[primme->ldOPs*blockIndex],1);
    } /*for*/
 
 } /* of Olsen_preconditiner_block */
@@ -899,11 +908,12 @@ static void setup_JD_projectors(Complex_Z *x, Complex_Z *r, Complex_Z *evecs,
    
       if (primme->correctionParams.precondition   &&
           primme->correctionParams.projectors.SkewX) {
-         (*primme->applyPreconditioner)(x, Kinvx, &ONE, primme);
+         primme_precond(x, &primme->nLocal, Kinvx,
+            &primme->nLocal, &ONE, primme);
          primme->stats.numPreconds += 1;
          *RprojectorX  = Kinvx;
          xKinvx_local = Num_dot_zprimme(primme->nLocal, x, 1, Kinvx, 1);
-         (*primme->globalSumDouble)(&xKinvx_local, xKinvx, &count, primme);
+         primme_globalSum(&xKinvx_local, xKinvx, &count, primme);
       }      
       else {
          *RprojectorX = x;
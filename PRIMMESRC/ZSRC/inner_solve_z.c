@@ -35,6 +35,7 @@
 #include "inner_solve_private_z.h"
 #include "factorize_z.h"
 #include "numerical_z.h"
+#include "primme_stats.h"
 
 
 /*******************************************************************************
@@ -96,7 +97,7 @@
  * machEps     machine precision
  *
  * rwork       Real workspace of size 
- *             4*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals)
+ *             3*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals)
  *
  * rworkSize   Size of the rwork array
  *
@@ -105,8 +106,8 @@
  *
  * Input/Output parameters
  * -----------------------
- * r       The residual with respect to the Ritz vector.  May be altered upon
- *         return.
+ * r       The residual with respect to the Ritz vector. It is overwritten
+ *         with the residual of the linear system during the iteration.
  * rnorm   On input, the 2 norm of r. No need to recompute it initially.
  *         On output, the estimated 2 norm of the updated eigenvalue residual
  * 
@@ -129,6 +130,7 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
    double eresTol, double aNormEstimate, double machEps, Complex_Z *rwork, 
    int rworkSize, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_inner_solve, primme);
    int i;             /* loop variable                                       */
    int numIts;        /* Number of inner iterations                          */
    int ret;           /* Return value used for error checking.               */
@@ -165,8 +167,8 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
    /* Subdivide the workspace into needed arrays */
    /* -------------------------------------------*/
 
-   g      = rwork;
-   d      = g + primme->nLocal;
+   g      = r;     /* Assume zero initial guess; iterate on r in place */
+   d      = rwork;
    delta  = d + primme->nLocal;
    w      = delta + primme->nLocal;
    workSpace = w + primme->nLocal; /* This needs at least 2*numOrth+NumEvals) */
@@ -223,9 +225,6 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
    /* Rest of initializations                                 */
    /* --------------------------------------------------------*/
 
-   /* Assume zero initial guess */
-   Num_zcopy_zprimme(primme->nLocal, r, 1, g, 1);
-
    ret = apply_projected_preconditioner(g, evecs, RprojectorQ, 
            x, RprojectorX, sizeRprojectorQ, sizeRprojectorX, 
            xKinvx, UDU, ipivot, d, workSpace, primme);
@@ -386,7 +385,8 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
          if (primme->printLevel >= 4 && primme->procID == 0) {
             fprintf(primme->outputFile,
            "INN MV %d Sec %e Eval %e Lin|r| %.3e EV|r| %.3e\n", primme->stats.
-            numMatvecs, primme_wTimer(0), eval_updated, tau, eres_updated);
+            numMatvecs, primme_wTimer_r(&primme->timerStart, 0), eval_updated,
+            tau, eres_updated);
             fflush(primme->outputFile);
          }
 
@@ -397,7 +397,7 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
         /* Report for non adaptive inner iterations */
         fprintf(primme->outputFile,
            "INN MV %d Sec %e Lin|r| %e\n", primme->stats.numMatvecs,
-           primme_wTimer(0),tau);
+           primme_wTimer_r(&primme->timerStart, 0),tau);
         fflush(primme->outputFile);
       }
 
@@ -439,6 +439,7 @@ int inner_solve_zprimme(Complex_Z *x, Complex_Z *r, double *rnorm,
      /* --------------------------------------------------------*/
 
    *rnorm = eres_updated;
+   primme_phase_end(primme_phase_inner_solve, tstart, primme);
    return 0;
 }
    
@@ -499,7 +500,8 @@ static int apply_projected_preconditioner(Complex_Z *v, Complex_Z *Q,
 
    if (primme->correctionParams.precondition) {
       /* Place K^{-1}v in result */
-      (*primme->applyPreconditioner)(v, result, &ONE, primme);
+      primme_precond(v, &primme->nLocal, result,
+         &primme->nLocal, &ONE, primme);
       primme->stats.numPreconds += 1;
    }
    else {
@@ -600,7 +602,7 @@ static int apply_skew_projector(Complex_Z *Q, Complex_Z *Qhat, Complex_Z *UDU,
          /* Global sum: overlaps = Q'*v */
          /* In Complex, the size of the array to globalSum is twice as large */
          count = 2*numCols;
-         (*primme->globalSumDouble)(workSpace, overlaps, &count, primme);   
+         primme_globalSum(workSpace, overlaps, &count, primme);   
 
          /* --------------------------------------------*/
          /* Backsolve only if there is a skew projector */
@@ -663,7 +665,8 @@ static void apply_projected_matrix(Complex_Z *v, double shift, Complex_Z *Q,
    int ONE = 1;   /* For passing it by reference in matrixMatvec */
    Complex_Z ztmp; 
 
-   (*primme->matrixMatvec)(v, result, &ONE, primme);
+   primme_matvec(v, &primme->nLocal, result, &primme->nLocal, &ONE,
+      primme);
    {ztmp.r = -shift; ztmp.i = 0.0L;}
    Num_axpy_zprimme(primme->nLocal, ztmp, v, 1, result, 1); 
    if (dimQ > 0)
@@ -710,7 +713,7 @@ static void apply_projector(Complex_Z *Q, int numCols, Complex_Z *v,
       v, 1, tzero, workSpace, 1);
    /* In Complex, the size of the array to globalSum is twice as large */
    count = 2*numCols;
-   (*primme->globalSumDouble)(workSpace, overlaps, &count, primme);   
+   primme_globalSum(workSpace, overlaps, &count, primme);   
    Num_gemv_zprimme("N", primme->nLocal, numCols, tmone, Q, primme->nLocal,
       overlaps, 1, tpone, v, 1);
 
@@ -743,7 +746,7 @@ static Complex_Z dist_dot(Complex_Z *x, int incx,
    temp = Num_dot_zprimme(primme->nLocal, x, incx, y, incy);
    /* In Complex, the size of the array to globalSum is twice as large */
    count = 2;
-   (*primme->globalSumDouble)(&temp, &product, &count, primme);
+   primme_globalSum(&temp, &product, &count, primme);
    return product;
                                                                                 
 }
@@ -0,0 +1,410 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: krylov_schur.c
+ *
+ * Purpose - Thick restarted Lanczos in Krylov-Schur form, the engine behind
+ *           the unpreconditioned Arnoldi preset.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "primme.h"
+#include "const.h"
+#include "wtime.h"
+#include "krylov_schur_z.h"
+#include "krylov_schur_private_z.h"
+#include "ortho_z.h"
+#include "restart_z.h"
+#include "solve_H_z.h"
+#include "update_projection_z.h"
+#include "update_W_z.h"
+#include "numerical_z.h"
+#include "primme_stats.h"
+#include "primme_trace.h"
+
+/******************************************************************************
+ * Function krylov_schur_applies_zprimme - Returns true if the eigenproblem
+ *    is solved by krylov_schur instead of main_iter. That is the case for
+ *    restartingParams.scheme == primme_krylov_schur (set by the Arnoldi
+ *    preset) with block size 1, no preconditioner nor inner iterations,
+ *    and room in the basis for numEvals Ritz vectors plus one expansion.
+ *    The monitor, maxTime, autoTune and dynamic method switching are only
+ *    supported by main_iter, which then runs a thick restarted GD instead.
+ *
+ ******************************************************************************/
+
+int krylov_schur_applies_zprimme(primme_params *primme) {
+
+   return primme->restartingParams.scheme == primme_krylov_schur
+       && primme->maxBlockSize == 1
+       && !primme->correctionParams.precondition
+       && primme->correctionParams.maxInnerIterations == 0
+       && primme->numEvals < primme->maxBasisSize - 1
+       && primme->monitor == NULL
+       && primme->maxTime <= 0.0L
+       && !primme->autoTune
+       && primme->dynamicMethodSwitch <= 0;
+}
+
+/******************************************************************************
+ * Subroutine krylov_schur - Computes the numEvals target eigenpairs with a
+ *    thick restarted Lanczos method in Krylov-Schur form (G. W. Stewart,
+ *    A Krylov-Schur algorithm for large eigenproblems, SIMAX 23(3), 2001).
+ *
+ *    The basis V of size k always satisfies the Krylov relation
+ *
+ *       A*V(:,1:k) = V(:,1:k)*H + V(:,k+1)*b'
+ *
+ *    where V(:,k+1), the next vector of the basis, is kept in the column
+ *    after the basis. So the residual norm of the Ritz pair (hVals(i),
+ *    V*hVecs(:,i)) is |beta*hVecs(k,i)|, with beta the norm of the component
+ *    of A*V(:,k) orthogonal to V(:,1:k), and no residual vector is computed
+ *    during the iteration. At restart V(:,1:k) is replaced by the restartSize
+ *    target Ritz vectors (restart_X), and V(:,k+1) becomes the next vector,
+ *    which keeps the relation with H diagonal and b = beta*hVecs(k,1:l).
+ *    The new row and column of H are computed as V'*A*v by
+ *    update_projection, so H holds b without storing it apart.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * machEps  machine precision 
+ *
+ * intWork  Integer workspace
+ *
+ * realWork Real workspace, laid out as in main_iter
+ *
+ * OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------
+ * evals    The approximations to the numEvals target eigenvalues
+ *
+ * perm     The identity, as the pairs are returned sorted
+ *
+ * evecs    After the numOrthoConst constraints, the corresponding Ritz
+ *          vectors. On input, the primme.initSize initial guesses, whose
+ *          sum is the first vector of the basis.
+ *
+ * resNorms The residual norms of the Ritz pairs from the Krylov relation
+ *
+ * Return Value
+ * ------------
+ *  0 - All numEvals pairs converged
+ * -1 - Maximum number of matvecs or outer iterations reached
+ * -3 - Ortho failure
+ * -4 - Failure in solving the eigenproblem of H
+ *
+ ******************************************************************************/
+
+int krylov_schur_zprimme(double *evals, int *perm, Complex_Z *evecs, 
+   double *resNorms, double machEps, int *intWork, void *realWork, 
+   primme_params *primme) {
+
+   int i, j;                /* Loop variables                                */
+   int basisSize;           /* Current size of the basis V                   */
+   int maxSize;             /* Maximum basis size; V holds one more vector   */
+   int restartSize;         /* Number of Ritz vectors kept at restart        */
+   int numConverged;        /* Leading target pairs with small residual      */
+   int numPairs;            /* Ritz pairs returned                           */
+   int rworkSize;           /* Size of rwork array                           */
+   int ret;                 /* Return value                                  */
+   int ONE = 1;             /* To be passed by reference in matrixMatvec     */
+   int *iwork;              /* Integer workspace pointer                     */
+   double beta;             /* Norm of the residual of the Krylov relation   */
+   double largestRitzValue; /* The largest modulus of any Ritz value computed*/
+   double tol;              /* Required tolerance for residual norms         */
+   double tstart;           /* Start time of the restart phase               */
+   Complex_Z *V;            /* Basis vectors and the next vector             */
+   Complex_Z *W;            /* A*V for the last vectors of the basis         */
+   Complex_Z *H;            /* Upper triangular portion of V'*A*V            */
+   Complex_Z *hVecs;        /* Eigenvectors of H                             */
+   double *hVals;           /* Eigenvalues of H                              */
+   Complex_Z *rwork;        /* Real work space                               */
+   Complex_Z tpone = {+1.0e+00,+0.0e00}; /* constant 1.0 of type complex */
+   Complex_Z tzero = {+0.0e+00,+0.0e00}; /* constant 0.0 of type complex */
+
+   /* -------------------------------------------------------------- */
+   /* Subdivide the workspace                                        */
+   /* -------------------------------------------------------------- */
+
+   V         = (Complex_Z *) realWork;
+   W         = V + primme->ldOPs*primme->maxBasisSize;
+   H         = W + primme->ldOPs*primme->maxBasisSize;
+   hVecs     = H + primme->maxBasisSize*primme->maxBasisSize;
+   hVals     = (double *)(hVecs + primme->maxBasisSize*primme->maxBasisSize);
+   rwork     = (Complex_Z *)(hVals + primme->maxBasisSize);
+   rworkSize = (primme->realWorkSize - ((char*)rwork - (char*)V))
+                  /sizeof(Complex_Z);
+   iwork     = intWork;
+
+   /* -------------------------------------------------------------- */
+   /* Initialize counters and the tolerance for the residual norms   */
+   /* -------------------------------------------------------------- */
+
+   primme_reset_stats(primme);
+   primme_trace_reset(primme);
+
+   largestRitzValue = 0.0L;
+   if (primme->aNorm > 0.0L) {
+      tol = primme->eps*primme->aNorm;
+   }
+   else {
+      tol = primme->eps; /* tol*largestRitzValue will be checked */
+   }
+
+   /* -------------------------------------- */
+   /* Quick return for matrix of dimension 1 */
+   /* -------------------------------------- */
+
+   if (primme->n == 1) {
+      evecs[0] = tpone;
+      primme_matvec(&evecs[0], &primme->nLocal, W, &primme->ldOPs,
+         &ONE, primme);
+      evals[0] = W[0].r;
+      perm[0] = 0;
+      resNorms[0] = 0.0L;
+      primme->stats.numMatvecs++;
+      return 0;
+   }
+
+   /* ------------------------------------------------------------ */
+   /* The first vector is the sum of the initial guesses; without  */
+   /* them it is zero, and ortho replaces it by a random vector    */
+   /* ------------------------------------------------------------ */
+
+   for (i=0; i < primme->nLocal; i++) {
+      V[i] = tzero;
+   }
+   for (i=0; i < primme->initSize; i++) {
+      Num_axpy_zprimme(primme->nLocal, tpone,
+         &evecs[primme->nLocal*(primme->numOrthoConst+i)], 1, V, 1);
+   }
+
+   ret = ortho_zprimme(V, primme->ldOPs, 0, 0, evecs, primme->nLocal,
+      primme->numOrthoConst, primme->nLocal, primme->iseed, machEps, rwork,
+      rworkSize, primme);
+
+   if (ret < 0) {
+      primme_PushErrorMessage(Primme_main_iter, Primme_ortho, ret,
+                      __FILE__, __LINE__, primme);
+      return ORTHO_FAILURE;
+   }
+
+   maxSize = min(primme->maxBasisSize - 1, 
+                 primme->n - primme->numOrthoConst);
+   basisSize = 0;
+   numConverged = 0;
+
+   /* ---------------------------------------------------------------- */
+   /* Expand the basis up to maxSize and restart, until the numEvals   */
+   /* target pairs converge or a limit is reached                      */
+   /* ---------------------------------------------------------------- */
+
+   while (1) {
+
+      while (basisSize < maxSize && numConverged < primme->numEvals &&
+             ( primme->maxMatvecs == 0 || 
+               primme->stats.numMatvecs < primme->maxMatvecs ) &&
+             ( primme->maxOuterIterations == 0 ||
+               primme->stats.numOuterIterations < primme->maxOuterIterations)){
+
+         primme->stats.numOuterIterations++;
+
+         /* Add the next vector to the basis and the column V'*A*v to H */
+
+         update_W_zprimme(V, W, basisSize, 1, primme);
+         update_projection_zprimme(V, primme->ldOPs, W, primme->ldOPs, H,
+            basisSize, primme->maxBasisSize, 1, rwork, primme);
+         basisSize++;
+
+         /* Orthogonalize A*v against V to get the next vector. As it is */
+         /* the normalized residual f/beta, beta = V(:,k+1)'*A*v         */
+
+         if (basisSize < primme->n - primme->numOrthoConst) {
+            Num_zcopy_zprimme(primme->nLocal, &W[primme->ldOPs*(basisSize-1)],
+               1, &V[primme->ldOPs*basisSize], 1);
+            ret = ortho_zprimme(V, primme->ldOPs, basisSize, basisSize, 
+               evecs, primme->nLocal, primme->numOrthoConst, primme->nLocal,
+               primme->iseed, machEps, rwork, rworkSize, primme);
+
+            if (ret < 0) {
+               primme_PushErrorMessage(Primme_main_iter, Primme_ortho, ret,
+                               __FILE__, __LINE__, primme);
+               return ORTHO_FAILURE;
+            }
+
+            beta = next_vector_coefficient(&V[primme->ldOPs*basisSize], 
+               &W[primme->ldOPs*(basisSize-1)], primme);
+         }
+         else {
+            /* V spans the whole space, so the relation has no residual */
+            beta = 0.0L;
+         }
+
+         ret = solve_H_zprimme(H, hVecs, hVals, basisSize, 
+            primme->maxBasisSize, &largestRitzValue, 0, rworkSize, rwork,
+            iwork, primme);
+
+         if (ret != 0) {
+            primme_PushErrorMessage(Primme_main_iter, Primme_solve_h, ret,
+                            __FILE__, __LINE__, primme);
+            return SOLVE_H_FAILURE;
+         }
+
+         numConverged = krylov_resnorms(hVecs, hVals, basisSize, beta, tol,
+            largestRitzValue, resNorms, primme);
+      }
+
+      if (numConverged >= primme->numEvals || basisSize < maxSize) break;
+
+      /* Do not restart if a limit was reached as the basis filled, or */
+      /* the pairs returned would mix the new V with the old hVecs     */
+
+      if ((primme->maxMatvecs > 0 &&
+               primme->stats.numMatvecs >= primme->maxMatvecs) ||
+          (primme->maxOuterIterations > 0 &&
+               primme->stats.numOuterIterations >= primme->maxOuterIterations))
+         break;
+
+      /* ------------------------------------------------------------- */
+      /* Restart with the restartSize target Ritz vectors followed by  */
+      /* the next vector. H becomes the diagonal of their Ritz values  */
+      /* ------------------------------------------------------------- */
+
+      tstart = primme_phase_begin(primme_phase_restart, primme);
+
+      restartSize = max(primme->minRestartSize, primme->numEvals);
+      restartSize = min(restartSize, basisSize-1);
+
+      restart_X_zprimme(V, primme->ldOPs, hVecs, primme->nLocal, basisSize,
+         restartSize, rwork, rworkSize, primme);
+      Num_zcopy_zprimme(primme->nLocal, &V[primme->ldOPs*basisSize], 1,
+         &V[primme->ldOPs*restartSize], 1);
+
+      for (j=0; j < restartSize; j++) {
+         for (i=0; i < j; i++) {
+            H[primme->maxBasisSize*j+i] = tzero;
+         }
+         H[primme->maxBasisSize*j+j].r = hVals[j];
+         H[primme->maxBasisSize*j+j].i = 0.0L;
+      }
+      basisSize = restartSize;
+
+      primme_phase_end(primme_phase_restart, tstart, primme);
+
+      primme->stats.meanRestartSize = (primme->stats.meanRestartSize*
+         primme->stats.numRestarts + basisSize)/(primme->stats.numRestarts+1);
+      primme->stats.numRestarts++;
+      if (primme->trace) {
+         primme_trace_record(primme_get_wtime(), primme_event_restart,
+            primme_phase_restart, 0, basisSize, 0.0L, primme);
+      }
+   }
+
+   /* ------------------------------------------------------------- */
+   /* Return the target Ritz pairs, sorted, and the number of them  */
+   /* that converged                                                */
+   /* ------------------------------------------------------------- */
+
+   numPairs = min(primme->numEvals, basisSize);
+   Num_gemm_zprimme("N", "N", primme->nLocal, numPairs, basisSize, tpone,
+      V, primme->ldOPs, hVecs, basisSize, tzero,
+      &evecs[primme->nLocal*primme->numOrthoConst], primme->nLocal);
+
+   for (i=0; i < primme->numEvals; i++) {
+      if (i < numPairs) evals[i] = hVals[i];
+      perm[i] = i;
+   }
+   primme->initSize = numConverged;
+
+   if (primme->aNorm <= 0.0L) primme->aNorm = largestRitzValue;
+
+   return numConverged >= primme->numEvals ? 0 : MAX_ITERATIONS_REACHED;
+}
+
+/******************************************************************************
+ * Function next_vector_coefficient - Returns v'*w, the coefficient of the
+ *    next vector v in the product w = A*V(:,k), which is the norm of the
+ *    component of w orthogonal to V(:,1:k).
+ *
+ ******************************************************************************/
+
+static double next_vector_coefficient(Complex_Z *v, Complex_Z *w, 
+   primme_params *primme) {
+
+   double beta, beta_local;
+   int ONE = 1;
+
+   /* v'*w is real up to rounding errors */
+   beta_local = Num_dot_zprimme(primme->nLocal, v, 1, w, 1).r;
+   primme_globalSum(&beta_local, &beta, &ONE, primme);
+
+   return beta;
+}
+
+/******************************************************************************
+ * Function krylov_resnorms - Sets resNorms(i) = |beta*hVecs(k,i)|, the
+ *    residual norm of the i-th Ritz pair, for the target pairs available
+ *    in a basis of size k, and returns how many leading pairs have
+ *    residual norms below tol (times largestRitzValue if primme.aNorm is
+ *    not given).
+ *
+ ******************************************************************************/
+
+static int krylov_resnorms(Complex_Z *hVecs, double *hVals, int basisSize,
+   double beta, double tol, double largestRitzValue, double *resNorms, 
+   primme_params *primme) {
+
+   int i, numPairs, numConverged;
+   double t;
+
+   if (primme->aNorm <= 0.0L) tol = tol*largestRitzValue;
+
+   numPairs = min(primme->numEvals, basisSize);
+   numConverged = 0;
+   for (i=0; i < numPairs; i++) {
+      resNorms[i] = fabs(beta)*z_abs_primme(hVecs[basisSize*i+basisSize-1]);
+      if (resNorms[i] < tol && numConverged == i) numConverged++;
+   }
+
+   if (primme->trace) {
+      t = primme_get_wtime();
+      for (i=0; i < numPairs; i++) {
+         primme_trace_record(t, primme_event_ritz, primme_phase_convergence,
+            i, hVals[i], resNorms[i], primme);
+      }
+   }
+
+   if (primme->printLevel >= 3 && primme->procID == 0) {
+      for (i=0; i < numPairs; i++) {
+         fprintf(primme->outputFile, 
+            "OUT %d conv %d blk %d MV %d Sec %E EV %13E |r| %.3E\n",
+         primme->stats.numOuterIterations, numConverged, i,
+         primme->stats.numMatvecs, primme_wTimer_r(&primme->timerStart, 0),
+         hVals[i], resNorms[i]);
+      }
+      fflush(primme->outputFile);
+   }
+
+   return numConverged;
+}
@@ -42,6 +42,7 @@
 #include "factorize_z.h"
 #include "numerical_z.h"
 #include <assert.h>
+#include "primme_stats.h"
 
 /******************************************************************************
  * Function lock_vectors - This subroutine locks converged Ritz pairs.  The
@@ -161,6 +162,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
    int *flag, Complex_Z *rwork, int rworkSize, int *iwork, 
    int *LockingProblem, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_locking, primme);
    int i;             /* Loop counter                                       */
    int numCandidates; /* Number of targeted Ritz vectors converged before   */
                       /* restart.                                           */
@@ -190,7 +192,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
 
    if (*basisSize < primme->maxBasisSize) {
       /* compute residuals in the next open slot of W */
-      residual = &W[*basisSize*primme->nLocal];
+      residual = &W[*basisSize*primme->ldOPs];
       workinW = 0;
    }
    else {
@@ -202,7 +204,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
        * been used to compute residual(LAST) -the while loop starts from LAST.
        * After all lockings, if the LAST evec was not locked, we must  
        * recompute W[LAST]=Av. This matvec event is extremely infrequent */
-      residual = &W[(*basisSize-1)*primme->nLocal];
+      residual = &W[(*basisSize-1)*primme->ldOPs];
       workinW = 1;
    }
 
@@ -227,6 +229,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
    numCandidates = *basisSize - i - 1;
 
    if (numCandidates == 0) {
+      primme_phase_end(primme_phase_locking, tstart, primme);
       return 0;
    }
 
@@ -239,15 +242,15 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
 
    for (i = *basisSize-1, candidate = numCandidates-1;  
       i >= *basisSize-numCandidates; i--, candidate--) {
-      Num_zcopy_zprimme(primme->nLocal, &W[primme->nLocal*i], 1, residual, 1);
+      Num_zcopy_zprimme(primme->nLocal, &W[primme->ldOPs*i], 1, residual, 1);
       {ztmp.r = -hVals[i]; ztmp.i = 0.0L;}
-      Num_axpy_zprimme(primme->nLocal, ztmp, &V[primme->nLocal*i],1,residual,1);
+      Num_axpy_zprimme(primme->nLocal, ztmp, &V[primme->ldOPs*i],1,residual,1);
       ztmp = Num_dot_zprimme(primme->nLocal, residual, 1, residual, 1);
       tnorms[candidate] = ztmp.r;
    }
 
    /* Global sum the dot products */
-   (*primme->globalSumDouble)(tnorms, norms, &numCandidates, primme); 
+   primme_globalSum(tnorms, norms, &numCandidates, primme); 
 
    numRecentlyLocked = 0;
 
@@ -289,7 +292,8 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
             fprintf(primme->outputFile, 
             "Lock epair[ %d ]= %e norm %.4e Mvecs %d Time %.4e Flag %d\n",
                   *numLocked+1, hVals[i], norms[candidate], 
-                   primme->stats.numMatvecs,primme_wTimer(0),flag[i]);
+                   primme->stats.numMatvecs,
+                   primme_wTimer_r(&primme->timerStart, 0),flag[i]);
             fflush(primme->outputFile);
          }
 
@@ -297,7 +301,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
          /* insert the converged Ritz value in sorted order within */
          /* the evals array.                                       */
 
-         Num_zcopy_zprimme(primme->nLocal, &V[primme->nLocal*i], 1, 
+         Num_zcopy_zprimme(primme->nLocal, &V[primme->ldOPs*i], 1, 
             &evecs[primme->nLocal*(primme->numOrthoConst + *numLocked)], 1);
          insertionSort(hVals[i], evals, norms[candidate], resNorms, perm, 
             *numLocked, primme);
@@ -308,7 +312,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
 
          if (*numGuesses > 0) {
             Num_zcopy_zprimme(primme->nLocal, 
-               &evecs[primme->nLocal*(*nextGuess)], 1, &V[primme->nLocal*i], 1);
+               &evecs[primme->nLocal*(*nextGuess)], 1, &V[primme->ldOPs*i], 1);
             flag[i] = INITIAL_GUESS;
             *numGuesses = *numGuesses - 1;
             *nextGuess = *nextGuess + 1;
@@ -340,6 +344,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
    /* -------------------------------------------------------------------- */
 
    if (*numLocked >= primme->numEvals) {
+      primme_phase_end(primme_phase_locking, tstart, primme);
       return 0;
    }
    else if (UDU != NULL) {
@@ -347,8 +352,8 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
       /* Compute K^{-1}x for all newly locked eigenvectors */
 
       newStart = primme->nLocal*(evecsSize - numRecentlyLocked);
-      (*primme->applyPreconditioner)( &evecs[newStart], &evecsHat[newStart], 
-                                    &numRecentlyLocked, primme);
+      primme_precond(&evecs[newStart], &primme->nLocal,
+         &evecsHat[newStart], &primme->nLocal, &numRecentlyLocked, primme);
       primme->stats.numPreconds += numRecentlyLocked;
 
       /* Update the projection evecs'*evecsHat now that evecs and evecsHat   */
@@ -356,9 +361,10 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
       /* workspace is numLocked*numEvals.  The most ever needed would be     */
       /* maxBasisSize*numEvals.                                              */
 
-      update_projection_zprimme(evecs, evecsHat, M, 
-         evecsSize-numRecentlyLocked, primme->numOrthoConst+primme->numEvals, 
-         numRecentlyLocked, rwork, primme);
+      update_projection_zprimme(evecs, primme->nLocal, evecsHat,
+         primme->nLocal, M, evecsSize-numRecentlyLocked,
+         primme->numOrthoConst+primme->numEvals, numRecentlyLocked, rwork,
+         primme);
 
       ret = UDUDecompose_zprimme(M, UDU, ipivot, evecsSize, rwork, 
          rworkSize, primme);
@@ -400,7 +406,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
    /* ---------------------------------------------------------------------- */
 
    if (numReplaced > 0) {
-      ret = ortho_zprimme(V, primme->nLocal, *basisSize, 
+      ret = ortho_zprimme(V, primme->ldOPs, *basisSize, 
          *basisSize+numReplaced-1, evecs, primme->nLocal, evecsSize, 
          primme->nLocal, primme->iseed, machEps, rwork, rworkSize, primme);
 
@@ -426,8 +432,8 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
    /* ---------------------------------------------------------------- */
 
    if (numNewVectors > 0) {
-      update_projection_zprimme(V, W, H, *basisSize, primme->maxBasisSize, 
-         numNewVectors, hVecs, primme);
+      update_projection_zprimme(V, primme->ldOPs, W, primme->ldOPs, H,
+         *basisSize, primme->maxBasisSize, numNewVectors, hVecs, primme);
       *basisSize = *basisSize + numNewVectors;
    }
 
@@ -459,6 +465,7 @@ int lock_vectors_zprimme(double tol, double *aNormEstimate, double *maxConvTol,
          prevRitzVals[i] = prevRitzVals[i+numRecentlyLocked];
    }
 
+   primme_phase_end(primme_phase_locking, tstart, primme);
    return 0;
 }
  
@@ -646,10 +653,10 @@ static int swap_flagVecs_toEnd(int basisSize, int flagValue, Complex_Z *V,
 
       /* Swap the two columns of V and W */
 
-      Num_swap_zprimme(primme->nLocal, &V[primme->nLocal*left], 1, 
-                                       &V[primme->nLocal*right], 1);
-      Num_swap_zprimme(primme->nLocal, &W[primme->nLocal*left], 1, 
-                                       &W[primme->nLocal*right], 1);
+      Num_swap_zprimme(primme->nLocal, &V[primme->ldOPs*left], 1, 
+                                       &V[primme->ldOPs*right], 1);
+      Num_swap_zprimme(primme->nLocal, &W[primme->ldOPs*left], 1, 
+                                       &W[primme->ldOPs*right], 1);
 
       /* Swap Ritz values */
 
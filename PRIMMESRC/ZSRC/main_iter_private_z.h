@@ -39,12 +39,18 @@
 #define RESTART_FAILURE           -6
 #define LOCK_VECTORS_FAILURE      -7
 
+/* Return codes when the solver stops before convergence */
+
+#define MONITOR_STOP               2
+#define DEADLINE_STOP              3
+
 static void adjust_blockSize(int *iev, int *flag, int *blockSize, 
    int maxBlockSize, int *ievMax, int basisSize, int maxBasisSize, 
    int numLocked, int numConverged, int numWantedEvs, int matrixDimension);
 
 static int retain_previous_coefficients(Complex_Z *hVecs, Complex_Z *previousHVecs, 
-   int basisSize, int *iev, int blockSize, primme_params *primme);
+   int basisSize, int basisLimit, int numToRetain, int *iev, int blockSize, 
+   primme_params *primme);
 
 void check_reset_flags_zprimme(int *flag, int *numConverged, 
    double *hVals, double *prevRitzVals, int numPrevRitzVals,
@@ -55,6 +61,12 @@ static int verify_norms(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs, double *hV
    int basisSize, double *resNorms, int *flag, double tol, double aNormEstimate,
    void *rwork, int *numConverged, primme_params *primme);
 
+static int deadline_near(double *tLastCheck, primme_params *primme);
+
+static int copy_unconverged_pairs(Complex_Z *V, Complex_Z *W, Complex_Z *hVecs, 
+   double *hVals, int basisSize, int numLocked, Complex_Z *evecs, double *evals,
+   double *resNorms, int *perm, void *rwork, primme_params *primme);
+
 /*----------------------------------------------------------------------------*
  * The following are needed for the Dynamic Method Switching
  *----------------------------------------------------------------------------*/
@@ -97,6 +109,32 @@ typedef struct {
    double resid_0;        /*First residual norm of the convergence of a method*/
                           /*   since last switch or since an epair converged */
 
+   /* Global reductions. A reduction of b bytes is modeled to take        */
+   /* latency + b*invBandwidth, fitted by least squares to the reductions  */
+   /* between updates. QMR steps and GD+k outer steps are modeled as their */
+   /* computation plus the reductions they do at the current latency and   */
+   /* bandwidth, so that the prediction follows the network.               */
+   double latency;        /* Time of a reduction, besides its bytes          */
+   double invBandwidth;   /* Time per byte reduced                           */
+   double net_cc, net_cb, net_bb, net_ct, net_bt; /* Least squares sums      */
+   double qmr_comp;       /* qmr_only without the reductions                 */
+   double qmr_sums;       /* Reductions per QMR step                         */
+   double qmr_bytes;      /* Bytes reduced per QMR step                      */
+   double gdk_comp;       /* gdk_plus_MV without the reductions              */
+   double gdk_sums;       /* Reductions per GD+k outer step                  */
+   double gdk_bytes;      /* Bytes reduced per GD+k outer step               */
+
+   /* Counters since last update. Those in inner are since last update    */
+   /* and in solve_correction, like time_in_inner                         */
+   int numSums_0;         /* stats.numGlobalSumCalls at last update          */
+   long int bytesSums_0;  /* stats.bytesGlobalSum at last update             */
+   double timeSums_0;     /* stats.timeGlobalSum at last update              */
+   double timeMV_0;       /* stats.timeMatvec at last update                 */
+   int numPR_0;           /* stats.numPreconds at last update                */
+   double timePR_0;       /* stats.timePrecond at last update                */
+   double sums_in_inner;  /* Reductions in inner iterations                  */
+   double bytes_in_inner; /* Bytes reduced in inner iterations               */
+
    /* Weighted ratio of expected times, for final method recommendation */
    double accum_jdq_gdk;  /*Expected ratio of accumulative times of JDQMR/GD+k*/
    double accum_jdq;      /* Accumulates jdq_times += ratio*(gdk+MV+PR)       */
@@ -105,6 +143,9 @@ typedef struct {
 } primme_CostModel;
 
 static void initializeModel(primme_CostModel *model, primme_params *primme);
+static void load_model(primme_CostModel *model, primme_cost_model *saved,
+   primme_params *primme);
+static void save_model(primme_CostModel *model, primme_cost_model *saved);
 static void switch_from_JDQMR(primme_CostModel *model, primme_params *primme);
 static void switch_from_GDpk (primme_CostModel *model, primme_params *primme);
 static int update_statistics(primme_CostModel *model, primme_params *primme,
@@ -113,6 +154,95 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
 static double ratio_JDQMR_GDpk(primme_CostModel *CostModel, int numLocked,
    double estimate_slowdown, double estimate_ratio_outer_MV);
 static void update_slowdown(primme_CostModel *model);
+static void update_network(primme_CostModel *model, double sums, double bytes,
+   double time);
+static void apply_network(primme_CostModel *model);
+
+/*----------------------------------------------------------------------------*
+ * The following are needed for the online tuning of the sizes (autoTune)
+ *----------------------------------------------------------------------------*/
+
+#define TUNE_MAX_CLASSES 32
+#define TUNE_MIN_CYCLES  3
+
+typedef struct {
+   /* Sizes in use, within the bounds given by the user */
+   int basisSize;         /* Basis size at which to restart                  */
+   int restartSize;       /* Ritz vectors to restart with                    */
+   int blockSize;         /* Largest block size                              */
+   int minBasisSize;      /* Lower bound of basisSize                        */
+   int minRestartSize;    /* Lower bound of restartSize                      */
+   int userRestartSize;   /* primme->minRestartSize on input                 */
+
+   /* Time per vector of a matvec on blocks of min(2^i,maxBlockSize) vectors,*/
+   /* 0 if not measured yet and -1 if a block of that size was not formed   */
+   double timeMV[TUNE_MAX_CLASSES];
+   int numClasses;        /* Number of block sizes                           */
+   int trying;            /* Block size in use, as the class index           */
+
+   /* Dense work (ortho, update_projection, solve_H, check_convergence) per */
+   /* new vector and basis vector, and restart work per basis vector and    */
+   /* restart vector                                                        */
+   double denseRate;
+   double restartRate;
+   double work;           /* Sum of basisSize*blockSize since last update    */
+   int lastBasisSize;     /* Basis size after the last expansion             */
+   double timeDense_0;    /* Dense work time at last update                  */
+   double timeRestart_0;  /* stats.timeRestart at last update                */
+   double timeMV_0;       /* stats.timeMatvec before the last expansion      */
+
+   /* Convergence rate of the target, log(resid_0/resid) per second and per */
+   /* matvec, to judge whether a smaller basis slows down the convergence.  */
+   /* It is accumulated over windows of TUNE_MIN_CYCLES cycles with the     */
+   /* sizes in use in which no pair converged                               */
+   int floorBasisSize;    /* Lower bound of basisSize that proved worthwhile */
+   int trialBasisSize;    /* Smaller basisSize on trial, 0 if none           */
+   double trialRate;      /* Rate per second measured with trialBasisSize    */
+   double trialRateMV;    /* Rate per matvec measured with trialBasisSize    */
+   int prevBasisSize;     /* basisSize before the trial                      */
+   double prevRate;       /* Rate per second measured before the trial       */
+   double prevRateMV;     /* Rate per matvec measured before the trial       */
+   double resid_0;        /* Residual norm of the target at last restart     */
+   int numConverged_0;    /* numConverged at last restart                    */
+   double time_0;         /* Time at last restart                            */
+   int matvecs_0;         /* stats.numMatvecs at last restart                */
+   double convLog;        /* Sum of log(resid_0/resid) over those cycles     */
+   double convTime;       /* Time of those cycles                            */
+   int convMV;            /* Matvecs of those cycles                         */
+   int convCycles;        /* Number of those cycles                          */
+} primme_TuneModel;
+
+static void initializeTune(primme_TuneModel *tune, primme_params *primme);
+static void tune_matvec(primme_TuneModel *tune, int basisSize, int blockSize,
+   primme_params *primme);
+static void tune_sizes(primme_TuneModel *tune, int restartSize,
+   double resNorm, int numConverged, primme_params *primme);
+static int tune_restartSize(primme_TuneModel *tune, int basisSize, 
+   int blockSize, primme_params *primme);
+static double tune_overhead(primme_TuneModel *tune, int basisSize, 
+   int restartSize);
+
+/*----------------------------------------------------------------------------*
+ * The following are needed for the adaptive restarting policy
+ * (restartingParams.scheme == primme_thick_adaptive)
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+   int prevRetain;        /* Previous vectors to retain, <= maxPrevRetain    */
+   int step;              /* Next change of prevRetain, +1 or -1             */
+   int prevRetain_0;      /* prevRetain when the current cycle started       */
+   double lastRate;       /* Convergence rate measured with the last change  */
+   double resid_0;        /* Residual norm of the target at last restart     */
+   int numConverged_0;    /* numConverged at last restart                    */
+   double time_0;         /* Time at last restart                            */
+   double restartWork;    /* Sum of basisSize*(restartSize+numPrevRetained)  */
+} primme_RestartModel;
+
+static void initializeRestartModel(primme_RestartModel *model, 
+   primme_params *primme);
+static int adapt_restart(primme_RestartModel *model, double *hVals, 
+   int *iev, int basisSize, int numConverged, double resNorm, 
+   primme_TuneModel *tune, primme_params *primme);
 
 #if 0
 static void displayModel(primme_CostModel *model);
@@ -45,6 +45,24 @@ void Num_zcopy_zprimme(int n, Complex_Z *x, int incx, Complex_Z *y, int incy) {
    ZCOPY(&ln, x, &lincx, y, &lincy);
 }
 /******************************************************************************/
+/* Copy the m x n matrix x with leading dimension ldx into y with leading     */
+/* dimension ldy. Used to move blocks of vectors between V (ldOPs) and evecs  */
+/* (nLocal).                                                                  */
+
+void Num_copy_matrix_zprimme(Complex_Z *x, int m, int n, int ldx, Complex_Z *y, int ldy) {
+
+   int i;
+
+   if (ldx == m && ldy == m) {
+      Num_zcopy_zprimme(m*n, x, 1, y, 1);
+   }
+   else {
+      for (i=0; i<n; i++) {
+         Num_zcopy_zprimme(m, &x[ldx*i], 1, &y[ldy*i], 1);
+      }
+   }
+}
+/******************************************************************************/
 
 void Num_gemm_zprimme(const char *transa, const char *transb, int m, int n, int k, 
    Complex_Z alpha, Complex_Z *a, int lda, Complex_Z *b, int ldb, 
@@ -55,6 +55,7 @@
 #include "primme.h"         
 #include "numerical_z.h"
 #include "ortho_z.h"
+#include "primme_stats.h"
  
 
 /**********************************************************************
@@ -104,7 +105,8 @@
 int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2, 
    Complex_Z *locked, int ldLocked, int numLocked, int nLocal, int *iseed, 
    double machEps, Complex_Z *rwork, int rworkSize, primme_params *primme) {
-              
+
+   double tstart;           /* Start time of the phase */
    int i;                   /* Loop indices */
    int count;
    int returnValue;
@@ -149,6 +151,8 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
    if (rworkSize < minWorkSize) {
       return(minWorkSize);
    }
+
+   tstart = primme_phase_begin(primme_phase_ortho, primme);
    
    tol = sqrt(2.0L)/2.0L;
 
@@ -174,6 +178,7 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
 
             Num_larnv_zprimme(2, iseed, nLocal, &basis[ldBasis*i]); 
             randomizations++;
+            primme->stats.numRandomizations++;
             nOrth = 0;
          }
 
@@ -198,7 +203,7 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
          overlaps = &rwork[i+numLocked+1];
          /* In Complex, the size of the array to globalSum is twice as large */
          count = 2*(i + numLocked + 1);
-         (*primme->globalSumDouble)(rwork, overlaps, &count, primme);
+         primme_globalSum(rwork, overlaps, &count, primme);
 
          if (numLocked > 0) { /* locked array most recently accessed */
             Num_gemv_zprimme("N", nLocal, numLocked, tmone, locked, ldLocked, 
@@ -229,7 +234,7 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
                                            &basis[ldBasis*i], 1);
             temp = ztmp.r;
             count = 1;
-            (*primme->globalSumDouble)(&temp, &s1, &count, primme);
+            primme_globalSum(&temp, &s1, &count, primme);
             s1 = sqrt(s1);
          }
 
@@ -245,6 +250,7 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
                fprintf(outputFile, "Reorthogonalizing: %d\n", i-b1);
             }
             /* No numerical benefit in normalizing the vector before reortho */
+            primme->stats.numReorthos++;
             s0 = s1;
             s02 = s1*s1;
          }
@@ -257,6 +263,7 @@ int ortho_zprimme(Complex_Z *basis, int ldBasis, int b1, int b2,
       }
    }
          
+   primme_phase_end(primme_phase_ortho, tstart, primme);
    return 0;
 }
 
@@ -33,6 +33,9 @@
 #define MALLOC_FAILURE             -2
 #define MAIN_ITER_FAILURE          -3
 
+static int padded_leading_dimension(int nLocal);
+static void first_touch_workspace(primme_params *primme);
+static long int remote_pages_workspace(primme_params *primme);
 static int allocate_workspace(primme_params *primme, int allocate);
 static int check_input(double *evals, Complex_Z *evecs, double *resNorms,
                        primme_params *primme);
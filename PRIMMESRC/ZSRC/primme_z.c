@@ -52,7 +52,9 @@
 #include "primme.h"
 #include "const.h"
 #include "wtime.h"
+#include "primme_memory.h"
 #include "main_iter_z.h"
+#include "krylov_schur_z.h"
 #include "ortho_z.h"
 #include "solve_H_z.h"
 #include "correction_z.h"
@@ -87,10 +89,14 @@
  * ------------
  *  0 - Success
  *  1 - Reporting only memory space required
+ *  2 - Stopped by primme.monitor. The first primme.initSize pairs are
+ *      the locked pairs and the current approximations; the rest are
+ *      undefined
+ *  3 - Stopped before exceeding primme.maxTime. Returns as above
  * -1 - Failure to allocate workspace
  * -2 - Malloc failure in allocating a permutation integer array
  * -3 - main_iter encountered a problem
- * -4 ...-32 - Invalid input (parameters or primme struct) returned 
+ * -4 ...-34 - Invalid input (parameters or primme struct) returned 
  *             by check_input()
  *
  ******************************************************************************/
@@ -101,11 +107,16 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    int ret;
    int *perm;
    double machEps;
+   long int pageFaults;   /* page faults of the process before the solve */
+   long int storageBytes; /* storage traffic of the process before the solve */
+   int ldOPs;             /* ldOPs as set by the user; 0 selects the default */
 
    /* ------------------ */
    /* zero out the timer */
    /* ------------------ */
-   primme_wTimer(1);
+   primme_wTimer_r(&primme->timerStart, 1);
+   pageFaults = primme_page_faults();
+   storageBytes = primme_storage_bytes();
 
    /* ---------------------------- */
    /* Clear previous error reports */
@@ -127,6 +138,23 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
          primme->globalSumDouble = primme_seq_globalSumDouble;
    }
 
+   /* ----------------------------------------- */
+   /* Use the default allocator if none is set  */
+   /* ----------------------------------------- */
+   if (primme->allocWork == NULL) 
+      primme->allocWork = primme_default_allocWork;
+   if (primme->freeWork == NULL) 
+      primme->freeWork = primme_default_freeWork;
+
+   /* ------------------------------------------------------------------ */
+   /* By default V and W are stored with a padded leading dimension      */
+   /* during the call; the value set by the user is restored on return   */
+   /* ------------------------------------------------------------------ */
+   ldOPs = primme->ldOPs;
+   if (primme->ldOPs == 0) {
+      primme->ldOPs = padded_leading_dimension(primme->nLocal);
+   }
+
    /* --------------------------------------------------------------------- */
    /* Decide on whether to use locking (hard locking), or not (soft locking)*/
    /* --------------------------------------------------------------------- */
@@ -145,8 +173,11 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    /* -------------------------------------------------------------- */
    /* If needed, we are ready to estimate required memory and return */
    /* -------------------------------------------------------------- */
-   if (evals == NULL && evecs == NULL && resNorms == NULL)
-       return allocate_workspace(primme, FALSE);
+   if (evals == NULL && evecs == NULL && resNorms == NULL) {
+      ret = allocate_workspace(primme, FALSE);
+      primme->ldOPs = ldOPs;
+      return ret;
+   }
 
    /* ----------------------------------------------------- */
    /* Reset random number seed if inappropriate for DLARENV */
@@ -171,7 +202,8 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    if (ret != 0) {
       primme_PushErrorMessage(Primme_zprimme, Primme_check_input, ret,
                       __FILE__, __LINE__, primme);
-      primme->stats.elapsedTime = primme_wTimer(0);
+      primme->stats.elapsedTime = primme_wTimer_r(&primme->timerStart, 0);
+      primme->ldOPs = ldOPs;
       return ret;
    }
    
@@ -184,7 +216,8 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    if (ret != 0) {
       primme_PushErrorMessage(Primme_zprimme, Primme_allocate_workspace, ret,
                       __FILE__, __LINE__, primme);
-      primme->stats.elapsedTime = primme_wTimer(0);
+      primme->stats.elapsedTime = primme_wTimer_r(&primme->timerStart, 0);
+      primme->ldOPs = ldOPs;
       return ALLOCATE_WORKSPACE_FAILURE;
    }
 
@@ -196,7 +229,8 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    if (perm == NULL) {
       primme_PushErrorMessage(Primme_zprimme, Primme_malloc, 0, 
                       __FILE__, __LINE__, primme);
-      primme->stats.elapsedTime = primme_wTimer(0);
+      primme->stats.elapsedTime = primme_wTimer_r(&primme->timerStart, 0);
+      primme->ldOPs = ldOPs;
       return MALLOC_FAILURE;
    }
 
@@ -204,13 +238,31 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
    /* Call the solver                                                      */
    /*----------------------------------------------------------------------*/
 
-   ret = main_iter_zprimme(evals, perm, evecs, resNorms, machEps, 
+   if (krylov_schur_applies_zprimme(primme)) {
+      ret = krylov_schur_zprimme(evals, perm, evecs, resNorms, machEps, 
                    primme->intWork, primme->realWork, primme);
+   }
+   else {
+      ret = main_iter_zprimme(evals, perm, evecs, resNorms, machEps, 
+                      primme->intWork, primme->realWork, primme);
+   }
+
+   /* Asking the kernel for the node of every page costs a system call */
+   /* per basis vector, so count them only if numTouchParts is set     */
+   primme->stats.numRemotePages = primme->numTouchParts > 0 ?
+      remote_pages_workspace(primme) : -1;
+   if (pageFaults >= 0) {
+      primme->stats.numPageFaults = primme_page_faults() - pageFaults;
+   }
+   if (storageBytes >= 0) {
+      primme->stats.bytesStreamed = primme_storage_bytes() - storageBytes;
+   }
 
    if (ret < 0) {
       primme_PushErrorMessage(Primme_zprimme, Primme_main_iter, 
                       ret, __FILE__, __LINE__, primme);
-      primme->stats.elapsedTime = primme_wTimer(0);
+      primme->stats.elapsedTime = primme_wTimer_r(&primme->timerStart, 0);
+      primme->ldOPs = ldOPs;
       return MAIN_ITER_FAILURE;
    }
    /*----------------------------------------------------------------------*/
@@ -226,8 +278,111 @@ int zprimme(double *evals, Complex_Z *evecs, double *resNorms,
 
    free(perm);
 
-   primme->stats.elapsedTime = primme_wTimer(0);
-   return(0);
+   primme->stats.elapsedTime = primme_wTimer_r(&primme->timerStart, 0);
+   primme->ldOPs = ldOPs;
+   return(ret);
+}
+
+
+/******************************************************************************
+ * Function padded_leading_dimension - Returns the default leading dimension
+ *    of V and W. nLocal is rounded up to a whole number of cache lines, so
+ *    that every column starts aligned, and one more cache line is added if
+ *    the column stride is a multiple of ALIASING_STRIDE_BYTES. Otherwise, for
+ *    nLocal a large power of two, consecutive columns map onto the same
+ *    cache sets and the tall skinny products with V and W thrash the cache.
+ *
+ * Input: 
+ *   nLocal    Number of local rows of V and W
+ *
+ * Return value
+ * ------------
+ *   The leading dimension, at least nLocal
+ ******************************************************************************/
+
+static int padded_leading_dimension(int nLocal) {
+
+   int ld;
+   int lineSize = CACHE_LINE_BYTES/sizeof(Complex_Z);
+
+   ld = ((nLocal + lineSize - 1)/lineSize)*lineSize;
+   if ((ld*sizeof(Complex_Z)) % ALIASING_STRIDE_BYTES == 0) {
+      ld += lineSize;
+   }
+
+   return ld;
+}
+
+
+/******************************************************************************
+ * Function first_touch_workspace - Zeroes the columns of V and W at the
+ *    beginning of realWork, so that their pages are placed by first touch.
+ *    If primme.numTouchParts is set, the rows touchRowStarts[p] to 
+ *    touchRowStarts[p+1]-1 of every column are touched by the OpenMP thread p
+ *    (when compiled with OpenMP), so on NUMA systems they reside on the node
+ *    of the thread that later applies the operators on those rows. The rows
+ *    of padding go with the last part.
+ *
+ ******************************************************************************/
+
+static void first_touch_workspace(primme_params *primme) {
+
+   int p, i, j, numParts, first, last;
+   Complex_Z *V = (Complex_Z *) primme->realWork;
+   Complex_Z tzero = {+0.0e+00,+0.0e00};
+
+   numParts = primme->numTouchParts > 0 ? primme->numTouchParts : 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) num_threads(numParts) private(i,j,first,last)
+#endif
+   for (p = 0; p < numParts; p++) {
+      first = primme->numTouchParts > 0 ? primme->touchRowStarts[p] : 0;
+      last = p == numParts-1 ? primme->ldOPs : primme->touchRowStarts[p+1];
+      for (j = 0; j < 2*primme->maxBasisSize; j++) {
+         for (i = first; i < last; i++) {
+            V[primme->ldOPs*j+i] = tzero;
+         }
+      }
+   }
+}
+
+
+/******************************************************************************
+ * Function remote_pages_workspace - Returns how many pages of V and W are
+ *    not on the NUMA node of the thread that owns their rows, following the
+ *    same partition as first_touch_workspace, or -1 if that is unknown.
+ *    Only called when numTouchParts > 0.
+ *
+ ******************************************************************************/
+
+static long int remote_pages_workspace(primme_params *primme) {
+
+   int p, j, numParts, first, last, node, unknown = 0;
+   long int remote = 0, r;
+   Complex_Z *V = (Complex_Z *) primme->realWork;
+
+   numParts = primme->numTouchParts;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) num_threads(numParts) private(j,first,last,node,r) reduction(+:remote,unknown)
+#endif
+   for (p = 0; p < numParts; p++) {
+      first = primme->touchRowStarts[p];
+      last = p == numParts-1 ? primme->ldOPs : primme->touchRowStarts[p+1];
+      node = primme_numa_node();
+      for (j = 0; j < 2*primme->maxBasisSize && last > first; j++) {
+         r = primme_remote_pages(&V[primme->ldOPs*j+first],
+               (last-first)*sizeof(Complex_Z), node);
+         if (r < 0) {
+            unknown++;
+            break;
+         }
+         remote += r;
+      }
+   }
+
+   return unknown ? -1 : remote;
 }
 
 
@@ -280,8 +435,8 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /* Compute the memory required by the main iteration data structures    */
    /*----------------------------------------------------------------------*/
 
-   dataSize = primme->nLocal*primme->maxBasisSize  /* Size of V            */
-      + primme->nLocal*primme->maxBasisSize        /* Size of W            */
+   dataSize = primme->ldOPs*primme->maxBasisSize   /* Size of V            */
+      + primme->ldOPs*primme->maxBasisSize         /* Size of W            */
       + primme->maxBasisSize*primme->maxBasisSize  /* Size of H            */
       + primme->maxBasisSize*primme->maxBasisSize  /* Size of hVecs        */
       + primme->restartingParams.maxPrevRetain*primme->maxBasisSize;
@@ -306,12 +461,12 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /*----------------------------------------------------------------------*/
 
    if (primme->locking) {
-      orthoSize = ortho_zprimme(NULL, primme->nLocal, primme->maxBasisSize,
+      orthoSize = ortho_zprimme(NULL, primme->ldOPs, primme->maxBasisSize,
          primme->maxBasisSize+primme->maxBlockSize-1, NULL, primme->nLocal, 
          maxEvecsSize, primme->nLocal, NULL, 0.0, NULL, 0, primme);
    }
    else {
-      orthoSize = ortho_zprimme(NULL, primme->nLocal, primme->maxBasisSize,
+      orthoSize = ortho_zprimme(NULL, primme->ldOPs, primme->maxBasisSize,
          primme->maxBasisSize+primme->maxBlockSize-1, NULL, primme->nLocal, 
          primme->numOrthoConst+1, primme->nLocal, NULL, 0.0, NULL, 0, primme);
    }
@@ -407,10 +562,14 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /*----------------------------------------------------------------------*/
    if (primme->realWorkSize < rworkByteSize || primme->realWork == NULL) {
       if (primme->realWork != NULL) {
-         free(primme->realWork);
+         primme->freeWork(primme->realWork, primme);
       }
       primme->realWorkSize = rworkByteSize;
-      primme->realWork = (void *) primme_valloc(rworkByteSize,"Real Alloc");
+      primme->realWork = primme->allocWork(rworkByteSize, primme);
+      /* A file mapping is already zero, and touching it would dirty */
+      /* every page of a basis that is meant not to fit in memory    */
+      if (primme->realWork != NULL && primme->realWork != primme->mappedWork)
+         first_touch_workspace(primme);
       if (primme->printLevel >= 5) fprintf(primme->outputFile, 
          "Allocating real workspace: %ld bytes\n", primme->realWorkSize);
    }
@@ -449,7 +608,7 @@ static int allocate_workspace(primme_params *primme, int allocate) {
  *  primme                   the main structure of parameters 
  *
  * return value -   0    If input parameters in primme are appropriate
- *              -4..-32  Inappropriate input parameters were found
+ *              -4..-34  Inappropriate input parameters were found
  *
  ******************************************************************************/
 static int check_input(double *evals, Complex_Z *evecs, double *resNorms, 
@@ -503,7 +662,9 @@ static int check_input(double *evals, Complex_Z *evecs, double *resNorms,
    else if (primme->restartingParams.maxPrevRetain < 0)
       ret = -20;
    else if (primme->restartingParams.scheme != primme_thick &&
-            primme->restartingParams.scheme != primme_dtr)
+            primme->restartingParams.scheme != primme_dtr &&
+            primme->restartingParams.scheme != primme_thick_adaptive &&
+            primme->restartingParams.scheme != primme_krylov_schur)
       ret = -21;
    else if (primme->initSize < 0) 
       ret = -22;
@@ -532,6 +693,12 @@ static int check_input(double *evals, Complex_Z *evecs, double *resNorms,
       ret = -31;
    else if (resNorms == NULL)
       ret = -32;
+   else if (primme->ldOPs < primme->nLocal)
+      ret = -33;
+   else if (primme->numTouchParts > 0 && (primme->touchRowStarts == NULL
+            || primme->touchRowStarts[0] != 0
+            || primme->touchRowStarts[primme->numTouchParts] != primme->nLocal))
+      ret = -34;
 
    return ret;
   /***************************************************************************/
@@ -35,16 +35,14 @@
 #define UDUDECOMPOSE_FAILURE     -4
 #define PSEUDOLOCK_FAILURE       -5
 
-static void restart_X(Complex_Z *X, Complex_Z *hVecs, int nLocal, 
-   int basisSize, int restartSize, Complex_Z *rwork, int rworkSize);
-
 static int restart_H(Complex_Z *H, Complex_Z *hVecs, double *hVals, 
    int restartSize, int basisSize, Complex_Z *previousHVecs, 
    int numPrevRetained, int indexOfPreviousVecs, int rworkSize, 
    Complex_Z *rwork, primme_params *primme);
 
 static int dtr(int numLocked, Complex_Z *hVecs, double *hVals, int *flags, 
- int basisSize, int numFree, int *iev, Complex_Z *rwork, primme_params *primme);
+ int basisSize, int minRestartSize, int numFree, int *iev, 
+ Complex_Z *rwork, primme_params *primme);
 
 static int pack_converged_coefficients(int *restartSize, int basisSize, 
    int *numPrevRetained, int numLocked, int numGuesses, Complex_Z *hVecs, 
@@ -63,7 +61,7 @@ static int insert_submatrix(Complex_Z *H, double *hVals, Complex_Z *hVecs,
    int indexOfPreviousVecs, int rworkSize, Complex_Z *rwork, 
    primme_params *primme);
 
-static void apply_preconditioner_block(Complex_Z *v, Complex_Z *result,
-   int blockSize, primme_params *primme);
+static void apply_preconditioner_block(Complex_Z *v, int ldv, Complex_Z *result,
+   int ldresult, int blockSize, primme_params *primme);
 
 #endif /* RESTART_PRIVATE_H */
@@ -34,8 +34,17 @@ void reset_flags_zprimme(int *flag, int first, int last);
 int restart_zprimme(Complex_Z *V, Complex_Z *W, Complex_Z *H, Complex_Z *hVecs, 
    double *hVals, int *flags, int *iev, Complex_Z *evecs, Complex_Z *evecsHat, 
    Complex_Z *M, Complex_Z *UDU, int *ipivot, int basisSize, int numConverged, 
-   int *numConvergedStored, int numLocked, int numGuesses, 
+   int *numConvergedStored, int numLocked, int numGuesses, int minRestartSize,
    Complex_Z *previousHVecs, int numPrevRetained, double machEps, 
    Complex_Z *rwork, int rworkSize, primme_params *primme);
 
+int pseudolock_vectors_zprimme(Complex_Z *V, int *flags, Complex_Z *evecs, 
+   Complex_Z *evecsHat, Complex_Z *M, Complex_Z *UDU, int *ipivot, int numConverged,
+   int *numConvergedStored, Complex_Z *rwork, int rworkSize, 
+   primme_params *primme);
+
+void restart_X_zprimme(Complex_Z *X, int ldX, Complex_Z *hVecs, int nLocal, 
+   int basisSize, int restartSize, Complex_Z *rwork, int rworkSize,
+   primme_params *primme);
+
 #endif
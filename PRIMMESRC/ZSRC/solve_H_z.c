@@ -31,6 +31,7 @@
 #include "solve_H_z.h"
 #include "solve_H_private_z.h"
 #include "numerical_z.h"
+#include "primme_stats.h"
 
 /*******************************************************************************
  * Subroutine solve_H - This procedure solves the eigenproblem for the
@@ -64,6 +65,7 @@ int solve_H_zprimme(Complex_Z *H, Complex_Z *hVecs, double *hVals,
    int basisSize, int maxBasisSize, double *largestRitzValue, int numLocked, 
    int lrwork, Complex_Z *rwork, int *iwork, primme_params *primme) {
 
+   double tstart = primme_phase_begin(primme_phase_solve_H, primme);
    int i, j; /* Loop variables    */
    int info; /* dsyev error value */
    int index;
@@ -171,8 +173,10 @@ int solve_H_zprimme(Complex_Z *H, Complex_Z *hVecs, double *hVals,
    /* target:  smallest/Largest or interior closest abs/leq/geq to a shift   */
    /* ---------------------------------------------------------------------- */
 
-   if (primme->target == primme_smallest) 
+   if (primme->target == primme_smallest) {
+      primme_phase_end(primme_phase_solve_H, tstart, primme);
       return 0;
+   }
 
    if (primme->target == primme_largest) {
       for (i = 0; i < basisSize; i++) {
@@ -262,6 +266,7 @@ int solve_H_zprimme(Complex_Z *H, Complex_Z *hVecs, double *hVals,
    }
 
 
+   primme_phase_end(primme_phase_solve_H, tstart, primme);
    return 0;   
 }
 
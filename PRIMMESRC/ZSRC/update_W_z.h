@@ -32,5 +32,8 @@
 
 void update_W_zprimme(Complex_Z *V, Complex_Z *W, int basisSize, int blockSize,
    primme_params *primme);
+void update_W_begin_zprimme(Complex_Z *V, Complex_Z *W, int basisSize, 
+   int blockSize, void **request, primme_params *primme);
+void update_W_wait_zprimme(void **request, primme_params *primme);
 
 #endif
@@ -0,0 +1,729 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: amg.c
+ * 
+ * Purpose - Smoothed aggregation algebraic multigrid (Vanek, Mandel and
+ *           Brezina, 1996) as preconditioner for the CSR matrices of the
+ *           driver, applied with a V-cycle on blocks of vectors.
+ * 
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "amg.h"
+#include "num.h"
+
+#define AMG_MAX_LEVELS  10     /* levels of the hierarchy                    */
+#define AMG_COARSE_SIZE 100    /* rows below which coarsening stops          */
+#define AMG_DENSE_SIZE  2000   /* largest last level factorized in LU        */
+#define AMG_SWEEPS      2      /* products with A of each smoothing          */
+#define AMG_POWER_STEPS 15     /* steps of the estimation of rho(D^(-1)*A)   */
+#define AMG_CHEB_RATIO  30.0   /* Chebyshev smooths [rho/30, rho]*1.1        */
+
+static double absNum(PRIMME_NUM x);
+static CSRMatrix *newCSRMatrix(int m, int n, int nnz);
+static CSRMatrix *copyCSRMatrix(const CSRMatrix *matrix);
+static void diagonalInverse(const CSRMatrix *A, double *invDiag);
+static double spectralRadius(const CSRMatrix *A, const double *invDiag);
+static int aggregate(const CSRMatrix *A, double strength, char *strong,
+      int *agg);
+static CSRMatrix *prolongator(const CSRMatrix *A, const char *strong,
+      const int *agg, int nc);
+static CSRMatrix *multiply(const CSRMatrix *A, const CSRMatrix *B);
+static CSRMatrix *conjTranspose(const CSRMatrix *A);
+static int luFactor(PRIMME_NUM *a, int n, int *ipiv);
+static void luSolve(const PRIMME_NUM *a, int n, const int *ipiv,
+      PRIMME_NUM *b, int nv);
+static void spmm(const CSRMatrix *A, int nv, const PRIMME_NUM *x,
+      PRIMME_NUM *y);
+static void smooth(const AMGLevel *level, amg_smoother smoother, int nv,
+      const PRIMME_NUM *b, PRIMME_NUM *x, int zeroGuess, PRIMME_NUM *work);
+static void vcycle(const AMGPrec *prec, int l, int nv, PRIMME_NUM **x,
+      PRIMME_NUM **b, PRIMME_NUM **work);
+
+/******************************************************************************
+ * Builds the hierarchy for A - shift*I. The entries A(i,j) with
+ * |A(i,j)|^2 >= strength^2*|A(i,i)*A(j,j)| are the strong connections;
+ * the rows are aggregated through them, the tentative prolongator is
+ * constant on each aggregate, and it is smoothed with a damped Jacobi step
+ * on A with the weak connections lumped into the diagonal. The coarse
+ * operators are R*A*P.
+ *
+******************************************************************************/
+int createAMGPrecNative(const CSRMatrix *matrix, double shift, double strength,
+                        amg_smoother smoother, AMGPrec **prec_) {
+
+   int i, j, l, nc, n, *agg;
+   char *strong;
+   CSRMatrix *A, *AP;
+   AMGLevel *level;
+   AMGPrec *prec;
+
+   if (matrix->m != matrix->n) return -1;
+
+   /* The levels hold both triangles */
+   if (matrix->symmetric) {
+      expandSymCSRMatrix(matrix, &A);
+   }
+   else {
+      A = copyCSRMatrix(matrix);
+   }
+   if (shift != 0.0) shiftCSRMatrix(-shift, A);
+
+   prec = (AMGPrec *)primme_calloc(1, sizeof(AMGPrec), "AMGPrec");
+   prec->levels = (AMGLevel *)primme_calloc(AMG_MAX_LEVELS, sizeof(AMGLevel),
+         "levels");
+   prec->smoother = smoother;
+
+   for (l=0; ; l++) {
+      level = &prec->levels[l];
+      n = A->m;
+      level->A = A;
+      level->invDiag = (double *)primme_calloc(n, sizeof(double), "invDiag");
+      diagonalInverse(A, level->invDiag);
+      level->rho = spectralRadius(A, level->invDiag);
+
+      if (n <= AMG_COARSE_SIZE || l == AMG_MAX_LEVELS-1) break;
+
+      strong = (char *)primme_calloc(A->nnz, sizeof(char), "strong");
+      agg = (int *)primme_calloc(n, sizeof(int), "agg");
+      nc = aggregate(A, strength, strong, agg);
+
+      /* Stop if the coarsening stalls */
+      if (nc == 0 || nc > n - n/10) {
+         free(strong);
+         free(agg);
+         break;
+      }
+
+      level->P = prolongator(A, strong, agg, nc);
+      level->R = conjTranspose(level->P);
+      free(strong);
+      free(agg);
+
+      AP = multiply(A, level->P);
+      A = multiply(level->R, AP);
+      destroyCSRMatrix(AP);
+   }
+   prec->numLevels = l+1;
+
+   /* Factorize the last level if it is small */
+   A = prec->levels[l].A;
+   n = A->m;
+   if (n <= AMG_DENSE_SIZE) {
+      prec->LU = (PRIMME_NUM *)primme_calloc((size_t)n*n, sizeof(PRIMME_NUM),
+            "LU");
+      prec->ipiv = (int *)primme_calloc(n, sizeof(int), "ipiv");
+      for (i=0; i<n; i++) {
+         for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+            prec->LU[(size_t)n*(A->JA[j]-1)+i] += A->AElts[j];
+         }
+      }
+      if (luFactor(prec->LU, n, prec->ipiv) != 0) {
+         free(prec->LU);
+         free(prec->ipiv);
+         prec->LU = NULL;
+         prec->ipiv = NULL;
+      }
+   }
+
+   *prec_ = prec;
+   return 0;
+}
+
+void destroyAMGPrecNative(AMGPrec *prec) {
+
+   int l;
+
+   for (l=0; l<prec->numLevels; l++) {
+      destroyCSRMatrix(prec->levels[l].A);
+      if (prec->levels[l].P) destroyCSRMatrix(prec->levels[l].P);
+      if (prec->levels[l].R) destroyCSRMatrix(prec->levels[l].R);
+      free(prec->levels[l].invDiag);
+   }
+   free(prec->levels);
+   free(prec->LU);
+   free(prec->ipiv);
+   free(prec);
+}
+
+/******************************************************************************
+ * Applies a V-cycle to each vector of the block,
+ *
+ *    y(i) = M*x(i) ~ (A - driver.shift I)^(-1)*x(i),  i=1:blockSize
+ *
+ * with the products of each level done on the whole block.
+ *
+******************************************************************************/
+void ApplyAMGPrecNative(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme) {
+
+   int i, l;
+   const int nLocal = primme->nLocal, nv = *blockSize;
+   size_t size;
+   PRIMME_NUM *xvec, *yvec, *buffer, *X[AMG_MAX_LEVELS], *B[AMG_MAX_LEVELS],
+              *work[AMG_MAX_LEVELS];
+   AMGPrec *prec;
+
+   prec = (AMGPrec *)primme->preconditioner;
+   xvec = (PRIMME_NUM *)x;
+   yvec = (PRIMME_NUM *)y;
+
+   /* Each level has x, b and three work vectors per vector of the block */
+   for (l=0, size=0; l<prec->numLevels; l++) {
+      size += (size_t)prec->levels[l].A->m*nv*5;
+   }
+   buffer = (PRIMME_NUM *)primme_calloc(size, sizeof(PRIMME_NUM), "buffer");
+   for (l=0, size=0; l<prec->numLevels; l++) {
+      X[l] = &buffer[size];
+      B[l] = &buffer[size + (size_t)prec->levels[l].A->m*nv];
+      work[l] = &buffer[size + (size_t)prec->levels[l].A->m*nv*2];
+      size += (size_t)prec->levels[l].A->m*nv*5;
+   }
+
+   for (i=0; i<nv; i++) {
+      memcpy(&B[0][(size_t)nLocal*i], &xvec[(size_t)*ldx*i],
+            sizeof(PRIMME_NUM)*nLocal);
+   }
+   vcycle(prec, 0, nv, X, B, work);
+   for (i=0; i<nv; i++) {
+      memcpy(&yvec[(size_t)*ldy*i], &X[0][(size_t)nLocal*i],
+            sizeof(PRIMME_NUM)*nLocal);
+   }
+
+   free(buffer);
+}
+
+/******************************************************************************
+ * x{l} = V-cycle from level l on b{l} with zero initial guess: pre-smoothing,
+ * correction from the next level and post-smoothing, which make the cycle
+ * symmetric. work{l} has three times the size of x{l}; the arrays of the
+ * next levels are overwritten.
+ *
+******************************************************************************/
+static void vcycle(const AMGPrec *prec, int l, int nv, PRIMME_NUM **x,
+      PRIMME_NUM **b, PRIMME_NUM **work) {
+
+   size_t i;
+   const AMGLevel *level = &prec->levels[l];
+   const size_t size = (size_t)level->A->m*nv;
+   PRIMME_NUM *r = work[l];
+
+   if (l == prec->numLevels-1) {
+      if (prec->LU) {
+         memcpy(x[l], b[l], sizeof(PRIMME_NUM)*size);
+         luSolve(prec->LU, level->A->m, prec->ipiv, x[l], nv);
+      }
+      else {
+         smooth(level, prec->smoother, nv, b[l], x[l], 1, work[l]);
+         smooth(level, prec->smoother, nv, b[l], x[l], 0, work[l]);
+      }
+      return;
+   }
+
+   smooth(level, prec->smoother, nv, b[l], x[l], 1, work[l]);
+
+   /* b{l+1} = R*(b{l} - A*x{l}) */
+   spmm(level->A, nv, x[l], r);
+   for (i=0; i<size; i++) r[i] = b[l][i] - r[i];
+   spmm(level->R, nv, r, b[l+1]);
+
+   vcycle(prec, l+1, nv, x, b, work);
+
+   /* x{l} += P*x{l+1} */
+   spmm(level->P, nv, x[l+1], r);
+   for (i=0; i<size; i++) x[l][i] += r[i];
+
+   smooth(level, prec->smoother, nv, b[l], x[l], 0, work[l]);
+}
+
+/******************************************************************************
+ * Improves x on A*x = b with AMG_SWEEPS products with A of damped Jacobi,
+ * x += 4/(3*rho)*D^(-1)*(b - A*x), or of the Chebyshev iteration on
+ * D^(-1)*A over [rho/AMG_CHEB_RATIO, rho]*1.1 (Saad, Alg. 12.1). If
+ * zeroGuess, x is taken as zero and the first product is saved. work has
+ * three times the size of x.
+ *
+******************************************************************************/
+static void smooth(const AMGLevel *level, amg_smoother smoother, int nv,
+      const PRIMME_NUM *b, PRIMME_NUM *x, int zeroGuess, PRIMME_NUM *work) {
+
+   int j, k;
+   size_t i;
+   const size_t n = (size_t)level->A->m, size = n*nv;
+   double omega, hi, lo, theta=1.0, delta=1.0, sigma1=1.0, rho=1.0, rhoNew;
+   PRIMME_NUM *r = work, *d = &work[size], *w = &work[size*2];
+
+   for (k=0; k<AMG_SWEEPS; k++) {
+      /* r = D^(-1)*(b - A*x), or the update of it for Chebyshev */
+      if (k == 0 || smoother == amg_jacobi) {
+         if (zeroGuess && k == 0) {
+            memcpy(r, b, sizeof(PRIMME_NUM)*size);
+         }
+         else {
+            spmm(level->A, nv, x, r);
+            for (i=0; i<size; i++) r[i] = b[i] - r[i];
+         }
+         for (j=0; j<nv; j++) {
+            for (i=0; i<n; i++) r[n*j+i] *= level->invDiag[i];
+         }
+      }
+
+      if (smoother == amg_jacobi) {
+         omega = 4.0/(3.0*level->rho);
+         for (i=0; i<size; i++) d[i] = omega*r[i];
+      }
+      else if (k == 0) {
+         /* The power method underestimates rho */
+         hi = 1.1*level->rho;
+         lo = hi/AMG_CHEB_RATIO;
+         theta = (hi+lo)/2.0;
+         delta = (hi-lo)/2.0;
+         sigma1 = theta/delta;
+         rho = 1.0/sigma1;
+         for (i=0; i<size; i++) d[i] = r[i]/theta;
+      }
+      else {
+         spmm(level->A, nv, d, w);
+         rhoNew = 1.0/(2.0*sigma1 - rho);
+         for (j=0; j<nv; j++) {
+            for (i=0; i<n; i++) {
+               r[n*j+i] -= level->invDiag[i]*w[n*j+i];
+               d[n*j+i] = rhoNew*rho*d[n*j+i]
+                  + 2.0*rhoNew/delta*r[n*j+i];
+            }
+         }
+         rho = rhoNew;
+      }
+
+      if (zeroGuess && k == 0) {
+         memcpy(x, d, sizeof(PRIMME_NUM)*size);
+      }
+      else {
+         for (i=0; i<size; i++) x[i] += d[i];
+      }
+   }
+}
+
+/******************************************************************************
+ * Splits the rows into aggregates (Vanek, Mandel and Brezina, 1996); sets
+ * strong[k] if the entry k of A is a strong connection, and agg[i] to the
+ * aggregate of row i, or -1 if row i has no strong connections. Returns
+ * the number of aggregates.
+ *
+******************************************************************************/
+static int aggregate(const CSRMatrix *A, double strength, char *strong,
+      int *agg) {
+
+   int i, j, k, c, n = A->m, nc = 0, numSeeds, free_;
+   double a, best, *invDiag;
+   int *joined;
+
+   invDiag = (double *)primme_calloc(n, sizeof(double), "invDiag");
+   diagonalInverse(A, invDiag);
+   for (i=0; i<n; i++) {
+      agg[i] = -1;
+      for (k=A->IA[i]-1; k<A->IA[i+1]-1; k++) {
+         c = A->JA[k]-1;
+         a = absNum(A->AElts[k]);
+         strong[k] = c != i && a != 0.0
+            && a*a*fabs(invDiag[i]*invDiag[c]) >= strength*strength;
+      }
+   }
+   free(invDiag);
+
+   /* Seeds: rows whose strong neighbors are all free, with them */
+   for (i=0; i<n; i++) {
+      if (agg[i] >= 0) continue;
+      for (k=A->IA[i]-1, free_=1, numSeeds=0; k<A->IA[i+1]-1; k++) {
+         if (!strong[k]) continue;
+         numSeeds++;
+         if (agg[A->JA[k]-1] >= 0) free_ = 0;
+      }
+      if (!free_ || numSeeds == 0) continue;
+      agg[i] = nc;
+      for (k=A->IA[i]-1; k<A->IA[i+1]-1; k++) {
+         if (strong[k]) agg[A->JA[k]-1] = nc;
+      }
+      nc++;
+   }
+
+   /* Join the rest to the aggregate of their strongest neighbor */
+   joined = (int *)primme_calloc(n, sizeof(int), "joined");
+   for (i=0; i<n; i++) {
+      joined[i] = agg[i];
+      if (agg[i] >= 0) continue;
+      for (k=A->IA[i]-1, best=0.0; k<A->IA[i+1]-1; k++) {
+         c = A->JA[k]-1;
+         if (strong[k] && agg[c] >= 0 && absNum(A->AElts[k]) > best) {
+            best = absNum(A->AElts[k]);
+            joined[i] = agg[c];
+         }
+      }
+   }
+   memcpy(agg, joined, sizeof(int)*n);
+   free(joined);
+
+   /* Aggregate the remaining rows with their free strong neighbors */
+   for (i=0; i<n; i++) {
+      if (agg[i] >= 0) continue;
+      for (k=A->IA[i]-1, j=0; k<A->IA[i+1]-1; k++) {
+         if (strong[k]) j = 1;
+      }
+      if (j == 0) continue;
+      agg[i] = nc;
+      for (k=A->IA[i]-1; k<A->IA[i+1]-1; k++) {
+         if (strong[k] && agg[A->JA[k]-1] < 0) agg[A->JA[k]-1] = nc;
+      }
+      nc++;
+   }
+
+   return nc;
+}
+
+/******************************************************************************
+ * Returns P = (I - omega*D_F^(-1)*A_F)*T, where T(i,agg(i)) is one over the
+ * square root of the size of the aggregate, A_F is A with only the strong
+ * connections and the weak ones added to the diagonal, so that A_F keeps
+ * the row sums of A, and omega = 4/(3*rho(D_F^(-1)*A_F)).
+ *
+******************************************************************************/
+static CSRMatrix *prolongator(const CSRMatrix *A, const char *strong,
+      const int *agg, int nc) {
+
+   int i, k, nnz, n = A->m, *size;
+   double omega, *invDiag;
+   CSRMatrix *S, *T, *P;
+
+   /* S = A_F, with the diagonal first in each row */
+   for (i=0, nnz=0; i<n; i++) {
+      for (k=A->IA[i]-1, nnz++; k<A->IA[i+1]-1; k++) {
+         if (strong[k]) nnz++;
+      }
+   }
+   S = newCSRMatrix(n, n, nnz);
+   for (i=0, nnz=0; i<n; i++) {
+      S->IA[i] = nnz+1;
+      S->JA[nnz] = i+1;
+      S->AElts[nnz] = 0.0;
+      for (k=A->IA[i]-1, nnz++; k<A->IA[i+1]-1; k++) {
+         if (strong[k]) {
+            S->JA[nnz] = A->JA[k];
+            S->AElts[nnz++] = A->AElts[k];
+         }
+         else {
+            S->AElts[S->IA[i]-1] += A->AElts[k];
+         }
+      }
+   }
+   S->IA[n] = nnz+1;
+
+   /* S = I - omega*D_F^(-1)*A_F */
+   invDiag = (double *)primme_calloc(n, sizeof(double), "invDiag");
+   diagonalInverse(S, invDiag);
+   omega = 4.0/(3.0*spectralRadius(S, invDiag));
+   for (i=0; i<n; i++) {
+      for (k=S->IA[i]-1; k<S->IA[i+1]-1; k++) {
+         S->AElts[k] *= -omega*invDiag[i];
+      }
+      S->AElts[S->IA[i]-1] += 1.0;
+   }
+   free(invDiag);
+
+   /* T has a row per row of A; rows without aggregate are empty */
+   size = (int *)primme_calloc(nc, sizeof(int), "size");
+   for (i=0, nnz=0; i<n; i++) {
+      if (agg[i] >= 0) {
+         size[agg[i]]++;
+         nnz++;
+      }
+   }
+   T = newCSRMatrix(n, nc, nnz);
+   for (i=0, nnz=0; i<n; i++) {
+      T->IA[i] = nnz+1;
+      if (agg[i] >= 0) {
+         T->JA[nnz] = agg[i]+1;
+         T->AElts[nnz++] = 1.0/sqrt((double)size[agg[i]]);
+      }
+   }
+   T->IA[n] = nnz+1;
+   free(size);
+
+   P = multiply(S, T);
+   destroyCSRMatrix(S);
+   destroyCSRMatrix(T);
+   return P;
+}
+
+/******************************************************************************
+ * Returns A*B (Gustavson's algorithm). The columns of each row of the
+ * result are in the order they are found.
+ *
+******************************************************************************/
+static CSRMatrix *multiply(const CSRMatrix *A, const CSRMatrix *B) {
+
+   int i, j, k, c, nnz, *marker;
+   PRIMME_NUM *acc;
+   CSRMatrix *C;
+
+   marker = (int *)primme_calloc(B->n, sizeof(int), "marker");
+   for (c=0; c<B->n; c++) marker[c] = -1;
+
+   /* Count the entries of the result */
+   for (i=0, nnz=0; i<A->m; i++) {
+      for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+         for (k=B->IA[A->JA[j]-1]-1; k<B->IA[A->JA[j]]-1; k++) {
+            c = B->JA[k]-1;
+            if (marker[c] != i) {
+               marker[c] = i;
+               nnz++;
+            }
+         }
+      }
+   }
+
+   C = newCSRMatrix(A->m, B->n, nnz);
+   acc = (PRIMME_NUM *)primme_calloc(B->n, sizeof(PRIMME_NUM), "acc");
+   for (c=0; c<B->n; c++) marker[c] = -1;
+   for (i=0, nnz=0; i<A->m; i++) {
+      C->IA[i] = nnz+1;
+      for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+         for (k=B->IA[A->JA[j]-1]-1; k<B->IA[A->JA[j]]-1; k++) {
+            c = B->JA[k]-1;
+            if (marker[c] != i) {
+               marker[c] = i;
+               C->JA[nnz++] = c+1;
+               acc[c] = 0.0;
+            }
+            acc[c] += A->AElts[j]*B->AElts[k];
+         }
+      }
+      for (j=C->IA[i]-1; j<nnz; j++) C->AElts[j] = acc[C->JA[j]-1];
+   }
+   C->IA[A->m] = nnz+1;
+
+   free(marker);
+   free(acc);
+   return C;
+}
+
+/******************************************************************************
+ * Returns the conjugate transpose of A.
+ *
+******************************************************************************/
+static CSRMatrix *conjTranspose(const CSRMatrix *A) {
+
+   int i, j, c, *next;
+   CSRMatrix *T;
+
+   T = newCSRMatrix(A->n, A->m, A->IA[A->m]-1);
+   for (j=0; j<T->nnz; j++) T->IA[A->JA[j]]++;
+   for (i=0, T->IA[0]=1; i<T->m; i++) T->IA[i+1] += T->IA[i];
+
+   next = (int *)primme_calloc(T->m, sizeof(int), "next");
+   for (i=0; i<T->m; i++) next[i] = T->IA[i]-1;
+   for (i=0; i<A->m; i++) {
+      for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+         c = A->JA[j]-1;
+         T->JA[next[c]] = i+1;
+         T->AElts[next[c]++] = CONJ(A->AElts[j]);
+      }
+   }
+   free(next);
+   return T;
+}
+
+/******************************************************************************
+ * Estimates the largest |eigenvalue| of D^(-1)*A with a few steps of the
+ * power method from a pseudo-random vector.
+ *
+******************************************************************************/
+static double spectralRadius(const CSRMatrix *A, const double *invDiag) {
+
+   int i, k, n = A->m;
+   unsigned int seed = 1;
+   double nrm, rho = 0.0;
+   PRIMME_NUM *x, *y;
+
+   x = (PRIMME_NUM *)primme_calloc(n, sizeof(PRIMME_NUM), "x");
+   y = (PRIMME_NUM *)primme_calloc(n, sizeof(PRIMME_NUM), "y");
+   for (i=0, nrm=0.0; i<n; i++) {
+      seed = seed*1103515245u + 12345u;
+      x[i] = (double)((seed >> 8) & 0xffff)/32768.0 - 1.0;
+      nrm += REAL_PART(CONJ(x[i])*x[i]);
+   }
+   nrm = sqrt(nrm);
+
+   for (k=0; k<AMG_POWER_STEPS && nrm > 0.0; k++) {
+      for (i=0; i<n; i++) x[i] /= nrm;
+      spmm(A, 1, x, y);
+      for (i=0, nrm=0.0; i<n; i++) {
+         x[i] = invDiag[i]*y[i];
+         nrm += REAL_PART(CONJ(x[i])*x[i]);
+      }
+      nrm = sqrt(nrm);
+      rho = nrm;
+   }
+
+   free(x);
+   free(y);
+   return rho > 0.0 ? rho : 1.0;
+}
+
+/******************************************************************************
+ * invDiag(i) = 1/real(A(i,i)), or one if the diagonal is zero.
+ *
+******************************************************************************/
+static void diagonalInverse(const CSRMatrix *A, double *invDiag) {
+
+   int i, j;
+
+   for (i=0; i<A->m; i++) {
+      invDiag[i] = 1.0;
+      for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+         if (A->JA[j]-1 == i && REAL_PART(A->AElts[j]) != 0.0) {
+            invDiag[i] = 1.0/REAL_PART(A->AElts[j]);
+         }
+      }
+   }
+}
+
+/******************************************************************************
+ * y = A*x, with x and y of nv columns and leading dimensions A->n and A->m.
+ * The loop over the rows is split among the OpenMP threads.
+ *
+******************************************************************************/
+static void spmm(const CSRMatrix *A, int nv, const PRIMME_NUM *x,
+      PRIMME_NUM *y) {
+
+   int i, j, k;
+   PRIMME_NUM s;
+
+   for (k=0; k<nv; k++) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(j,s)
+#endif
+      for (i=0; i<A->m; i++) {
+         for (j=A->IA[i]-1, s=0.0; j<A->IA[i+1]-1; j++) {
+            s += A->AElts[j]*x[(size_t)A->n*k+A->JA[j]-1];
+         }
+         y[(size_t)A->m*k+i] = s;
+      }
+   }
+}
+
+/******************************************************************************
+ * LU factorization with partial pivoting of the n x n matrix a, stored by
+ * columns. Returns -1 if a pivot is zero.
+ *
+******************************************************************************/
+static int luFactor(PRIMME_NUM *a, int n, int *ipiv) {
+
+   int i, j, k, p;
+   PRIMME_NUM t;
+
+   for (k=0; k<n; k++) {
+      for (i=k+1, p=k; i<n; i++) {
+         if (absNum(a[(size_t)n*k+i]) > absNum(a[(size_t)n*k+p])) p = i;
+      }
+      ipiv[k] = p;
+      if (absNum(a[(size_t)n*k+p]) == 0.0) return -1;
+      if (p != k) {
+         for (j=0; j<n; j++) {
+            t = a[(size_t)n*j+k];
+            a[(size_t)n*j+k] = a[(size_t)n*j+p];
+            a[(size_t)n*j+p] = t;
+         }
+      }
+      for (i=k+1; i<n; i++) a[(size_t)n*k+i] /= a[(size_t)n*k+k];
+      for (j=k+1; j<n; j++) {
+         t = a[(size_t)n*j+k];
+         if (t == 0.0) continue;
+         for (i=k+1; i<n; i++) a[(size_t)n*j+i] -= a[(size_t)n*k+i]*t;
+      }
+   }
+   return 0;
+}
+
+/******************************************************************************
+ * Solves a*x = b with the factors of luFactor for the nv columns of b,
+ * which are overwritten with x.
+ *
+******************************************************************************/
+static void luSolve(const PRIMME_NUM *a, int n, const int *ipiv,
+      PRIMME_NUM *b, int nv) {
+
+   int i, j, k;
+   PRIMME_NUM t, *x;
+
+   for (j=0; j<nv; j++) {
+      x = &b[(size_t)n*j];
+      /* The factorization swaps whole rows, so L has all the swaps */
+      for (k=0; k<n; k++) {
+         if (ipiv[k] != k) {
+            t = x[k];
+            x[k] = x[ipiv[k]];
+            x[ipiv[k]] = t;
+         }
+      }
+      for (k=0; k<n; k++) {
+         for (i=k+1; i<n; i++) x[i] -= a[(size_t)n*k+i]*x[k];
+      }
+      for (k=n-1; k>=0; k--) {
+         x[k] /= a[(size_t)n*k+k];
+         for (i=0; i<k; i++) x[i] -= a[(size_t)n*k+i]*x[k];
+      }
+   }
+}
+
+static double absNum(PRIMME_NUM x) {
+   return sqrt(REAL_PART(CONJ(x)*x));
+}
+
+static CSRMatrix *newCSRMatrix(int m, int n, int nnz) {
+
+   CSRMatrix *matrix;
+
+   matrix = (CSRMatrix *)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
+   matrix->m = m;
+   matrix->n = n;
+   matrix->nnz = nnz;
+   matrix->IA = (int *)primme_calloc(m+1, sizeof(int), "IA");
+   matrix->JA = (int *)primme_calloc(max(nnz, 1), sizeof(int), "JA");
+   matrix->AElts = (PRIMME_NUM *)primme_calloc(max(nnz, 1), sizeof(PRIMME_NUM),
+         "AElts");
+   return matrix;
+}
+
+static CSRMatrix *copyCSRMatrix(const CSRMatrix *matrix) {
+
+   CSRMatrix *copy;
+
+   copy = newCSRMatrix(matrix->m, matrix->n, matrix->IA[matrix->m]-1);
+   memcpy(copy->IA, matrix->IA, sizeof(int)*(matrix->m+1));
+   memcpy(copy->JA, matrix->JA, sizeof(int)*copy->nnz);
+   memcpy(copy->AElts, matrix->AElts, sizeof(PRIMME_NUM)*copy->nnz);
+   return copy;
+}
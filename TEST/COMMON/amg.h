@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: amg.h
+ * 
+ * Purpose - Definitions of the smoothed aggregation AMG preconditioner used
+ *           by the driver.
+ * 
+ ******************************************************************************/
+
+#ifndef AMG_H
+#define AMG_H
+
+#include "csr.h"
+#include "primme.h"
+
+typedef enum {
+   amg_jacobi,          /* damped Jacobi */
+   amg_chebyshev        /* Chebyshev polynomial in D^(-1)*A */
+} amg_smoother;
+
+/* Level l has the operator A (both triangles) and, if it is not the last
+   one, the prolongator P from level l+1 and R = P'. invDiag has the
+   inverse of the diagonal of A and rho estimates the spectral radius of
+   D^(-1)*A. The operator of the last level is factorized in LU, with
+   pivots ipiv, if it is small enough; otherwise it is only smoothed. */
+
+typedef struct {
+   CSRMatrix *A, *P, *R;
+   double *invDiag;
+   double rho;
+} AMGLevel;
+
+typedef struct {
+   int numLevels;
+   AMGLevel *levels;
+   amg_smoother smoother;
+   PRIMME_NUM *LU;
+   int *ipiv;
+} AMGPrec;
+
+int createAMGPrecNative(const CSRMatrix *matrix, double shift, double strength,
+                        amg_smoother smoother, AMGPrec **prec);
+void ApplyAMGPrecNative(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme);
+void destroyAMGPrecNative(AMGPrec *prec);
+
+#endif
@@ -0,0 +1,323 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: chebyshev.c
+ * 
+ * Purpose - Polynomial preconditioner that only needs the matrix-vector
+ *           product: Chebyshev iteration on (A - shift I) y = x over an
+ *           interval with the spectrum of A estimated by Lanczos.
+ * 
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "chebyshev.h"
+#include "num.h"
+
+#define CHEB_LANCZOS_STEPS 20   /* steps to estimate the spectrum of A */
+
+static double globalSum(double v, primme_params *primme);
+static int sturmCount(const double *alpha, const double *beta, int k,
+      double x);
+static double bisectEigenvalue(const double *alpha, const double *beta,
+      int k, int count, double lo, double hi);
+static void shiftedProduct(const PRIMME_NUM *v, PRIMME_NUM *w, int nv,
+      const double *shifts, const double *signs, primme_params *primme);
+static void chebyshevSolve(const ChebyshevPrec *prec, int nv,
+      const double *shifts, const PRIMME_NUM *x, PRIMME_NUM *y,
+      PRIMME_NUM *work, primme_params *primme);
+
+/******************************************************************************
+ * Estimates the interval [low, high] with the spectrum of A from the
+ * extreme Ritz values of a few Lanczos steps. high is widened by the last
+ * off-diagonal element, so that the polynomial does not grow on the largest
+ * eigenvalues; low is not, because the eigenvalues below it are the ones
+ * the preconditioner should amplify. The starting vector is pseudo-random
+ * and different on each process. Returns -1 if the degree is not positive.
+ *
+******************************************************************************/
+int createChebyshevPrec(primme_params *primme, double shift, int degree,
+                        ChebyshevPrec **prec_) {
+
+   int i, j, k, one = 1, nLocal = primme->nLocal;
+   unsigned int seed;
+   double *alpha, *beta, nrm, lo, hi;
+   PRIMME_NUM *q, *qPrev, *w;
+   ChebyshevPrec *prec;
+
+   if (degree < 1) return -1;
+
+   k = min(CHEB_LANCZOS_STEPS, primme->n);
+   alpha = (double *)primme_calloc(k, sizeof(double), "alpha");
+   beta = (double *)primme_calloc(k, sizeof(double), "beta");
+   q = (PRIMME_NUM *)primme_calloc(nLocal, sizeof(PRIMME_NUM), "q");
+   qPrev = (PRIMME_NUM *)primme_calloc(nLocal, sizeof(PRIMME_NUM), "qPrev");
+   w = (PRIMME_NUM *)primme_calloc(nLocal, sizeof(PRIMME_NUM), "w");
+
+   seed = 1 + (unsigned int)primme->procID;
+   for (i=0, nrm=0.0; i<nLocal; i++) {
+      seed = seed*1103515245u + 12345u;
+      q[i] = (double)((seed >> 8) & 0xffff)/32768.0 - 1.0;
+      nrm += REAL_PART(CONJ(q[i])*q[i]);
+   }
+   nrm = sqrt(globalSum(nrm, primme));
+   for (i=0; i<nLocal; i++) q[i] /= nrm;
+
+   for (j=0; j<k; j++) {
+      primme->matrixMatvec(q, &nLocal, w, &nLocal, &one, primme);
+      for (i=0, alpha[j]=0.0; i<nLocal; i++) {
+         alpha[j] += REAL_PART(CONJ(q[i])*w[i]);
+      }
+      alpha[j] = globalSum(alpha[j], primme);
+      for (i=0, nrm=0.0; i<nLocal; i++) {
+         w[i] -= alpha[j]*q[i] + (j > 0 ? beta[j-1] : 0.0)*qPrev[i];
+         nrm += REAL_PART(CONJ(w[i])*w[i]);
+      }
+      beta[j] = sqrt(globalSum(nrm, primme));
+
+      /* Stop if the Krylov subspace is invariant */
+      if (beta[j] <= MACHINE_EPSILON*fabs(alpha[j])) {
+         k = j+1;
+         break;
+      }
+      for (i=0; i<nLocal; i++) {
+         qPrev[i] = q[i];
+         q[i] = w[i]/beta[j];
+      }
+   }
+
+   /* Gershgorin interval of the tridiagonal matrix */
+   for (j=0, lo=HUGE_VAL, hi=-HUGE_VAL; j<k; j++) {
+      nrm = (j > 0 ? beta[j-1] : 0.0) + (j < k-1 ? beta[j] : 0.0);
+      lo = min(lo, alpha[j] - nrm);
+      hi = max(hi, alpha[j] + nrm);
+   }
+
+   prec = (ChebyshevPrec *)primme_calloc(1, sizeof(ChebyshevPrec), "prec");
+   prec->degree = degree;
+   prec->shift = shift;
+   prec->low = bisectEigenvalue(alpha, beta, k, 1, lo, hi);
+   prec->high = bisectEigenvalue(alpha, beta, k, k, lo, hi) + beta[k-1];
+
+   free(alpha); free(beta); free(q); free(qPrev); free(w);
+   *prec_ = prec;
+   return 0;
+}
+
+void destroyChebyshevPrec(ChebyshevPrec *prec) {
+   free(prec);
+}
+
+/******************************************************************************
+ * Applies the preconditioner
+ *
+ *    y(i) = p_i(A)*x(i) ~ (A - primme.Shifts(i) I)^(-1)*x(i),  i=1:blockSize
+ *
+ * or with the shift of the preconditioner if primme.ShiftsForPreconditioner
+ * is not set. p_i is the polynomial of the Chebyshev iteration for
+ * (A - shift I) y = x with degree products of A. A shift inside (low, high)
+ * is moved to the closest bound, because A - shift I is indefinite there;
+ * the eigenvectors next to the bound are still favored.
+ *
+******************************************************************************/
+void ApplyChebyshevPrec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme) {
+
+   int i;
+   const int nLocal = primme->nLocal, bs = *blockSize;
+   double shift, *shifts;
+   PRIMME_NUM *xvec, *yvec, *X, *Y, *work;
+   ChebyshevPrec *prec;
+
+   prec = (ChebyshevPrec *)primme->preconditioner;
+   xvec = (PRIMME_NUM *)x;
+   yvec = (PRIMME_NUM *)y;
+
+   shifts = (double *)primme_calloc(bs, sizeof(double), "shifts");
+   X = (PRIMME_NUM *)primme_calloc((size_t)nLocal*bs, sizeof(PRIMME_NUM), "X");
+   Y = (PRIMME_NUM *)primme_calloc((size_t)nLocal*bs, sizeof(PRIMME_NUM), "Y");
+   work = (PRIMME_NUM *)primme_calloc((size_t)nLocal*bs*3, sizeof(PRIMME_NUM),
+         "work");
+
+   for (i=0; i<bs; i++) {
+      shift = primme->ShiftsForPreconditioner ?
+         primme->ShiftsForPreconditioner[i] : prec->shift;
+      if (shift > prec->low && shift < prec->high) {
+         shift = shift - prec->low < prec->high - shift ?
+            prec->low : prec->high;
+      }
+      shifts[i] = shift;
+      memcpy(&X[(size_t)nLocal*i], &xvec[(size_t)*ldx*i],
+            sizeof(PRIMME_NUM)*nLocal);
+   }
+
+   chebyshevSolve(prec, bs, shifts, X, Y, work, primme);
+
+   for (i=0; i<bs; i++) {
+      memcpy(&yvec[(size_t)*ldy*i], &Y[(size_t)nLocal*i],
+            sizeof(PRIMME_NUM)*nLocal);
+   }
+
+   free(shifts); free(X); free(Y); free(work);
+}
+
+/******************************************************************************
+ * Chebyshev iteration (Saad, Iterative Methods for Sparse Linear Systems,
+ * Alg. 12.1) from y = 0 on nv vectors with leading dimension nLocal. Each
+ * vector has its own interval [lo, hi] of the operator, with the sign
+ * flipped if the shift is above the spectrum: the bound of the spectrum of
+ * A farther from the shift, and the closer one or hi/(degree+1)^2, whichever
+ * is larger, so that the polynomial stays bounded next to the shift. work
+ * has 3*nLocal*nv elements.
+ *
+******************************************************************************/
+static void chebyshevSolve(const ChebyshevPrec *prec, int nv,
+      const double *shifts, const PRIMME_NUM *x, PRIMME_NUM *y,
+      PRIMME_NUM *work, primme_params *primme) {
+
+   int i, j, step;
+   const int nLocal = primme->nLocal;
+   double a, b, lo, hi, ratio, rhoNew, *theta, *delta, *sigma1, *rho, *signs;
+   PRIMME_NUM *r, *d, *w;
+
+   r = work;
+   d = &work[(size_t)nLocal*nv];
+   w = &work[(size_t)nLocal*nv*2];
+   theta = (double *)primme_calloc(nv*5, sizeof(double), "coefficients");
+   delta = &theta[nv];
+   sigma1 = &theta[nv*2];
+   rho = &theta[nv*3];
+   signs = &theta[nv*4];
+
+   memcpy(r, x, sizeof(PRIMME_NUM)*nLocal*nv);
+   ratio = 1.0/((prec->degree+1)*(prec->degree+1));
+
+   for (j=0; j<nv; j++) {
+      a = prec->low - shifts[j];
+      b = prec->high - shifts[j];
+      if (a >= 0.0) {
+         signs[j] = 1.0;
+         hi = b;
+         lo = min(max(a, hi*ratio), hi*(1.0-ratio));
+      }
+      else {
+         signs[j] = -1.0;
+         hi = -a;
+         lo = min(max(-b, hi*ratio), hi*(1.0-ratio));
+      }
+      theta[j] = (hi+lo)/2.0;
+      delta[j] = (hi-lo)/2.0;
+      sigma1[j] = theta[j]/delta[j];
+      rho[j] = 1.0/sigma1[j];
+      for (i=0; i<nLocal; i++) {
+         r[(size_t)nLocal*j+i] *= signs[j];
+         d[(size_t)nLocal*j+i] = r[(size_t)nLocal*j+i]/theta[j];
+         y[(size_t)nLocal*j+i] = d[(size_t)nLocal*j+i];
+      }
+   }
+
+   for (step=0; step<prec->degree; step++) {
+      shiftedProduct(d, w, nv, shifts, signs, primme);
+      for (j=0; j<nv; j++) {
+         rhoNew = 1.0/(2.0*sigma1[j] - rho[j]);
+         for (i=0; i<nLocal; i++) {
+            r[(size_t)nLocal*j+i] -= w[(size_t)nLocal*j+i];
+            d[(size_t)nLocal*j+i] = rhoNew*rho[j]*d[(size_t)nLocal*j+i]
+               + 2.0*rhoNew/delta[j]*r[(size_t)nLocal*j+i];
+            y[(size_t)nLocal*j+i] += d[(size_t)nLocal*j+i];
+         }
+         rho[j] = rhoNew;
+      }
+   }
+
+   free(theta);
+}
+
+/******************************************************************************
+ * w(j) = signs(j)*(A - shifts(j) I)*v(j) for j=1:nv, with leading dimension
+ * nLocal.
+ *
+******************************************************************************/
+static void shiftedProduct(const PRIMME_NUM *v, PRIMME_NUM *w, int nv,
+      const double *shifts, const double *signs, primme_params *primme) {
+
+   int i, j, nLocal = primme->nLocal;
+
+   primme->matrixMatvec((void*)v, &nLocal, w, &nLocal, &nv, primme);
+   for (j=0; j<nv; j++) {
+      for (i=0; i<nLocal; i++) {
+         w[(size_t)nLocal*j+i] = signs[j]*(w[(size_t)nLocal*j+i]
+               - shifts[j]*v[(size_t)nLocal*j+i]);
+      }
+   }
+}
+
+/******************************************************************************
+ * Number of eigenvalues smaller than x of the symmetric tridiagonal matrix
+ * with diagonal alpha and off-diagonal beta, by the Sturm sequence.
+ *
+******************************************************************************/
+static int sturmCount(const double *alpha, const double *beta, int k,
+      double x) {
+
+   int j, count = 0;
+   double q = 1.0;
+
+   for (j=0; j<k; j++) {
+      q = alpha[j] - x - (j > 0 ? beta[j-1]*beta[j-1]/q : 0.0);
+      if (q == 0.0) q = -MACHINE_EPSILON*(fabs(alpha[j]) + fabs(x) + 1.0);
+      if (q < 0.0) count++;
+   }
+   return count;
+}
+
+/******************************************************************************
+ * Returns the count-th smallest eigenvalue of the tridiagonal matrix, in
+ * [lo, hi], by bisection.
+ *
+******************************************************************************/
+static double bisectEigenvalue(const double *alpha, const double *beta,
+      int k, int count, double lo, double hi) {
+
+   int it;
+   double mid;
+
+   for (it=0; it<100 && hi-lo > MACHINE_EPSILON*max(fabs(lo), fabs(hi));
+         it++) {
+      mid = (lo+hi)/2.0;
+      if (sturmCount(alpha, beta, k, mid) >= count) hi = mid;
+      else lo = mid;
+   }
+   return hi;
+}
+
+static double globalSum(double v, primme_params *primme) {
+
+   int one = 1;
+   double s;
+
+   if (!primme->globalSumDouble) return v;
+   primme->globalSumDouble(&v, &s, &one, primme);
+   return s;
+}
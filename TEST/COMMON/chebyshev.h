@@ -0,0 +1,52 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: chebyshev.h
+ * 
+ * Purpose - Definitions of the Chebyshev polynomial preconditioner used by
+ *           the driver.
+ * 
+ ******************************************************************************/
+
+#ifndef CHEBYSHEV_H
+#define CHEBYSHEV_H
+
+#include "primme.h"
+
+/* The preconditioner applies a polynomial in A that approximates
+   (A - shift I)^(-1) on the interval [low, high], which holds the spectrum
+   of A, with only primme.matrixMatvec. */
+
+typedef struct {
+   int degree;     /* products with A per vector */
+   double low;     /* estimated bounds of the spectrum of A */
+   double high;
+   double shift;   /* used if primme.ShiftsForPreconditioner is not set */
+} ChebyshevPrec;
+
+int createChebyshevPrec(primme_params *primme, double shift, int degree,
+                        ChebyshevPrec **prec);
+void ApplyChebyshevPrec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme);
+void destroyChebyshevPrec(ChebyshevPrec *prec);
+
+#endif
@@ -32,26 +32,106 @@
 #include <unistd.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <limits.h>
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#  define CSR_HAVE_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
 #include "mmio.h"
 #include "primme.h"
 #include "csr.h"
 
-static int readfullMTX(const char *mtfile, PRIMME_NUM **A, int **JA, int **IA, int *m, int *n, int *nnz);
+/* Binary CSR file: a header, then the sections IA (m+1 int32), JA (nnz
+   int32) and AElts (nnz PRIMME_NUM), each one starting at an offset
+   multiple of CSR_BIN_ALIGN and padded with zeros. IA and JA hold Fortran
+   indices, as in CSRMatrix. The checksum is a Fletcher sum of the 64-bit
+   words of the three sections. Files are read and written in the byte
+   order of the machine, recorded in byteOrder. */
+
+#define CSR_BIN_MAGIC     "PRIMECSR"
+#define CSR_BIN_VERSION   1
+#define CSR_BIN_BYTEORDER 0x01020304
+#define CSR_BIN_ALIGN     64
+
+typedef struct {
+   char magic[8];
+   int32_t version;
+   int32_t byteOrder;
+   int32_t scalarSize;  /* sizeof(PRIMME_NUM): 8 if real, 16 if complex */
+   int32_t symmetric;   /* if nonzero, in half storage (upper triangle)  */
+   int32_t m, n;
+   int64_t nnz;
+   int64_t offIA, offJA, offA;
+   uint64_t checksum;
+} CSRBinHeader;
+
+static int readMatrix(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm, int half);
+static int readBinaryCSR(const char *fileName, CSRMatrix *matrix);
+static char *mapFile(const char *fileName, size_t *size);
+static void unmapFile(char *base, size_t size);
+static void sortByKey(const int *key, int range, const int *in, int *out,
+      int nz, int numChunks, int *count);
+static const char *nextEntry(const char *p, const char *end);
+static int countEntries(const char *p, const char *end);
+static const char *parseEntry(const char *p, const char *end,
+      MM_typecode type, int *i, int *j, PRIMME_NUM *a);
+static const char *parseIndex(const char *p, const char *end, int *v);
+static const char *parseReal(const char *p, const char *end, double *v);
+static void binSections(const CSRMatrix *matrix, CSRBinHeader *header);
+static uint64_t binChecksum(const CSRMatrix *matrix);
+static void fletcher64(const void *data, size_t bytes, uint64_t *sum1, uint64_t *sum2);
+static int readfullMTX(const char *mtfile, PRIMME_NUM **A, int **JA, int **IA, int *m, int *n, int *nnz, int *half);
 #ifndef USE_DOUBLECOMPLEX
-static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int *n, int *nnz);
+static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int *n, int *nnz, int half);
 int ssrcsr(int *job, int *value2, int *nrow, double *a, int *ja, int *ia, 
    int *nzmax, double *ao, int *jao, int *iao, int *indu, int *iwk, int *ierr);
 #endif
 
 int readMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm) {
+   return readMatrix(matrixFileName, matrix_, fnorm, 0);
+}
+
+/******************************************************************************
+ * Reads a matrix as readMatrixNative, but if the file stores a symmetric or
+ * Hermitian matrix by one triangle, the matrix is kept in half storage: only
+ * the diagonal and the upper triangle, and matrix->symmetric is set.
+ *
+******************************************************************************/
+int readSymMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm) {
+   return readMatrix(matrixFileName, matrix_, fnorm, 1);
+}
+
+static int readMatrix(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm, int half) {
    int ret;
    CSRMatrix *matrix;
 
    matrix = (CSRMatrix*)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
-   if (!strcmp("mtx", &matrixFileName[strlen(matrixFileName)-3])) {  
+   if (strlen(matrixFileName) > 5
+         && !strcmp(".bcsr", &matrixFileName[strlen(matrixFileName)-5])) {
+      /* binary CSR, mapped into memory */
+      if (readBinaryCSR(matrixFileName, matrix) < 0) {
+         destroyCSRMatrix(matrix);
+         fprintf(stderr, "ERROR: Could not read matrix file\n");
+         return(-1);
+      }
+      if (matrix->symmetric && !half) {
+         CSRMatrix *full;
+         expandSymCSRMatrix(matrix, &full);
+         destroyCSRMatrix(matrix);
+         matrix = full;
+      }
+   }
+   else if (!strcmp("mtx", &matrixFileName[strlen(matrixFileName)-3])) {  
       /* coordinate format storing both lower and upper triangular parts */
+      matrix->symmetric = half;
       ret = readfullMTX(matrixFileName, &matrix->AElts, &matrix->JA, 
-         &matrix->IA, &matrix->m, &matrix->n, &matrix->nnz);
+         &matrix->IA, &matrix->m, &matrix->n, &matrix->nnz, &matrix->symmetric);
       if (ret < 0) {
          fprintf(stderr, "ERROR: Could not read matrix file\n");
          return(-1);
@@ -61,7 +141,9 @@ int readMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fn
       /* coordinate format storing only upper triangular part */
 #ifndef USE_DOUBLECOMPLEX
       ret = readUpperMTX(matrixFileName, &matrix->AElts, &matrix->JA,
-         &matrix->IA, &matrix->n, &matrix->nnz);
+         &matrix->IA, &matrix->n, &matrix->nnz, half);
+      matrix->m = matrix->n;
+      matrix->symmetric = half;
 #else
       /* TODO: support this in complex arithmetic */
       ret = -1;
@@ -87,19 +169,27 @@ int readMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fn
    return 0;
 }
 
-static int *my_comp_ctx[2];
-static int my_comp(const void *a, const void *b)
-{
-   const int ia = *(int*)a, ib = *(int*)b;
-   int **p = my_comp_ctx;
-   return p[0][ia] != p[0][ib] ? p[0][ia] - p[0][ib] : p[1][ia] - p[1][ib];
-}
-
-static int readfullMTX(const char *mtfile, PRIMME_NUM **AA, int **JA, int **IA, int *m, int *n, int *nnz) { 
-   int i,j, k, nzmax;
-   int *I, *J, *perm;
+/******************************************************************************
+ * Reads a MatrixMarket file in CSR. If *half is nonzero on entry and the
+ * file is symmetric or Hermitian, the entries of the lower triangle are
+ * stored transposed (and conjugated) in the upper one; otherwise the
+ * missing triangle is filled in and *half is set to zero.
+ *
+ * The banner and the sizes are read with mmio. The entries are parsed from
+ * the file mapped in memory, split in chunks at line boundaries that are
+ * parsed in parallel if compiled with OpenMP. Then they are sorted by
+ * column and by row with two stable counting sorts, also by chunks. The
+ * result does not depend on the number of threads.
+ *
+******************************************************************************/
+static int readfullMTX(const char *mtfile, PRIMME_NUM **AA, int **JA, int **IA, int *m, int *n, int *nnz, int *half) { 
+   int c, numChunks, nzmax, mirror, err;
+   int *I, *J, *order, *tmp, *rowCount, *start, *offStart;
    PRIMME_NUM *A;
-   double re, im;
+   long dataStart;
+   char *text;
+   const char **bounds;
+   size_t size;
    FILE *matrixFile;
    MM_typecode type;
 
@@ -120,55 +210,335 @@ static int readfullMTX(const char *mtfile, PRIMME_NUM **AA, int **JA, int **IA,
    }
 
    if (mm_read_mtx_crd_size(matrixFile, m, n, nnz) != 0) return -1;
+   dataStart = ftell(matrixFile);
+   fclose(matrixFile);
 
-   nzmax = *nnz;
-   if (mm_is_symmetric(type)) nzmax *= 2;
+   text = mapFile(mtfile, &size);
+   if (text == NULL || dataStart < 0 || (size_t)dataStart > size) return -1;
+
+   if (!mm_is_symmetric(type) && !mm_is_hermitian(type)) *half = 0;
+   mirror = (mm_is_symmetric(type) || mm_is_hermitian(type)) && !*half;
+   nzmax = mirror ? 2*(*nnz) : *nnz;
    A = (PRIMME_NUM *)primme_calloc(nzmax, sizeof(PRIMME_NUM), "A");
    J = (int *)primme_calloc(nzmax, sizeof(int), "J");
    I = (int *)primme_calloc(nzmax, sizeof(int), "I");
 
-   /* Read matrix in COO */
-   for (k=0, i=0; k<*nnz; k++, i++) {
-      if (mm_read_mtx_crd_entry(matrixFile, &I[i], &J[i], &re, &im, type)!=0) return -1;
-      if (mm_is_pattern(type)) A[i] = 1;
-      else if (mm_is_real(type)) A[i] = re;
-      else A[i] = re + IMAGINARY*im;
-      if ((mm_is_symmetric(type) || mm_is_hermitian(type)) && I[i] != J[i]) {
-         I[i+1] = J[i]; J[i+1] = I[i]; A[i+1] = CONJ(A[i]); i++;
+#ifdef _OPENMP
+   numChunks = omp_get_max_threads();
+#else
+   numChunks = 1;
+#endif
+   bounds = (const char **)primme_calloc(numChunks+1, sizeof(char*), "bounds");
+   start = (int *)primme_calloc(numChunks+1, sizeof(int), "start");
+   offStart = (int *)primme_calloc(numChunks+1, sizeof(int), "offStart");
+
+   /* Split the entries in chunks that start after a newline */
+   for (c=0; c<=numChunks; c++) {
+      bounds[c] = text + dataStart + (size - dataStart)/numChunks*c;
+      if (c == numChunks) bounds[c] = text + size;
+      while (c > 0 && bounds[c] < text + size && bounds[c][-1] != '\n') {
+         bounds[c]++;
       }
    }
-   nzmax = *nnz = i;
 
-   /* Sort COO by columns */
-   perm = (int *)primme_calloc(nzmax, sizeof(int), "perm");
-   for (i=0; i<nzmax; i++) perm[i] = i;
-   my_comp_ctx[0] = I;
-   my_comp_ctx[1] = J;
-   qsort(perm, nzmax, sizeof(int), my_comp);
+   /* Count the entries in each chunk; the file may have more lines than
+      nnz, which are ignored */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+   for (c=0; c<numChunks; c++) {
+      start[c+1] = countEntries(bounds[c], bounds[c+1]);
+   }
+   for (c=0; c<numChunks; c++) start[c+1] = min(start[c] + start[c+1], *nnz);
+   err = start[numChunks] < *nnz;
+
+   /* Parse the entries of each chunk into I, J and A in order, and count
+      the entries off the diagonal */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) reduction(+:err)
+#endif
+   for (c=0; c<numChunks; c++) {
+      int k, t;
+      const char *p = bounds[c];
+
+      offStart[c+1] = 0;
+      for (k=start[c]; k<start[c+1]; k++) {
+         p = parseEntry(nextEntry(p, bounds[c+1]), bounds[c+1], type, &I[k],
+               &J[k], &A[k]);
+         if (p == NULL || I[k] < 1 || I[k] > *m || J[k] < 1 || J[k] > *n) {
+            err++;
+            break;
+         }
+         if (*half && I[k] > J[k]) {
+            t = I[k]; I[k] = J[k]; J[k] = t; A[k] = CONJ(A[k]);
+         }
+         if (I[k] != J[k]) offStart[c+1]++;
+      }
+   }
+   unmapFile(text, size);
+   if (err) {
+      fprintf(stderr, "ERROR: wrong or missing entries in %s\n", mtfile);
+      return -1;
+   }
+
+   /* Add the transposed entries after the ones in the file */
+   if (mirror) {
+      offStart[0] = *nnz;
+      for (c=0; c<numChunks; c++) offStart[c+1] += offStart[c];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+      for (c=0; c<numChunks; c++) {
+         int k, q = offStart[c];
+         for (k=start[c]; k<start[c+1]; k++) {
+            if (I[k] != J[k]) {
+               I[q] = J[k]; J[q] = I[k]; A[q++] = CONJ(A[k]);
+            }
+         }
+      }
+      nzmax = offStart[numChunks];
+   }
+   *nnz = nzmax;
+   free(bounds);
+   free(start);
+   free(offStart);
+
+   /* Sort by columns and then by rows */
+   tmp = (int *)primme_calloc(nzmax, sizeof(int), "tmp");
+   order = (int *)primme_calloc(nzmax, sizeof(int), "order");
+   rowCount = (int *)primme_calloc(*m, sizeof(int), "rowCount");
+   sortByKey(J, *n, NULL, tmp, nzmax, numChunks, NULL);
+   sortByKey(I, *m, tmp, order, nzmax, numChunks, rowCount);
+   free(tmp);
 
-   /* Collapse columns */
    *IA = (int *)primme_calloc(*m+1, sizeof(int), "IA");
    (*IA)[0] = 1;
-   for (i=0, j=1; i<nzmax; i++)
-      while (j < I[perm[i]]) (*IA)[j++] = i+1;
-   while (j <= *m) (*IA)[j++] = nzmax+1;
+   for (c=0; c<*m; c++) (*IA)[c+1] = (*IA)[c] + rowCount[c];
+   free(rowCount);
 
    /* Copy rows and values sorted */
-   *JA = I;
-   for (i=0; i<nzmax; i++) (*JA)[i] = J[perm[i]];
-   free(J);
+   *JA = (int *)primme_calloc(nzmax, sizeof(int), "JA");
    *AA = (PRIMME_NUM *)primme_calloc(nzmax, sizeof(PRIMME_NUM), "AA");
-   for (i=0; i<nzmax; i++) (*AA)[i] = A[perm[i]];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+   for (c=0; c<nzmax; c++) {
+      (*JA)[c] = J[order[c]];
+      (*AA)[c] = A[order[c]];
+   }
+   free(I);
+   free(J);
    free(A);
-   free(perm);
-
-   fclose(matrixFile);
+   free(order);
 
    return 0;
 }
 
+/******************************************************************************
+ * Stable counting sort of the entries in[0:nz-1], or 0:nz-1 if in is NULL,
+ * by key[entry], which takes values in 1:range. The sorted entries go to
+ * out, and if count is not NULL, count[v-1] is the number of entries with
+ * key v. The entries are counted and placed by numChunks consecutive
+ * ranges, in parallel with OpenMP; the chunks of entries with the same key
+ * are placed one after another, which keeps the sort stable.
+ *
+******************************************************************************/
+static void sortByKey(const int *key, int range, const int *in, int *out,
+      int nz, int numChunks, int *count) {
+
+   int c, v, sum, t;
+   int *hist;
+
+   hist = (int *)primme_calloc((size_t)numChunks*range, sizeof(int), "hist");
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+   for (c=0; c<numChunks; c++) {
+      int k, k1 = (int)((long)nz*(c+1)/numChunks);
+      int *h = &hist[(size_t)c*range];
+      for (k=(int)((long)nz*c/numChunks); k<k1; k++) {
+         h[key[in ? in[k] : k]-1]++;
+      }
+   }
+
+   /* Turn counts into offsets, by key and then by chunk */
+   for (v=0, sum=0; v<range; v++) {
+      if (count) count[v] = 0;
+      for (c=0; c<numChunks; c++) {
+         t = hist[(size_t)c*range+v];
+         hist[(size_t)c*range+v] = sum;
+         sum += t;
+         if (count) count[v] += t;
+      }
+   }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+   for (c=0; c<numChunks; c++) {
+      int k, e, k1 = (int)((long)nz*(c+1)/numChunks);
+      int *h = &hist[(size_t)c*range];
+      for (k=(int)((long)nz*c/numChunks); k<k1; k++) {
+         e = in ? in[k] : k;
+         out[h[key[e]-1]++] = e;
+      }
+   }
+
+   free(hist);
+}
+
+/******************************************************************************
+ * Returns the start of the next line in [p,end) that is not blank, or end.
+ *
+******************************************************************************/
+static const char *nextEntry(const char *p, const char *end) {
+
+   while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+      p++;
+   }
+   return p;
+}
+
+/******************************************************************************
+ * Returns the number of lines in [p,end) that are not blank.
+ *
+******************************************************************************/
+static int countEntries(const char *p, const char *end) {
+
+   int count = 0;
+
+   for (p = nextEntry(p, end); p < end; p = nextEntry(p, end)) {
+      count++;
+      p = (const char *)memchr(p, '\n', end - p);
+      if (p == NULL) break;
+   }
+   return count;
+}
+
+/******************************************************************************
+ * Parses an entry "i j [re [im]]" as mm_read_mtx_crd_entry, from p up to
+ * the end of its line. Returns the start of the next line, or NULL if the
+ * entry is not well formed.
+ *
+******************************************************************************/
+static const char *parseEntry(const char *p, const char *end,
+      MM_typecode type, int *i, int *j, PRIMME_NUM *a) {
+
+   double re = 0.0, im = 0.0;
+
+   if ((p = parseIndex(p, end, i)) == NULL) return NULL;
+   if ((p = parseIndex(p, end, j)) == NULL) return NULL;
+   if (mm_is_pattern(type)) {
+      *a = 1;
+   }
+   else {
+      if ((p = parseReal(p, end, &re)) == NULL) return NULL;
+      if (mm_is_complex(type) && (p = parseReal(p, end, &im)) == NULL) {
+         return NULL;
+      }
+      if (mm_is_real(type)) *a = re;
+      else *a = re + IMAGINARY*im;
+   }
+   while (p < end && *p != '\n') p++;
+   return p;
+}
+
+static const char *parseIndex(const char *p, const char *end, int *v) {
+
+   long r = 0;
+   int digits = 0;
+
+   while (p < end && (*p == ' ' || *p == '\t')) p++;
+   if (p < end && *p == '+') p++;
+   for (; p < end && *p >= '0' && *p <= '9' && r <= INT_MAX; p++, digits++) {
+      r = r*10 + (*p - '0');
+   }
+   if (digits == 0 || r > INT_MAX) return NULL;
+   *v = (int)r;
+   return p;
+}
+
+/******************************************************************************
+ * Parses a floating point number with the same result as strtod. If the
+ * number has up to 19 significant digits, its mantissa is at most 2^53 and
+ * its decimal exponent is at most 22 in absolute value, the mantissa and
+ * the power of ten are exact doubles, and their product or quotient, with
+ * a single rounding, is the correctly rounded value (Clinger's fast path).
+ * Other numbers, and special ones as inf or hexadecimal, go to strtod.
+ *
+******************************************************************************/
+static const char *parseReal(const char *p, const char *end, double *v) {
+
+   static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+      1e20, 1e21, 1e22};
+   const char *s, *q;
+   char buf[64], *tok, *tokEnd;
+   uint64_t mant = 0;
+   int digits = 0, anyDigit = 0, neg = 0, e10 = 0, exp = 0, expNeg = 0,
+       expDigits = 0;
+   double d;
+
+   while (p < end && (*p == ' ' || *p == '\t')) p++;
+   s = p;
+   if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+   for (; p < end && *p >= '0' && *p <= '9'; p++, anyDigit = 1) {
+      if (mant == 0 && *p == '0') continue;
+      if (digits < 19) mant = mant*10 + (uint64_t)(*p - '0');
+      digits++;
+   }
+   if (digits > 19) e10 += digits - 19;
+   if (p < end && *p == '.') {
+      for (p++; p < end && *p >= '0' && *p <= '9'; p++, anyDigit = 1) {
+         if (mant == 0 && *p == '0') {
+            e10--;
+            continue;
+         }
+         if (digits < 19) {
+            mant = mant*10 + (uint64_t)(*p - '0');
+            e10--;
+         }
+         digits++;
+      }
+   }
+   if (anyDigit && p < end && (*p == 'e' || *p == 'E')) {
+      q = p+1;
+      if (q < end && (*q == '-' || *q == '+')) expNeg = (*q++ == '-');
+      for (; q < end && *q >= '0' && *q <= '9'; q++, expDigits++) {
+         if (exp < 10000) exp = exp*10 + (*q - '0');
+      }
+      if (expDigits > 0) {
+         p = q;
+         e10 += expNeg ? -exp : exp;
+      }
+   }
+
+   if (anyDigit && digits <= 19 && mant <= ((uint64_t)1 << 53)
+         && (mant == 0 || (e10 >= -22 && e10 <= 22))
+         && (p == end || *p == ' ' || *p == '\t' || *p == '\r'
+            || *p == '\n')) {
+      d = (double)mant;
+      if (mant != 0) d = e10 < 0 ? d/pow10[-e10] : d*pow10[e10];
+      *v = neg ? -d : d;
+      return p;
+   }
+
+   /* Slow path: strtod on a copy of the token */
+   for (q = s; q < end && *q != ' ' && *q != '\t' && *q != '\r' && *q != '\n';
+         q++);
+   tok = (size_t)(q - s) < sizeof(buf) ? buf
+      : (char *)primme_calloc(q - s + 1, 1, "token");
+   memcpy(tok, s, q - s);
+   tok[q - s] = '\0';
+   *v = strtod(tok, &tokEnd);
+   p = tokEnd == tok ? NULL : s + (tokEnd - tok);
+   if (tok != buf) free(tok);
+   return p;
+}
+
 #ifndef USE_DOUBLECOMPLEX
-static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int *n, int *nnz) { 
+static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int *n, int *nnz, int half) { 
    int i, k, nzmax;
    int job, value2;
    int row, nextRow;
@@ -187,7 +557,7 @@ static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int
    if (fscanf(matrixFile, "%d %d\n", n, nnz) != 2) return -1;
    fprintf(stderr, "%d %d\n", *n, *nnz);
 
-   nzmax = 2*(*nnz) - *n;
+   nzmax = half ? *nnz : 2*(*nnz) - *n;
    *A = (double *)primme_calloc(nzmax, sizeof(double), "A");
    *JA =   (int *)primme_calloc(nzmax, sizeof(int), "JA");
    *IA = (int *)primme_calloc(*n+1, sizeof(int), "IA");
@@ -209,6 +579,7 @@ static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int
 
    (*IA)[*n] = (*IA)[0] + *nnz;
    fclose(matrixFile);
+   if (half) return 0;
 
    job = 3;
    value2 = 1;
@@ -229,11 +600,13 @@ static int readUpperMTX(const char *mtfile, double **A, int **JA, int **IA, int
  *
  *         ||A||_frob = sqrt( \sum_{i,j} A_ij^2 )
  *
+ * In half storage the entries off the diagonal count twice.
+ *
 ******************************************************************************/
 double frobeniusNorm(const CSRMatrix *matrix) {
 
    int i, j;
-   double fnorm;
+   double fnorm, aij2;
 
    /* IA and JA are indexed using C indexing, but their contents */
    /* assume Fortran indexing.  Thus, the contents of IA and JA  */
@@ -243,7 +616,9 @@ double frobeniusNorm(const CSRMatrix *matrix) {
 
    for (i=0; i < matrix->m; i++) {
       for (j=matrix->IA[i]; j <= matrix->IA[i+1]-1; j++) {
-         fnorm = fnorm + REAL_PART(CONJ(matrix->AElts[j-1])*matrix->AElts[j-1]);
+         aij2 = REAL_PART(CONJ(matrix->AElts[j-1])*matrix->AElts[j-1]);
+         if (matrix->symmetric && matrix->JA[j-1]-1 != i) aij2 *= 2.0;
+         fnorm = fnorm + aij2;
       }
    }
 
@@ -275,4 +650,347 @@ void shiftCSRMatrix(double shift, CSRMatrix *matrix) {
 
 }
 
+/******************************************************************************
+ * Returns in full a copy of the matrix in half storage with both triangles.
+ * The rows of the copy are sorted by column if the rows of the matrix are.
+ *
+******************************************************************************/
+int expandSymCSRMatrix(const CSRMatrix *matrix, CSRMatrix **full_) {
+
+   int i, j, c, n = matrix->n;
+   int *next;
+   CSRMatrix *full;
+
+   full = (CSRMatrix *)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
+   full->m = matrix->m;
+   full->n = n;
+   full->IA = (int *)primme_calloc(n+1, sizeof(int), "IA");
+
+   /* Count the entries of each row: its own and the transposed ones */
+   for (i=0; i<n; i++) {
+      for (j=matrix->IA[i]-1; j<matrix->IA[i+1]-1; j++) {
+         full->IA[i+1]++;
+         c = matrix->JA[j]-1;
+         if (c != i) full->IA[c+1]++;
+      }
+   }
+   full->IA[0] = 1;
+   for (i=0; i<n; i++) full->IA[i+1] += full->IA[i];
+   full->nnz = full->IA[n]-1;
+   full->JA = (int *)primme_calloc(full->nnz, sizeof(int), "JA");
+   full->AElts = (PRIMME_NUM *)primme_calloc(full->nnz, sizeof(PRIMME_NUM),
+         "AElts");
+
+   /* Rows are filled in order, so the transposed entries of row c, all in
+      columns i < c, land before the entries of row c itself */
+   next = (int *)primme_calloc(n, sizeof(int), "next");
+   for (i=0; i<n; i++) next[i] = full->IA[i]-1;
+   for (i=0; i<n; i++) {
+      for (j=matrix->IA[i]-1; j<matrix->IA[i+1]-1; j++) {
+         c = matrix->JA[j]-1;
+         full->JA[next[i]] = c+1;
+         full->AElts[next[i]++] = matrix->AElts[j];
+         if (c != i) {
+            full->JA[next[c]] = i+1;
+            full->AElts[next[c]++] = CONJ(matrix->AElts[j]);
+         }
+      }
+   }
+   free(next);
+
+   *full_ = full;
+   return 0;
+}
+
+/******************************************************************************
+ * Returns in permuted the square matrix with rows and columns reordered by
+ * perm, so that row i of permuted is row perm[i] of the matrix (indices
+ * from 0). A matrix in half storage stays so: the entries that fall in
+ * the lower triangle are transposed and conjugated. The rows of the
+ * result are sorted by column.
+ *
+******************************************************************************/
+int permuteCSRMatrix(const CSRMatrix *matrix, const int *perm,
+      CSRMatrix **permuted_) {
+
+   int i, k, t, n = matrix->n, nnz = matrix->nnz, numChunks;
+   int *inv, *I, *J, *tmp, *order, *rowCount;
+   PRIMME_NUM *A;
+   CSRMatrix *permuted;
+
+   if (matrix->m != n) return -1;
+
+#ifdef _OPENMP
+   numChunks = omp_get_max_threads();
+#else
+   numChunks = 1;
+#endif
+
+   inv = (int *)primme_calloc(n, sizeof(int), "inv");
+   for (i=0; i<n; i++) inv[perm[i]] = i;
+
+   /* Entries with the new indices, in the old order */
+   I = (int *)primme_calloc(nnz, sizeof(int), "I");
+   J = (int *)primme_calloc(nnz, sizeof(int), "J");
+   A = (PRIMME_NUM *)primme_calloc(nnz, sizeof(PRIMME_NUM), "A");
+   for (i=0; i<n; i++) {
+      for (k=matrix->IA[i]-1; k<matrix->IA[i+1]-1; k++) {
+         I[k] = inv[i]+1;
+         J[k] = inv[matrix->JA[k]-1]+1;
+         A[k] = matrix->AElts[k];
+         if (matrix->symmetric && I[k] > J[k]) {
+            t = I[k]; I[k] = J[k]; J[k] = t; A[k] = CONJ(A[k]);
+         }
+      }
+   }
+   free(inv);
+
+   /* Sort by columns and then by rows */
+   tmp = (int *)primme_calloc(nnz, sizeof(int), "tmp");
+   order = (int *)primme_calloc(nnz, sizeof(int), "order");
+   rowCount = (int *)primme_calloc(n, sizeof(int), "rowCount");
+   sortByKey(J, n, NULL, tmp, nnz, numChunks, NULL);
+   sortByKey(I, n, tmp, order, nnz, numChunks, rowCount);
+   free(tmp);
+
+   permuted = (CSRMatrix *)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
+   permuted->m = permuted->n = n;
+   permuted->nnz = nnz;
+   permuted->symmetric = matrix->symmetric;
+   permuted->IA = (int *)primme_calloc(n+1, sizeof(int), "IA");
+   permuted->IA[0] = 1;
+   for (i=0; i<n; i++) permuted->IA[i+1] = permuted->IA[i] + rowCount[i];
+   free(rowCount);
+   permuted->JA = (int *)primme_calloc(nnz, sizeof(int), "JA");
+   permuted->AElts = (PRIMME_NUM *)primme_calloc(nnz, sizeof(PRIMME_NUM), "AElts");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+   for (k=0; k<nnz; k++) {
+      permuted->JA[k] = J[order[k]];
+      permuted->AElts[k] = A[order[k]];
+   }
+   free(I);
+   free(J);
+   free(A);
+   free(order);
+
+   *permuted_ = permuted;
+   return 0;
+}
+
+/******************************************************************************
+ * Frees a matrix returned by readMatrixNative, readSymMatrixNative,
+ * expandSymCSRMatrix or permuteCSRMatrix.
+ *
+******************************************************************************/
+void destroyCSRMatrix(CSRMatrix *matrix) {
+
+   if (matrix->mapping) {
+      unmapFile((char *)matrix->mapping, matrix->mappingSize);
+   }
+   else {
+      free(matrix->AElts);
+      free(matrix->IA);
+      free(matrix->JA);
+   }
+   free(matrix);
+}
+
+/******************************************************************************
+ * Writes the matrix in the binary CSR format read by readMatrixNative for
+ * file names ending in .bcsr. A matrix in half storage is written so.
+ *
+******************************************************************************/
+int writeBinaryCSRMatrix(const char *fileName, const CSRMatrix *matrix) {
+
+   CSRBinHeader header;
+   FILE *f;
+   static const char zeros[CSR_BIN_ALIGN] = {0};
+   int ok;
+
+   binSections(matrix, &header);
+   header.checksum = binChecksum(matrix);
+
+   f = fopen(fileName, "wb");
+   if (f == NULL) return -1;
+   ok = fwrite(&header, sizeof(header), 1, f) == 1
+      && fwrite(zeros, 1, header.offIA - sizeof(header), f)
+            == (size_t)(header.offIA - sizeof(header))
+      && fwrite(matrix->IA, sizeof(int), matrix->m+1, f) == (size_t)matrix->m+1
+      && fwrite(zeros, 1, header.offJA - header.offIA - sizeof(int)*(matrix->m+1), f)
+            == (size_t)(header.offJA - header.offIA - sizeof(int)*(matrix->m+1))
+      && fwrite(matrix->JA, sizeof(int), matrix->nnz, f) == (size_t)matrix->nnz
+      && fwrite(zeros, 1, header.offA - header.offJA - sizeof(int)*matrix->nnz, f)
+            == (size_t)(header.offA - header.offJA - sizeof(int)*matrix->nnz)
+      && fwrite(matrix->AElts, sizeof(PRIMME_NUM), matrix->nnz, f)
+            == (size_t)matrix->nnz;
+   if (fclose(f) != 0) ok = 0;
+   return ok ? 0 : -1;
+}
+
+/******************************************************************************
+ * Fills in the header fields, but the checksum, and places the sections.
+ *
+******************************************************************************/
+static void binSections(const CSRMatrix *matrix, CSRBinHeader *header) {
+
+#define ALIGN_BIN(X) (((X) + CSR_BIN_ALIGN - 1)/CSR_BIN_ALIGN*CSR_BIN_ALIGN)
+   memset(header, 0, sizeof(*header));
+   memcpy(header->magic, CSR_BIN_MAGIC, sizeof(header->magic));
+   header->version = CSR_BIN_VERSION;
+   header->byteOrder = CSR_BIN_BYTEORDER;
+   header->scalarSize = sizeof(PRIMME_NUM);
+   header->symmetric = matrix->symmetric ? 1 : 0;
+   header->m = matrix->m;
+   header->n = matrix->n;
+   header->nnz = matrix->nnz;
+   header->offIA = ALIGN_BIN(sizeof(CSRBinHeader));
+   header->offJA = ALIGN_BIN(header->offIA + sizeof(int32_t)*(matrix->m+1));
+   header->offA = ALIGN_BIN(header->offJA + sizeof(int32_t)*matrix->nnz);
+#undef ALIGN_BIN
+}
+
+/******************************************************************************
+ * Maps the whole file in memory and returns its size in *size, or NULL if
+ * it fails. The mapping is private, so changes to it (e.g., shiftCSRMatrix
+ * on a binary CSR matrix) are not written back to the file. Without mmap
+ * the file is read in a single block instead.
+ *
+******************************************************************************/
+static char *mapFile(const char *fileName, size_t *size) {
+
+   char *base;
+
+#ifdef CSR_HAVE_MMAP
+   int fd;
+   struct stat st;
+
+   fd = open(fileName, O_RDONLY);
+   if (fd < 0) return NULL;
+   if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      close(fd);
+      return NULL;
+   }
+   *size = (size_t)st.st_size;
+   base = (char *)mmap(NULL, *size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (base == (char *)MAP_FAILED) return NULL;
+#else
+   FILE *f;
+
+   f = fopen(fileName, "rb");
+   if (f == NULL) return NULL;
+   fseek(f, 0, SEEK_END);
+   *size = (size_t)ftell(f);
+   fseek(f, 0, SEEK_SET);
+   base = (char *)primme_calloc(*size > 0 ? *size : 1, 1, "file");
+   if (fread(base, 1, *size, f) != *size) {
+      fclose(f);
+      free(base);
+      return NULL;
+   }
+   fclose(f);
+#endif
+
+   return base;
+}
+
+static void unmapFile(char *base, size_t size) {
+
+#ifdef CSR_HAVE_MMAP
+   munmap(base, size);
+#else
+   (void)size;
+   free(base);
+#endif
+}
+
+/******************************************************************************
+ * Maps a binary CSR file and points the arrays of the matrix at it, after
+ * checking the header and the checksum.
+ *
+******************************************************************************/
+static int readBinaryCSR(const char *fileName, CSRMatrix *matrix) {
+
+   CSRBinHeader header, expected;
+   char *base;
+   size_t size;
+
+   base = mapFile(fileName, &size);
+   if (base == NULL) return -1;
+   if (size < sizeof(header)) {
+      unmapFile(base, size);
+      return -1;
+   }
+
+   matrix->mapping = base;
+   matrix->mappingSize = size;
+   memcpy(&header, base, sizeof(header));
+   if (memcmp(header.magic, CSR_BIN_MAGIC, sizeof(header.magic)) != 0
+         || header.version != CSR_BIN_VERSION
+         || header.byteOrder != CSR_BIN_BYTEORDER) {
+      fprintf(stderr, "ERROR: %s is not a binary CSR file of version %d "
+            "for this machine\n", fileName, CSR_BIN_VERSION);
+      return -1;
+   }
+   if (header.scalarSize != (int32_t)sizeof(PRIMME_NUM)) {
+      fprintf(stderr, "ERROR: %s has %s values\n", fileName,
+            header.scalarSize == 8 ? "real" : "complex");
+      return -1;
+   }
+
+   /* The sections must be where the writer puts them */
+   matrix->m = header.m;
+   matrix->n = header.n;
+   matrix->nnz = (int)header.nnz;
+   matrix->symmetric = header.symmetric;
+   binSections(matrix, &expected);
+   if (header.m < 0 || header.nnz < 0 || header.nnz != (int64_t)matrix->nnz
+         || header.offIA != expected.offIA || header.offJA != expected.offJA
+         || header.offA != expected.offA
+         || (size_t)header.offA + sizeof(PRIMME_NUM)*header.nnz > size) {
+      fprintf(stderr, "ERROR: %s is corrupted or truncated\n", fileName);
+      return -1;
+   }
+   matrix->IA = (int *)(base + header.offIA);
+   matrix->JA = (int *)(base + header.offJA);
+   matrix->AElts = (PRIMME_NUM *)(base + header.offA);
+
+   if (binChecksum(matrix) != header.checksum) {
+      fprintf(stderr, "ERROR: %s fails the checksum\n", fileName);
+      return -1;
+   }
+   return 0;
+}
+
+static uint64_t binChecksum(const CSRMatrix *matrix) {
+
+   uint64_t sum1 = 0, sum2 = 0;
 
+   fletcher64(matrix->IA, sizeof(int)*(matrix->m+1), &sum1, &sum2);
+   fletcher64(matrix->JA, sizeof(int)*matrix->nnz, &sum1, &sum2);
+   fletcher64(matrix->AElts, sizeof(PRIMME_NUM)*matrix->nnz, &sum1, &sum2);
+   return (sum2 << 32 | sum2 >> 32) ^ sum1;
+}
+
+static void fletcher64(const void *data, size_t bytes, uint64_t *sum1, uint64_t *sum2) {
+
+   const unsigned char *p = (const unsigned char *)data;
+   uint64_t w, a = *sum1, b = *sum2;
+   size_t i;
+
+   for (i=0; i+sizeof(w)<=bytes; i+=sizeof(w)) {
+      memcpy(&w, p+i, sizeof(w));
+      a += w;
+      b += a;
+   }
+   if (i < bytes) {
+      w = 0;
+      memcpy(&w, p+i, bytes-i);
+      a += w;
+      b += a;
+   }
+   *sum1 = a;
+   *sum2 = b;
+}
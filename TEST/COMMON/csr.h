@@ -28,6 +28,7 @@
 
 #ifndef CSR_H
 
+#include <stddef.h>
 #include "num.h"
 
 typedef struct {
@@ -37,9 +38,20 @@ typedef struct {
    int m; /* number of rows */
    int n; /* number of columns */
    int nnz;
+   int symmetric; /* if nonzero, only the diagonal and the upper triangle are
+                     stored (half storage), and A(j,i) = conj(A(i,j)) */
+   void *mapping; /* if not NULL, the block of a binary file that holds IA,
+                     JA and AElts */
+   size_t mappingSize;
 } CSRMatrix;
 
 int readMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm);
+int readSymMatrixNative(const char* matrixFileName, CSRMatrix **matrix_, double *fnorm);
+int expandSymCSRMatrix(const CSRMatrix *matrix, CSRMatrix **full);
+int permuteCSRMatrix(const CSRMatrix *matrix, const int *perm,
+                     CSRMatrix **permuted);
+int writeBinaryCSRMatrix(const char *fileName, const CSRMatrix *matrix);
+void destroyCSRMatrix(CSRMatrix *matrix);
 double frobeniusNorm(const CSRMatrix *matrix);
 void shiftCSRMatrix(double shift, CSRMatrix *matrix);
 
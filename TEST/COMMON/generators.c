@@ -0,0 +1,280 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: generators.c
+ *
+ * Purpose - Synthetic Hermitian matrices: finite difference Laplacians on
+ *           2D and 3D grids (also anisotropic), Laplacians of random graphs
+ *           and Anderson Hamiltonians. The complex versions of the last two
+ *           have magnetic phases on the edges, so that they are not real
+ *           matrices stored as complex ones.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "generators.h"
+#include "primme.h"
+
+#define TWO_PI 6.283185307179586
+
+typedef struct {
+   int col;
+   PRIMME_NUM val;
+} entry;
+
+static CSRMatrix *lattice(int nx, int ny, int nz, const double *diag,
+      const double *hop, double flux);
+static CSRMatrix *newCSRMatrix(int n, int nnz);
+static double uniform(unsigned long long *state);
+static PRIMME_NUM phase(double angle);
+static int compareEntries(const void *a, const void *b);
+
+/******************************************************************************
+ * Returns the 5-point (nz = 1) or 7-point stencil of
+ *
+ *    -(cx d^2/dx^2 + cy d^2/dy^2 + cz d^2/dz^2)
+ *
+ * on a nx x ny x nz grid with Dirichlet boundary conditions and unit
+ * spacing. Anisotropic diffusion is, e.g., cx = 1 and cy = 1e-2.
+ *
+******************************************************************************/
+int generateLaplacian(int nx, int ny, int nz, double cx, double cy, double cz,
+                      CSRMatrix **matrix) {
+
+   int i, n;
+   double *diag, hop[3];
+
+   if (nx < 1 || ny < 1 || nz < 1) return -1;
+   n = nx*ny*nz;
+   diag = (double *)primme_calloc(n, sizeof(double), "diag");
+   for (i=0; i<n; i++) {
+      diag[i] = 2.0*(cx + (ny > 1 ? cy : 0.0) + (nz > 1 ? cz : 0.0));
+   }
+   hop[0] = -cx; hop[1] = -cy; hop[2] = -cz;
+   *matrix = lattice(nx, ny, nz, diag, hop, 0.0);
+   free(diag);
+   return 0;
+}
+
+/******************************************************************************
+ * Returns the Laplacian D - W of a random graph with n vertices: a ring,
+ * which keeps it connected, plus (degree-2)/2 edges from each vertex to
+ * others taken at random; so the average degree is about degree. The
+ * weights of W are 1, or exp(i*theta) with random theta for complex
+ * matrices (the magnetic Laplacian), and D has the number of neighbors.
+ *
+******************************************************************************/
+int generateGraphLaplacian(int n, int degree, unsigned long seed,
+                           CSRMatrix **matrix) {
+
+   int i, j, k, e, extra, nnz, *start, *distinct, *ends;
+   unsigned long long state = seed;
+   entry *entries, *row;
+   PRIMME_NUM w;
+   CSRMatrix *A;
+
+   if (n < 3 || degree < 2) return -1;
+   extra = (degree - 2)/2;
+
+   /* Ring edge (i,i+1) and the random edges (i,ends(i*extra:..)) */
+   ends = (int *)primme_calloc((size_t)n*extra + 1, sizeof(int), "ends");
+   start = (int *)primme_calloc(n+1, sizeof(int), "start");
+   for (i=0; i<n; i++) start[i+1] += 2;
+   for (i=0, e=0; i<n; i++) {
+      for (k=0; k<extra; k++, e++) {
+         j = (int)(uniform(&state)*(n-1));
+         if (j >= i) j++;
+         ends[e] = j;
+         start[i+1]++;
+         start[j+1]++;
+      }
+   }
+   for (i=0; i<n; i++) start[i+1] += start[i];
+
+   /* Both directions of each edge, grouped by row */
+   entries = (entry *)primme_calloc(start[n], sizeof(entry), "entries");
+   distinct = (int *)primme_calloc(n, sizeof(int), "distinct");
+   for (i=0, e=0; i<n; i++) {
+      for (k=-1; k<extra; k++) {
+         j = k < 0 ? (i+1)%n : ends[e++];
+         w = phase(TWO_PI*uniform(&state));
+         entries[start[i]+distinct[i]].col = j;
+         entries[start[i]+distinct[i]++].val = -w;
+         entries[start[j]+distinct[j]].col = i;
+         entries[start[j]+distinct[j]++].val = -CONJ(w);
+      }
+   }
+
+   /* Sort each row and drop repeated edges */
+   for (i=0, nnz=0; i<n; i++) {
+      row = &entries[start[i]];
+      qsort(row, distinct[i], sizeof(entry), compareEntries);
+      for (j=0, k=0; j<distinct[i]; j++) {
+         if (k == 0 || row[j].col != row[k-1].col) row[k++] = row[j];
+      }
+      distinct[i] = k;
+      nnz += k + 1;
+   }
+
+   /* Insert the degree on the diagonal */
+   A = newCSRMatrix(n, nnz);
+   for (i=0, nnz=0; i<n; i++) {
+      row = &entries[start[i]];
+      A->IA[i] = nnz+1;
+      for (j=0; j<distinct[i] && row[j].col < i; j++) {
+         A->JA[nnz] = row[j].col+1;   A->AElts[nnz++] = row[j].val;
+      }
+      A->JA[nnz] = i+1;               A->AElts[nnz++] = distinct[i];
+      for (; j<distinct[i]; j++) {
+         A->JA[nnz] = row[j].col+1;   A->AElts[nnz++] = row[j].val;
+      }
+   }
+   A->IA[n] = nnz+1;
+
+   free(ends);
+   free(start);
+   free(distinct);
+   free(entries);
+   *matrix = A;
+   return 0;
+}
+
+/******************************************************************************
+ * Returns the Anderson Hamiltonian on a nx x nx x nx cubic lattice with open
+ * boundaries,
+ *
+ *    H = sum_i e_i |i><i| - sum_<ij> t_ij |i><j|,
+ *
+ * with on-site energies e_i uniform in [-disorder/2, disorder/2] and
+ * t_ij = 1, except along y in complex matrices, which get the phase
+ * exp(i*2*pi*flux*x) of a magnetic field along z. The flux is ignored for
+ * real matrices.
+ *
+******************************************************************************/
+int generateAnderson(int nx, double disorder, double flux, unsigned long seed,
+                     CSRMatrix **matrix) {
+
+   int i, n;
+   unsigned long long state = seed;
+   double *diag, hop[3] = {-1.0, -1.0, -1.0};
+
+   if (nx < 1) return -1;
+#ifndef USE_DOUBLECOMPLEX
+   flux = 0.0;
+#endif
+   n = nx*nx*nx;
+   diag = (double *)primme_calloc(n, sizeof(double), "diag");
+   for (i=0; i<n; i++) {
+      diag[i] = disorder*(uniform(&state) - 0.5);
+   }
+   *matrix = lattice(nx, nx, nx, diag, hop, flux);
+   free(diag);
+   return 0;
+}
+
+/******************************************************************************
+ * Returns the matrix of the nearest neighbor couplings on a nx x ny x nz
+ * grid, numbered first along x, with diag on the diagonal and hop[d] between
+ * neighbors along dimension d. The coupling from (x,y) to (x,y+1) is
+ * multiplied by exp(i*2*pi*flux*x).
+ *
+******************************************************************************/
+static CSRMatrix *lattice(int nx, int ny, int nz, const double *diag,
+      const double *hop, double flux) {
+
+   int i, x, y, z, nnz;
+   const int n = nx*ny*nz;
+   PRIMME_NUM *a;
+   CSRMatrix *A;
+
+   nnz = n + 2*((nx-1)*ny*nz + nx*(ny-1)*nz + nx*ny*(nz-1));
+   A = newCSRMatrix(n, nnz);
+   a = A->AElts;
+
+   for (z=0, i=0, nnz=0; z<nz; z++) {
+      for (y=0; y<ny; y++) {
+         for (x=0; x<nx; x++, i++) {
+            A->IA[i] = nnz+1;
+            if (z > 0) {
+               A->JA[nnz] = i-nx*ny+1;   a[nnz++] = hop[2];
+            }
+            if (y > 0) {
+               A->JA[nnz] = i-nx+1;      a[nnz++] = hop[1]*CONJ(phase(TWO_PI*flux*x));
+            }
+            if (x > 0) {
+               A->JA[nnz] = i;           a[nnz++] = hop[0];
+            }
+            A->JA[nnz] = i+1;            a[nnz++] = diag[i];
+            if (x < nx-1) {
+               A->JA[nnz] = i+2;         a[nnz++] = hop[0];
+            }
+            if (y < ny-1) {
+               A->JA[nnz] = i+nx+1;      a[nnz++] = hop[1]*phase(TWO_PI*flux*x);
+            }
+            if (z < nz-1) {
+               A->JA[nnz] = i+nx*ny+1;   a[nnz++] = hop[2];
+            }
+         }
+      }
+   }
+   A->IA[n] = nnz+1;
+   return A;
+}
+
+static CSRMatrix *newCSRMatrix(int n, int nnz) {
+
+   CSRMatrix *matrix;
+
+   matrix = (CSRMatrix *)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
+   matrix->m = matrix->n = n;
+   matrix->nnz = nnz;
+   matrix->IA = (int *)primme_calloc(n+1, sizeof(int), "IA");
+   matrix->JA = (int *)primme_calloc(nnz > 0 ? nnz : 1, sizeof(int), "JA");
+   matrix->AElts = (PRIMME_NUM *)primme_calloc(nnz > 0 ? nnz : 1,
+         sizeof(PRIMME_NUM), "AElts");
+   return matrix;
+}
+
+/******************************************************************************
+ * Returns a number uniform in [0,1) from a 64-bit linear congruential
+ * generator (Knuth's MMIX constants).
+ *
+******************************************************************************/
+static double uniform(unsigned long long *state) {
+   *state = *state*6364136223846793005ULL + 1442695040888963407ULL;
+   return (double)(*state >> 11)*(1.0/9007199254740992.0);
+}
+
+/* exp(i*angle) for complex matrices and 1 for real ones */
+static PRIMME_NUM phase(double angle) {
+#ifdef USE_DOUBLECOMPLEX
+   return cos(angle) + IMAGINARY*sin(angle);
+#else
+   (void)angle;
+   return 1.0;
+#endif
+}
+
+static int compareEntries(const void *a, const void *b) {
+   return ((const entry *)a)->col - ((const entry *)b)->col;
+}
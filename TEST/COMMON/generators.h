@@ -0,0 +1,45 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: generators.h
+ *
+ * Purpose - Definitions of the synthetic Hermitian matrices used by the
+ *           benchmarks.
+ *
+ ******************************************************************************/
+
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include "csr.h"
+
+/* The matrices have both triangles and the columns of each row sorted.
+   The random ones depend only on seed, not on the platform. */
+
+int generateLaplacian(int nx, int ny, int nz, double cx, double cy, double cz,
+                      CSRMatrix **matrix);
+int generateGraphLaplacian(int n, int degree, unsigned long seed,
+                           CSRMatrix **matrix);
+int generateAnderson(int nx, double disorder, double flux, unsigned long seed,
+                     CSRMatrix **matrix);
+
+#endif
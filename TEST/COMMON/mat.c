@@ -32,9 +32,35 @@
 #include <unistd.h>
 #include <string.h>
 #include <math.h>
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
 #include "native.h"
 
 static void getDiagonal(const CSRMatrix *matrix, double *diag);
+static void spmm_rows1(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, PRIMME_NUM *y);
+static void spmm_rows2(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy);
+static void spmm_rows4(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy);
+static void symm_rows(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy, int nv);
+static void symm_range1(const CSRMatrix *matrix, int r0, int r1,
+      const PRIMME_NUM *x, PRIMME_NUM *y, PRIMME_NUM *buf);
+static void symm_range4(const CSRMatrix *matrix, int r0, int r1,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy, PRIMME_NUM *buf,
+      int ldbuf);
+static int createILUTPrecFull(const CSRMatrix *matrix, double shift, int level,
+      double threshold, double filter, CSRMatrix **prec);
+static void levelSchedule(const CSRMatrix *factors, int upper, int *numLevels,
+      int **levelPtr, int **rows);
+static void ilu_lower_row(const CSRMatrix *factors, int i, int nv,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy);
+static void ilu_upper_row(const CSRMatrix *factors, int i, int nv,
+      PRIMME_NUM *y, int ldy);
+static void ilu_solve(const ILUTPrec *prec, int nv, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *y, int ldy);
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,12 +70,10 @@ extern "C" {
 void FORTRAN_FUNCTION(amux)(int*, double*, double*, double*, int*, int*);
 void FORTRAN_FUNCTION(ilut)(int*, double*, int*, int*, int*, double*, double*, int*, int*, int*,
                             double*, double*, int*, int*, int*, int*);
-void FORTRAN_FUNCTION(lusol0)(int*, double*, double*, double*, int*, int*);
 #else
 void FORTRAN_FUNCTION(zamux)(int*, PRIMME_NUM*, PRIMME_NUM*, PRIMME_NUM*, int*, int*);
 void FORTRAN_FUNCTION(zilut)(int*, PRIMME_NUM*, int*, int*, int*, double*, PRIMME_NUM*, int*, int*, int*,
                              PRIMME_NUM*, int*, int*);
-void FORTRAN_FUNCTION(zlusol)(int*, PRIMME_NUM*, PRIMME_NUM*, PRIMME_NUM*, int*, int*);
 #endif
 
 #ifdef __cplusplus
@@ -58,12 +82,294 @@ void FORTRAN_FUNCTION(zlusol)(int*, PRIMME_NUM*, PRIMME_NUM*, PRIMME_NUM*, int*,
 
 /******************************************************************************
  * Applies the matrix vector multiplication on a block of vectors.
- * Because a block function is not available, we call blockSize times
- * the SPARSKIT function amux(). Note the (void *) parameters x, y that must 
- * be cast as doubles for use in amux()
+ * The indices and values of each row are read once and applied to four
+ * vectors of the block (and to two or one for the rest), so the matrix is
+ * streamed from memory about blockSize/4 times instead of once per vector.
+ * If the driver is compiled with OpenMP, the rows are split among the
+ * threads. Vector i of x starts at x + (*ldx)*i and vector i of y at
+ * y + (*ldy)*i. Matrices in half storage go to symm_rows, four vectors at
+ * a time and one at a time for the rest.
  *
 ******************************************************************************/
-void CSRMatrixMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
+void CSRMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                     primme_params *primme) {
+
+   int k;
+   PRIMME_NUM *xvec, *yvec;
+   CSRMatrix *matrix;
+   
+   matrix = (CSRMatrix *)primme->matrix;
+   xvec = (PRIMME_NUM *)x;
+   yvec = (PRIMME_NUM *)y;
+
+   if (matrix->symmetric) {
+      for (k=0; k<*blockSize; k+=(*blockSize-k >= 4 ? 4 : 1)) {
+         symm_rows(matrix, primme->nLocal, &xvec[*ldx*k], *ldx, &yvec[*ldy*k],
+            *ldy, *blockSize-k >= 4 ? 4 : 1);
+      }
+      return;
+   }
+
+   for (k=0; k+4<=*blockSize; k+=4) {
+      spmm_rows4(matrix, primme->nLocal, &xvec[*ldx*k], *ldx, &yvec[*ldy*k],
+         *ldy);
+   }
+   if (k+2<=*blockSize) {
+      spmm_rows2(matrix, primme->nLocal, &xvec[*ldx*k], *ldx, &yvec[*ldy*k],
+         *ldy);
+      k += 2;
+   }
+   if (k<*blockSize) {
+      spmm_rows1(matrix, primme->nLocal, &xvec[*ldx*k], &yvec[*ldy*k]);
+   }
+}
+
+/******************************************************************************
+ * Computes y = A*x for one, two or four vectors. The sums of each row are
+ * kept in scalars, so they stay in registers, and the loop over the rows
+ * is split among the OpenMP threads. IA and JA hold Fortran indices.
+ *
+******************************************************************************/
+static void spmm_rows1(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, PRIMME_NUM *y) {
+
+   int i, j;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   const PRIMME_NUM *A = matrix->AElts;
+   PRIMME_NUM s0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(j,s0)
+#endif
+   for (i=0; i<nLocal; i++) {
+      s0 = 0.0;
+      for (j=IA[i]-1; j<IA[i+1]-1; j++) {
+         s0 += A[j]*x[JA[j]-1];
+      }
+      y[i] = s0;
+   }
+}
+
+static void spmm_rows2(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy) {
+
+   int i, j;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   const PRIMME_NUM *A = matrix->AElts, *xj;
+   PRIMME_NUM a, s0, s1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(j,a,xj,s0,s1)
+#endif
+   for (i=0; i<nLocal; i++) {
+      s0 = s1 = 0.0;
+      for (j=IA[i]-1; j<IA[i+1]-1; j++) {
+         a = A[j];
+         xj = &x[JA[j]-1];
+         s0 += a*xj[0];
+         s1 += a*xj[ldx];
+      }
+      y[i] = s0;
+      y[i+ldy] = s1;
+   }
+}
+
+static void spmm_rows4(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy) {
+
+   int i, j;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   const PRIMME_NUM *A = matrix->AElts, *xj;
+   PRIMME_NUM a, s0, s1, s2, s3;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(j,a,xj,s0,s1,s2,s3)
+#endif
+   for (i=0; i<nLocal; i++) {
+      s0 = s1 = s2 = s3 = 0.0;
+      for (j=IA[i]-1; j<IA[i+1]-1; j++) {
+         a = A[j];
+         xj = &x[JA[j]-1];
+         s0 += a*xj[0];
+         s1 += a*xj[ldx];
+         s2 += a*xj[2*ldx];
+         s3 += a*xj[3*ldx];
+      }
+      y[i] = s0;
+      y[i+ldy] = s1;
+      y[i+2*ldy] = s2;
+      y[i+3*ldy] = s3;
+   }
+}
+
+/******************************************************************************
+ * Computes y = A*x for nv = 1 or 4 vectors with A in half storage, A = D + U + U'
+ * with the diagonal D and the upper triangle U stored by rows, sorted by
+ * column. Every stored a_ij off the diagonal adds a_ij*x_j to y_i and
+ * conj(a_ij)*x_i to y_j, so the matrix is read once for both triangles.
+ *
+ * With OpenMP, each thread takes a range of rows [r0,r1) and updates rows
+ * j < r1 of y directly; these are all its own, as j > i >= r0. The updates
+ * of rows j >= r1 go to a buffer of the thread that spans from r1 to the
+ * last column in its rows, and after a barrier each thread adds to its rows
+ * the buffers of the threads before it. So no row is written by two threads
+ * at once, and for banded matrices the buffers are as short as the band.
+ *
+******************************************************************************/
+static void symm_rows(const CSRMatrix *matrix, int nLocal,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy, int nv) {
+
+#ifdef _OPENMP
+   int maxThreads = omp_get_max_threads();
+   PRIMME_NUM **buf;
+   int *lo, *hi;
+
+   buf = (PRIMME_NUM **)primme_calloc(maxThreads, sizeof(PRIMME_NUM *), "buf");
+   lo = (int *)primme_calloc(maxThreads, sizeof(int), "lo");
+   hi = (int *)primme_calloc(maxThreads, sizeof(int), "hi");
+
+#pragma omp parallel
+   {
+      const int *IA = matrix->IA, *JA = matrix->JA;
+      int t = omp_get_thread_num(), numThreads = omp_get_num_threads();
+      int r0 = (int)((long)nLocal*t/numThreads);
+      int r1 = (int)((long)nLocal*(t+1)/numThreads);
+      int i, s, v, h;
+
+      /* JA(IA(i+1)-1) is the last column of row i plus one in C indexing */
+      for (i=r0, h=r1; i<r1; i++) {
+         if (IA[i+1] > IA[i]) h = max(h, JA[IA[i+1]-2]);
+      }
+      lo[t] = r1;
+      hi[t] = h;
+      buf[t] = (PRIMME_NUM *)primme_calloc(max((size_t)(h-r1)*nv, 1),
+            sizeof(PRIMME_NUM), "buf");
+
+      for (v=0; v<nv; v++) {
+         for (i=r0; i<r1; i++) y[i+ldy*v] = 0.0;
+      }
+      if (nv == 4) symm_range4(matrix, r0, r1, x, ldx, y, ldy, buf[t], h-r1);
+      else symm_range1(matrix, r0, r1, x, y, buf[t]);
+
+#pragma omp barrier
+      for (s=0; s<t; s++) {
+         for (v=0; v<nv; v++) {
+            for (i=max(r0, lo[s]); i<min(r1, hi[s]); i++) {
+               y[i+ldy*v] += buf[s][i-lo[s]+(hi[s]-lo[s])*v];
+            }
+         }
+      }
+#pragma omp barrier
+      free(buf[t]);
+   }
+
+   free(buf);
+   free(lo);
+   free(hi);
+#else
+   int i, v;
+
+   for (v=0; v<nv; v++) {
+      for (i=0; i<nLocal; i++) y[i+ldy*v] = 0.0;
+   }
+   if (nv == 4) symm_range4(matrix, 0, nLocal, x, ldx, y, ldy, NULL, 0);
+   else symm_range1(matrix, 0, nLocal, x, y, NULL);
+#endif
+}
+
+/******************************************************************************
+ * Adds to y the products of rows r0 to r1-1 of the matrix in half storage,
+ * for one vector or for four. The updates of the rows j >= r1 go to
+ * buf(j-r1,:), with leading dimension ldbuf. As the columns are sorted, the
+ * entries of a row that update y come before the ones that update buf.
+ *
+******************************************************************************/
+static void symm_range1(const CSRMatrix *matrix, int r0, int r1,
+      const PRIMME_NUM *x, PRIMME_NUM *y, PRIMME_NUM *buf) {
+
+   int i, j, c, end;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   const PRIMME_NUM *A = matrix->AElts;
+   PRIMME_NUM a, s0, x0;
+
+   for (i=r0; i<r1; i++) {
+      x0 = x[i];
+      s0 = 0.0;
+      j = IA[i]-1;
+      end = IA[i+1]-1;
+      if (j < end && JA[j]-1 == i) {
+         s0 = A[j]*x0;
+         j++;
+      }
+      for (; j<end && (c = JA[j]-1) < r1; j++) {
+         a = A[j];
+         s0 += a*x[c];
+         y[c] += CONJ(a)*x0;
+      }
+      for (; j<end; j++) {
+         c = JA[j]-1;
+         a = A[j];
+         s0 += a*x[c];
+         buf[c-r1] += CONJ(a)*x0;
+      }
+      y[i] += s0;
+   }
+}
+
+static void symm_range4(const CSRMatrix *matrix, int r0, int r1,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy, PRIMME_NUM *buf,
+      int ldbuf) {
+
+   int i, j, c, end;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   const PRIMME_NUM *A = matrix->AElts, *xc;
+   PRIMME_NUM a, ac, s0, s1, s2, s3, x0, x1, x2, x3, *yc;
+
+   for (i=r0; i<r1; i++) {
+      x0 = x[i]; x1 = x[i+ldx]; x2 = x[i+2*ldx]; x3 = x[i+3*ldx];
+      s0 = s1 = s2 = s3 = 0.0;
+      j = IA[i]-1;
+      end = IA[i+1]-1;
+      if (j < end && JA[j]-1 == i) {
+         a = A[j];
+         s0 = a*x0; s1 = a*x1; s2 = a*x2; s3 = a*x3;
+         j++;
+      }
+      for (; j<end && (c = JA[j]-1) < r1; j++) {
+         a = A[j];
+         ac = CONJ(a);
+         xc = &x[c];
+         yc = &y[c];
+         s0 += a*xc[0];      yc[0]     += ac*x0;
+         s1 += a*xc[ldx];    yc[ldy]   += ac*x1;
+         s2 += a*xc[2*ldx];  yc[2*ldy] += ac*x2;
+         s3 += a*xc[3*ldx];  yc[3*ldy] += ac*x3;
+      }
+      for (; j<end; j++) {
+         c = JA[j]-1;
+         a = A[j];
+         ac = CONJ(a);
+         xc = &x[c];
+         yc = &buf[c-r1];
+         s0 += a*xc[0];      yc[0]       += ac*x0;
+         s1 += a*xc[ldx];    yc[ldbuf]   += ac*x1;
+         s2 += a*xc[2*ldx];  yc[2*ldbuf] += ac*x2;
+         s3 += a*xc[3*ldx];  yc[3*ldbuf] += ac*x3;
+      }
+      y[i] += s0; y[i+ldy] += s1; y[i+2*ldy] += s2; y[i+3*ldy] += s3;
+   }
+}
+
+/******************************************************************************
+ * Applies the matrix vector multiplication on a block of vectors calling
+ * blockSize times the SPARSKIT function amux(), which streams the matrix
+ * once per vector. Selected with driver.matrixChoice = native_amux. Note
+ * the (void *) parameters x, y that must be cast as doubles for use in
+ * amux().
+ *
+******************************************************************************/
+void CSRMatrixMatvecAmux(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                         primme_params *primme) {
    
    int i;
    PRIMME_NUM *xvec, *yvec;
@@ -79,7 +385,7 @@ void CSRMatrixMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
 #else
       FORTRAN_FUNCTION(zamux)
 #endif
-            (&primme->n, &xvec[primme->nLocal*i], &yvec[primme->nLocal*i], 
+            (&primme->n, &xvec[*ldx*i], &yvec[*ldy*i], 
              matrix->AElts, matrix->JA, matrix->IA);
    }
 }
@@ -107,8 +413,8 @@ int createInvDiagPrecNative(const CSRMatrix *matrix, double shift, double **prec
    return 1;
 }
 
-void ApplyInvDiagPrecNative(void *x, void *y, int *blockSize, 
-                                        primme_params *primme) {
+void ApplyInvDiagPrecNative(void *x, int *ldx, void *y, int *ldy,
+                            int *blockSize, primme_params *primme) {
    int i, j;
    double *diag;
    PRIMME_NUM *xvec, *yvec;
@@ -120,7 +426,7 @@ void ApplyInvDiagPrecNative(void *x, void *y, int *blockSize,
 
    for (i=0; i<bs; i++)
       for (j=0; j<nLocal; j++)
-         yvec[primme->n*i+j] = xvec[primme->n*i+j]/diag[j];
+         yvec[*ldy*i+j] = xvec[*ldx*i+j]/diag[j];
 }
 
 /******************************************************************************
@@ -145,8 +451,8 @@ int createInvDavidsonDiagPrecNative(const CSRMatrix *matrix, double **prec) {
    return 1;
 }
 
-void ApplyInvDavidsonDiagPrecNative(void *x, void *y, int *blockSize, 
-                                        primme_params *primme) {
+void ApplyInvDavidsonDiagPrecNative(void *x, int *ldx, void *y, int *ldy,
+                                    int *blockSize, primme_params *primme) {
    int i, j;
    double *diag, shift, d, minDenominator;
    PRIMME_NUM *xvec, *yvec;
@@ -162,7 +468,7 @@ void ApplyInvDavidsonDiagPrecNative(void *x, void *y, int *blockSize,
       for (j=0; j<nLocal; j++) {
          d = diag[j] - shift;
          d = (fabs(d) > minDenominator) ? d : copysign(minDenominator, d);
-         yvec[primme->n*i+j] = xvec[primme->n*i+j]/d;
+         yvec[*ldy*i+j] = xvec[*ldx*i+j]/d;
       }
    }
 }
@@ -173,11 +479,101 @@ void ApplyInvDavidsonDiagPrecNative(void *x, void *y, int *blockSize,
  *    y(i) = U^(-1)*( L^(-1)*x(i)), i=1:blockSize, 
  *    with L,U = ilut(A-shift) 
  * 
- * It calls the SPARSKIT lusol0 function for each block vector.
+ * The factors come from the SPARSKIT ilut. The forward and backward solves
+ * are done as SPARSKIT lusol0 on up to ILU_BLOCK vectors at once, and by
+ * levels in parallel if there is more than one OpenMP thread. Each entry
+ * of the solution is computed with the same operations in the same order
+ * as lusol0, whatever the number of threads.
  *
 ******************************************************************************/
 
+#define ILU_BLOCK      4    /* vectors solved at once */
+#define ILU_LEVEL_ROWS 64   /* average rows per level to solve by levels */
+
 int createILUTPrecNative(const CSRMatrix *matrix, double shift, int level,
+                         double threshold, double filter, ILUTPrec **prec_) {
+   int ret;
+   CSRMatrix *full, *factors;
+   ILUTPrec *prec;
+
+   if (!matrix->symmetric) {
+      ret = createILUTPrecFull(matrix, shift, level, threshold, filter,
+            &factors);
+   }
+   else {
+      /* ILUT needs both triangles, so a matrix in half storage is expanded */
+      expandSymCSRMatrix(matrix, &full);
+      ret = createILUTPrecFull(full, shift, level, threshold, filter,
+            &factors);
+      destroyCSRMatrix(full);
+   }
+   if (ret != 0) return ret;
+
+   prec = (ILUTPrec *)primme_calloc(1, sizeof(ILUTPrec), "ILUTPrec");
+   prec->factors = factors;
+   levelSchedule(factors, 0, &prec->numLevelsL, &prec->levelL, &prec->rowsL);
+   levelSchedule(factors, 1, &prec->numLevelsU, &prec->levelU, &prec->rowsU);
+   *prec_ = prec;
+   return 0;
+}
+
+void destroyILUTPrecNative(ILUTPrec *prec) {
+
+   free(prec->factors->AElts);
+   free(prec->factors->IA);
+   free(prec->factors->JA);
+   free(prec->factors);
+   free(prec->levelL);
+   free(prec->rowsL);
+   free(prec->levelU);
+   free(prec->rowsU);
+   free(prec);
+}
+
+/******************************************************************************
+ * Groups the rows of L (or U if upper) by levels: a row is in the level
+ * after the last one of the rows it needs. The rows of each level keep
+ * their order.
+ *
+******************************************************************************/
+static void levelSchedule(const CSRMatrix *factors, int upper, int *numLevels,
+      int **levelPtr_, int **rows_) {
+
+   int i, k, l, n = factors->n, *level, *levelPtr, *rows;
+   const int *jlu = factors->JA, *ju = factors->IA;
+
+   level = (int *)primme_calloc(n, sizeof(int), "level");
+   *numLevels = 0;
+   for (l=0; l<n; l++) {
+      i = upper ? n-1-l : l;
+      level[i] = 0;
+      if (upper) {
+         for (k=ju[i]-1; k<jlu[i+1]-1; k++) {
+            level[i] = max(level[i], level[jlu[k]-1]+1);
+         }
+      }
+      else {
+         for (k=jlu[i]-1; k<ju[i]-1; k++) {
+            level[i] = max(level[i], level[jlu[k]-1]+1);
+         }
+      }
+      *numLevels = max(*numLevels, level[i]+1);
+   }
+
+   levelPtr = (int *)primme_calloc(*numLevels+1, sizeof(int), "levelPtr");
+   rows = (int *)primme_calloc(n, sizeof(int), "rows");
+   for (i=0; i<n; i++) levelPtr[level[i]+1]++;
+   for (l=0; l<*numLevels; l++) levelPtr[l+1] += levelPtr[l];
+   for (i=0; i<n; i++) rows[levelPtr[level[i]]++] = i;
+   for (l=*numLevels; l>0; l--) levelPtr[l] = levelPtr[l-1];
+   levelPtr[0] = 0;
+
+   free(level);
+   *levelPtr_ = levelPtr;
+   *rows_ = rows;
+}
+
+static int createILUTPrecFull(const CSRMatrix *matrix, double shift, int level,
                          double threshold, double filter, CSRMatrix **prec) {
 #ifdef USE_DOUBLECOMPLEX
    int ierr;
@@ -274,24 +670,121 @@ int createILUTPrecNative(const CSRMatrix *matrix, double shift, int level,
 #endif
 }
 
-void ApplyILUTPrecNative(void *x, void *y, int *blockSize, primme_params *primme) {
+void ApplyILUTPrecNative(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                         primme_params *primme) {
    int i;
    PRIMME_NUM *xvec, *yvec;
-   CSRMatrix *prec;
+   ILUTPrec *prec;
    
-   prec = (CSRMatrix *)primme->preconditioner;
+   prec = (ILUTPrec *)primme->preconditioner;
    xvec = (PRIMME_NUM *)x;
    yvec = (PRIMME_NUM *)y;
 
-   for (i=0; i<*blockSize; i++) {
-#ifdef USE_DOUBLECOMPLEX
-      FORTRAN_FUNCTION(zlusol)
-#else
-      FORTRAN_FUNCTION(lusol0)
+   for (i=0; i<*blockSize; i+=ILU_BLOCK) {
+      ilu_solve(prec, min(ILU_BLOCK, *blockSize-i), &xvec[*ldx*i], *ldx,
+            &yvec[*ldy*i], *ldy);
+   }
+}
+
+/******************************************************************************
+ * Solves L*U*y = x for nv <= ILU_BLOCK vectors. With more than one OpenMP
+ * thread, the rows of each level are split among the threads, with a
+ * barrier between levels; otherwise, or if the levels have on average
+ * fewer than ILU_LEVEL_ROWS rows and the barriers would cost more than
+ * the rows, the rows go in order, as in lusol0.
+ *
+******************************************************************************/
+static void ilu_solve(const ILUTPrec *prec, int nv, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *y, int ldy) {
+
+   int i, n = prec->factors->n;
+
+#ifdef _OPENMP
+   if (omp_get_max_threads() > 1 && !omp_in_parallel()
+         && n >= ILU_LEVEL_ROWS*max(prec->numLevelsL, prec->numLevelsU)) {
+#pragma omp parallel private(i)
+      {
+         int l;
+         for (l=0; l<prec->numLevelsL; l++) {
+#pragma omp for schedule(static)
+            for (i=prec->levelL[l]; i<prec->levelL[l+1]; i++) {
+               ilu_lower_row(prec->factors, prec->rowsL[i], nv, x, ldx, y,
+                     ldy);
+            }
+         }
+         for (l=0; l<prec->numLevelsU; l++) {
+#pragma omp for schedule(static)
+            for (i=prec->levelU[l]; i<prec->levelU[l+1]; i++) {
+               ilu_upper_row(prec->factors, prec->rowsU[i], nv, y, ldy);
+            }
+         }
+      }
+      return;
+   }
 #endif
-             (&primme->n, &xvec[primme->n*i], &yvec[primme->n*i],
-              prec->AElts, prec->JA, prec->IA);
+
+   for (i=0; i<n; i++) {
+      ilu_lower_row(prec->factors, i, nv, x, ldx, y, ldy);
+   }
+   for (i=n-1; i>=0; i--) {
+      ilu_upper_row(prec->factors, i, nv, y, ldy);
+   }
+}
+
+/******************************************************************************
+ * Forward solve of row i: y(i,:) = x(i,:) - L(i,1:i-1)*y(1:i-1,:).
+ *
+******************************************************************************/
+static void ilu_lower_row(const CSRMatrix *factors, int i, int nv,
+      const PRIMME_NUM *x, int ldx, PRIMME_NUM *y, int ldy) {
+
+   int k, c, v;
+   const int *jlu = factors->JA, *ju = factors->IA;
+   const PRIMME_NUM *alu = factors->AElts;
+   PRIMME_NUM a, t[ILU_BLOCK];
+
+   if (nv == 1) {
+      a = x[i];
+      for (k=jlu[i]-1; k<ju[i]-1; k++) a -= alu[k]*y[jlu[k]-1];
+      y[i] = a;
+      return;
+   }
+
+   for (v=0; v<nv; v++) t[v] = x[ldx*v+i];
+   for (k=jlu[i]-1; k<ju[i]-1; k++) {
+      c = jlu[k]-1;
+      a = alu[k];
+      for (v=0; v<nv; v++) t[v] -= a*y[ldy*v+c];
+   }
+   for (v=0; v<nv; v++) y[ldy*v+i] = t[v];
+}
+
+/******************************************************************************
+ * Backward solve of row i: y(i,:) = (y(i,:) - U(i,i+1:n)*y(i+1:n,:))/U(i,i).
+ *
+******************************************************************************/
+static void ilu_upper_row(const CSRMatrix *factors, int i, int nv,
+      PRIMME_NUM *y, int ldy) {
+
+   int k, c, v;
+   const int *jlu = factors->JA, *ju = factors->IA;
+   const PRIMME_NUM *alu = factors->AElts;
+   PRIMME_NUM a, t[ILU_BLOCK];
+
+   if (nv == 1) {
+      a = y[i];
+      for (k=ju[i]-1; k<jlu[i+1]-1; k++) a -= alu[k]*y[jlu[k]-1];
+      y[i] = alu[i]*a;
+      return;
+   }
+
+   for (v=0; v<nv; v++) t[v] = y[ldy*v+i];
+   for (k=ju[i]-1; k<jlu[i+1]-1; k++) {
+      c = jlu[k]-1;
+      a = alu[k];
+      for (v=0; v<nv; v++) t[v] -= a*y[ldy*v+c];
    }
+   for (v=0; v<nv; v++) y[ldy*v+i] = alu[i]*t[v];
 }
 
 
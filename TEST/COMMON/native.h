@@ -32,16 +32,36 @@
 #include "csr.h"
 #include "primme.h"
 
-void CSRMatrixMatvec(void *x, void *y, int *blockSize, primme_params *primme);
+/* ILUT factors in the modified sparse row format of SPARSKIT: row i of L
+   is factors->AElts[jlu[i]-1:ju[i]-2] with columns jlu[jlu[i]-1:ju[i]-2],
+   row i of U follows up to jlu[i+1]-2, and AElts[i] is the inverse of the
+   diagonal of U, with jlu = factors->JA and ju = factors->IA. The rows in
+   rowsL[levelL[l]:levelL[l+1]-1] only need rows of previous levels in the
+   forward solve, and so do the rows of each level of U in the backward
+   solve; the rows of each level are solved in parallel with OpenMP. */
+
+typedef struct {
+   CSRMatrix *factors;
+   int numLevelsL, numLevelsU;
+   int *levelL, *rowsL;
+   int *levelU, *rowsU;
+} ILUTPrec;
+
+void CSRMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                     primme_params *primme);
+void CSRMatrixMatvecAmux(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                         primme_params *primme);
 int createInvDiagPrecNative(const CSRMatrix *matrix, double shift, double **prec);
-void ApplyInvDiagPrecNative(void *x, void *y, int *blockSize, 
-                                        primme_params *primme);
+void ApplyInvDiagPrecNative(void *x, int *ldx, void *y, int *ldy,
+                            int *blockSize, primme_params *primme);
 int createInvDavidsonDiagPrecNative(const CSRMatrix *matrix, double **prec);
-void ApplyInvDavidsonDiagPrecNative(void *x, void *y, int *blockSize, 
-                                        primme_params *primme);
+void ApplyInvDavidsonDiagPrecNative(void *x, int *ldx, void *y, int *ldy,
+                                    int *blockSize, primme_params *primme);
 int createILUTPrecNative(const CSRMatrix *matrix, double shift, int level,
-                         double threshold, double filter, CSRMatrix **prec);
-void ApplyILUTPrecNative(void *x, void *y, int *blockSize, primme_params *primme);
+                         double threshold, double filter, ILUTPrec **prec);
+void ApplyILUTPrecNative(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                         primme_params *primme);
+void destroyILUTPrecNative(ILUTPrec *prec);
 
 #endif
 
@@ -302,8 +302,8 @@ static ParaSails* generate_precond(CSRMatrix *matrix, double shift, int n, int p
  * the Parasails function MatrixMatvec()
  *
 ******************************************************************************/
-void ParaSailsMatrixMatvec(void *x, void *y, int *blockSize, 
-   primme_params *primme) {
+void ParaSailsMatrixMatvec(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, primme_params *primme) {
    
    int i;
    double *xvec, *yvec;
@@ -311,8 +311,8 @@ void ParaSailsMatrixMatvec(void *x, void *y, int *blockSize,
    yvec = (double *)y;
 
    for (i=0;i<*blockSize;i++) {
-      MatrixMatvec(primme->matrix, &xvec[primme->nLocal*i], 
-                                         &yvec[primme->nLocal*i]);
+      MatrixMatvec(primme->matrix, &xvec[*ldx*i], 
+                                         &yvec[*ldy*i]);
    }
 
 }
@@ -323,7 +323,7 @@ void ParaSailsMatrixMatvec(void *x, void *y, int *blockSize,
  * block vector.
  *
 ******************************************************************************/
-void ApplyPrecParaSails(void *x, void *y, int *blockSize,
+void ApplyPrecParaSails(void *x, int *ldx, void *y, int *ldy, int *blockSize,
    primme_params *primme) {
 
    int i;
@@ -332,7 +332,7 @@ void ApplyPrecParaSails(void *x, void *y, int *blockSize,
    yvec = (double *)y;
 
    for (i=0;i<*blockSize;i++) {
-     ParaSailsApply(primme->preconditioner, &xvec[primme->nLocal*i], 
-                                                 &yvec[primme->nLocal*i]);
+     ParaSailsApply(primme->preconditioner, &xvec[*ldx*i], 
+                                                 &yvec[*ldy*i]);
    }
 }
@@ -38,9 +38,9 @@ int readMatrixAndPrecondParaSails(const char* matrixFileName, double shift,
                                   int isymm, MPI_Comm comm, double *fnorm,
                                   int *n, int *nLocal_, int *numProc_, int *procID_,
                                   Matrix **pmatrix, ParaSails **pfactor);
-void ParaSailsMatrixMatvec(void *x, void *y, int *blockSize, 
-                           primme_params *primme);
-void ApplyPrecParaSails(void *x, void *y, int *blockSize,
+void ParaSailsMatrixMatvec(void *x, int *ldx, void *y, int *ldy,
+                           int *blockSize, primme_params *primme);
+void ApplyPrecParaSails(void *x, int *ldx, void *y, int *ldy, int *blockSize,
    primme_params *primme);
 
 #define PARASAILS_H
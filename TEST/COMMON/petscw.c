@@ -281,7 +281,8 @@ static PetscErrorCode permutematrix(Mat Ain, Mat Bin, Mat *Aout, Mat *Bout, int
 }
 
 
-void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
+void PETScMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                 primme_params *primme) {
    int i;
    Mat *matrix;
    Vec xvec, yvec;
@@ -292,8 +293,8 @@ void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
 
    ierr = MatCreateVecs(*matrix, &xvec, &yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
    for (i=0; i<*blockSize; i++) {
-      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
-      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + *ldx*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + *ldy*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = MatMult(*matrix, xvec, yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(xvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
@@ -302,7 +303,8 @@ void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
    ierr = VecDestroy(&yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
 }
 
-void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme) {
+void ApplyPCPrecPETSC(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                      primme_params *primme) {
    int i;
    Mat *matrix;
    PC *pc;
@@ -315,8 +317,8 @@ void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme) {
 
    ierr = MatCreateVecs(*matrix, &xvec, &yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
    for (i=0; i<*blockSize; i++) {
-      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
-      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + *ldx*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + *ldy*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = PCApply(*pc, xvec, yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(xvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
@@ -325,8 +327,8 @@ void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme) {
    ierr = VecDestroy(&yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
 }
 
-void ApplyInvDavidsonDiagPrecPETSc(void *x, void *y, int *blockSize, 
-                                        primme_params *primme) {
+void ApplyInvDavidsonDiagPrecPETSc(void *x, int *ldx, void *y, int *ldy,
+                                   int *blockSize, primme_params *primme) {
    int i, j;
    double shift, d, minDenominator;
    PRIMME_NUM *xvec, *yvec;
@@ -346,7 +348,7 @@ void ApplyInvDavidsonDiagPrecPETSc(void *x, void *y, int *blockSize,
       for (j=0; j<nLocal; j++) {
          d = diag[j] - shift;
          d = (fabs(d) > minDenominator) ? d : copysign(minDenominator, d);
-         yvec[primme->n*i+j] = xvec[primme->n*i+j]/d;
+         yvec[*ldy*i+j] = xvec[*ldx*i+j]/d;
       }
    }
    ierr = VecRestoreArrayRead(vec, &diag); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
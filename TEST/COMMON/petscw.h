@@ -35,8 +35,10 @@
 
 int readMatrixPetsc(const char* matrixFileName, int *m, int *n, int *mLocal, int *nLocal,
                     int *numProcs, int *procID, Mat **matrix, double *fnorm_, int **perm);
-void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme);
-void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme);
+void PETScMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                 primme_params *primme);
+void ApplyPCPrecPETSC(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                      primme_params *primme);
 
 #define PETSCW_H
 #endif
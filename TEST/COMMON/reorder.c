@@ -0,0 +1,337 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: reorder.c
+ * 
+ * Purpose - Bandwidth reducing (reverse Cuthill-McKee) and nested dissection
+ *           orderings of the graph of a CSR matrix. Both use the level
+ *           structures of breadth-first searches rooted at pseudo-peripheral
+ *           vertices, found as in George and Liu (1979).
+ * 
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "reorder.h"
+#include "primme.h"
+
+#define ND_LEAF_SIZE 32   /* subgraphs not split further by ndOrdering */
+
+typedef struct {
+   int n;
+   int *xadj;   /* vertex v is adjacent to adj[xadj[v]:xadj[v+1]-1] */
+   int *adj;
+} graph;
+
+static int buildGraph(const CSRMatrix *matrix, graph *g);
+static int levelStructure(const graph *g, int root, const int *sub, int id,
+      int *order, int *level, int *numLevels);
+static int pseudoPeripheral(const graph *g, int start, const int *sub, int id,
+      int *order, int *level);
+static void dissect(const graph *g, int *verts, int num, int *sub,
+      int *nextId, int *order, int *level, int *tmp);
+
+/******************************************************************************
+ * Reverse Cuthill-McKee ordering. Each connected component is numbered by
+ * a breadth-first search from a pseudo-peripheral vertex that visits the
+ * neighbors of each vertex by increasing degree, and the whole numbering
+ * is reversed at the end.
+ *
+******************************************************************************/
+int rcmOrdering(const CSRMatrix *matrix, int *perm) {
+
+   graph g;
+   int *order, *level, *visited;
+   int i, j, s, v, u, head, pos, first;
+
+   if (buildGraph(matrix, &g) != 0) return -1;
+   order = (int *)primme_calloc(g.n, sizeof(int), "order");
+   level = (int *)primme_calloc(g.n, sizeof(int), "level");
+   visited = (int *)primme_calloc(g.n, sizeof(int), "visited");
+   for (i=0; i<g.n; i++) level[i] = -1;
+
+   for (s=0, pos=0; s<g.n; s++) {
+      if (visited[s]) continue;
+      head = pos;
+      perm[pos] = pseudoPeripheral(&g, s, NULL, 0, order, level);
+      visited[perm[pos++]] = 1;
+      while (head < pos) {
+         v = perm[head++];
+         first = pos;
+         for (j=g.xadj[v]; j<g.xadj[v+1]; j++) {
+            if (visited[u = g.adj[j]]) continue;
+            visited[u] = 1;
+            /* Insert u among the new neighbors sorted by degree */
+            for (i=pos++; i>first && g.xadj[perm[i-1]+1] - g.xadj[perm[i-1]]
+                  > g.xadj[u+1] - g.xadj[u]; i--) {
+               perm[i] = perm[i-1];
+            }
+            perm[i] = u;
+         }
+      }
+   }
+
+   for (i=0; i<g.n/2; i++) {
+      v = perm[i]; perm[i] = perm[g.n-1-i]; perm[g.n-1-i] = v;
+   }
+
+   free(order);
+   free(level);
+   free(visited);
+   free(g.xadj);
+   free(g.adj);
+   return 0;
+}
+
+/******************************************************************************
+ * Nested dissection ordering. A subgraph is split by a level of the level
+ * structure rooted at a pseudo-peripheral vertex, the one that leaves
+ * about half of the vertices on each side; the vertices of that level
+ * that are not adjacent to the next one move to the first side. Both sides
+ * are numbered recursively and the separator last. Small subgraphs keep
+ * the breadth-first order, so that the ordering is also local at every
+ * scale. It does not need METIS and its separators are larger, but it is
+ * enough for the locality of the products and of ILUT.
+ *
+******************************************************************************/
+int ndOrdering(const CSRMatrix *matrix, int *perm) {
+
+   graph g;
+   int *order, *level, *sub, *tmp;
+   int i, nextId = 0;
+
+   if (buildGraph(matrix, &g) != 0) return -1;
+   order = (int *)primme_calloc(g.n, sizeof(int), "order");
+   level = (int *)primme_calloc(g.n, sizeof(int), "level");
+   sub = (int *)primme_calloc(g.n, sizeof(int), "sub");
+   tmp = (int *)primme_calloc(g.n, sizeof(int), "tmp");
+   for (i=0; i<g.n; i++) {
+      level[i] = -1;
+      perm[i] = i;
+   }
+
+   dissect(&g, perm, g.n, sub, &nextId, order, level, tmp);
+
+   free(order);
+   free(level);
+   free(sub);
+   free(tmp);
+   free(g.xadj);
+   free(g.adj);
+   return 0;
+}
+
+/******************************************************************************
+ * Numbers the vertices verts[0:num-1], which are the ones with sub[v] equal
+ * to a new id, reordering them in place. order, level and tmp are work
+ * arrays of size n, with level[v] = -1 for all v on entry and on exit.
+ *
+******************************************************************************/
+static void dissect(const graph *g, int *verts, int num, int *sub,
+      int *nextId, int *order, int *level, int *tmp) {
+
+   int i, j, v, id, root, count, numLevels, sepLevel, numA, numB, numS, sum;
+
+   /* The second side is numbered in the loop, not by recursion, as there
+      may be as many as there are connected components */
+   while (num > 1) {
+      id = ++*nextId;
+      for (i=0; i<num; i++) sub[verts[i]] = id;
+
+      root = pseudoPeripheral(g, verts[0], sub, id, order, level);
+      count = levelStructure(g, root, sub, id, order, level, &numLevels);
+
+      /* A small or shallow connected subgraph is numbered in breadth-first
+         order; if it is not all of the subgraph, the rest is not connected
+         to it and goes to the second side */
+      if (count <= ND_LEAF_SIZE || numLevels < 3) {
+         if (count == num) {
+            for (i=0; i<num; i++) verts[i] = order[i];
+            for (i=0; i<count; i++) level[order[i]] = -1;
+            return;
+         }
+         sepLevel = numLevels;
+      }
+      else {
+         /* First level with more than half of the vertices up to it */
+         for (sepLevel=0, sum=0, i=0; i<count; i++) {
+            if (level[order[i]] != sepLevel) {
+               if (sum > count/2) break;
+               sepLevel = level[order[i]];
+            }
+            sum++;
+         }
+         sepLevel = min(max(sepLevel, 1), numLevels-2);
+
+         /* Mark the vertices of the separator with level -2 */
+         for (i=0; i<count; i++) {
+            v = order[i];
+            if (level[v] != sepLevel) continue;
+            for (j=g->xadj[v]; j<g->xadj[v+1]; j++) {
+               if (sub[g->adj[j]] == id && level[g->adj[j]] == sepLevel+1) {
+                  level[v] = -2;
+                  break;
+               }
+            }
+         }
+      }
+
+      /* Place the first side (levels up to sepLevel), then the second one
+         (the rest and the vertices not reached) and then the separator */
+      numA = numB = numS = 0;
+      for (i=0; i<count; i++) {
+         if (level[order[i]] >= 0 && level[order[i]] <= sepLevel) {
+            tmp[numA++] = order[i];
+         }
+      }
+      for (i=0; i<count; i++) {
+         if (level[order[i]] > sepLevel) tmp[numA + numB++] = order[i];
+      }
+      for (i=0; i<num; i++) {
+         if (level[verts[i]] == -1) tmp[numA + numB++] = verts[i];
+      }
+      for (i=0; i<count; i++) {
+         if (level[order[i]] == -2) tmp[numA + numB + numS++] = order[i];
+      }
+      for (i=0; i<num; i++) verts[i] = tmp[i];
+      for (i=0; i<count; i++) level[order[i]] = -1;
+
+      dissect(g, verts, numA, sub, nextId, order, level, tmp);
+      verts += numA;
+      num = numB;
+   }
+}
+
+/******************************************************************************
+ * Breadth-first search from root over the vertices with sub[v] equal to id
+ * (all if sub is NULL). It returns the number of vertices reached, in
+ * order, sets level[v] to their distance to root, and the number of
+ * levels in numLevels. The caller has to reset level to -1 afterwards.
+ *
+******************************************************************************/
+static int levelStructure(const graph *g, int root, const int *sub, int id,
+      int *order, int *level, int *numLevels) {
+
+   int j, u, v, head, count;
+
+   order[0] = root;
+   level[root] = 0;
+   for (head=0, count=1; head<count; head++) {
+      v = order[head];
+      for (j=g->xadj[v]; j<g->xadj[v+1]; j++) {
+         u = g->adj[j];
+         if (level[u] >= 0 || (sub && sub[u] != id)) continue;
+         level[u] = level[v] + 1;
+         order[count++] = u;
+      }
+   }
+   *numLevels = level[order[count-1]] + 1;
+   return count;
+}
+
+/******************************************************************************
+ * Returns a vertex of large eccentricity in the component of start: while
+ * the level structure rooted at the vertex of minimum degree of the last
+ * level is deeper, move the root to that vertex.
+ *
+******************************************************************************/
+static int pseudoPeripheral(const graph *g, int start, const int *sub, int id,
+      int *order, int *level) {
+
+   int i, v, root, next, count, numLevels, newLevels, minDegree;
+
+   root = start;
+   count = levelStructure(g, root, sub, id, order, level, &numLevels);
+   while (1) {
+      next = -1;
+      minDegree = g->n + 1;
+      for (i=count-1; i>=0 && level[v = order[i]] == numLevels-1; i--) {
+         if (g->xadj[v+1] - g->xadj[v] < minDegree) {
+            minDegree = g->xadj[v+1] - g->xadj[v];
+            next = v;
+         }
+      }
+      for (i=0; i<count; i++) level[order[i]] = -1;
+      if (next == root) break;
+      count = levelStructure(g, next, sub, id, order, level, &newLevels);
+      if (newLevels <= numLevels) {
+         for (i=0; i<count; i++) level[order[i]] = -1;
+         break;
+      }
+      root = next;
+      numLevels = newLevels;
+   }
+   return root;
+}
+
+/******************************************************************************
+ * Builds the graph of A+A', without loops and repeated edges.
+ *
+******************************************************************************/
+static int buildGraph(const CSRMatrix *matrix, graph *g) {
+
+   int i, j, k, c, pos, *mark, *next;
+
+   if (matrix->m != matrix->n) {
+      fprintf(stderr, "ERROR: only square matrices can be reordered\n");
+      return -1;
+   }
+   g->n = matrix->n;
+   g->xadj = (int *)primme_calloc(g->n+1, sizeof(int), "xadj");
+   for (i=0; i<g->n; i++) {
+      for (k=matrix->IA[i]-1; k<matrix->IA[i+1]-1; k++) {
+         c = matrix->JA[k]-1;
+         if (c != i) {
+            g->xadj[i+1]++;
+            g->xadj[c+1]++;
+         }
+      }
+   }
+   for (i=0; i<g->n; i++) g->xadj[i+1] += g->xadj[i];
+   g->adj = (int *)primme_calloc(max(g->xadj[g->n], 1), sizeof(int), "adj");
+   next = (int *)primme_calloc(g->n, sizeof(int), "next");
+   for (i=0; i<g->n; i++) next[i] = g->xadj[i];
+   for (i=0; i<g->n; i++) {
+      for (k=matrix->IA[i]-1; k<matrix->IA[i+1]-1; k++) {
+         c = matrix->JA[k]-1;
+         if (c != i) {
+            g->adj[next[i]++] = c;
+            g->adj[next[c]++] = i;
+         }
+      }
+   }
+
+   /* Remove the repeated neighbors, as both A(i,j) and A(j,i) add i-j */
+   mark = next;
+   for (i=0; i<g->n; i++) mark[i] = -1;
+   for (i=0, pos=0, k=0; i<g->n; i++) {
+      for (j=k, k=g->xadj[i+1]; j<k; j++) {
+         if (mark[g->adj[j]] != i) {
+            mark[g->adj[j]] = i;
+            g->adj[pos++] = g->adj[j];
+         }
+      }
+      g->xadj[i+1] = pos;
+   }
+   free(mark);
+   return 0;
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: reorder.h
+ * 
+ * Purpose - Definitions of the orderings of CSR matrices used by the driver.
+ * 
+ ******************************************************************************/
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "csr.h"
+
+/* The orderings take the graph of A+A' of a square matrix, also in half
+   storage, and return in perm[i] the row of the matrix that goes to row i
+   after reordering, starting at 0 (see permuteCSRMatrix). */
+
+int rcmOrdering(const CSRMatrix *matrix, int *perm);
+int ndOrdering(const CSRMatrix *matrix, int *perm);
+
+#endif
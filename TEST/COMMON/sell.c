@@ -0,0 +1,344 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: sell.c
+ * 
+ * Purpose - SELL-C-sigma matrix, converted from CSR, and its block product.
+ *           The inner loops use AVX-512 or AVX2 gathers when the driver is
+ *           compiled for them (e.g., CFLAGS="-O2 -mavx512f" or
+ *           CFLAGS="-O2 -mavx2 -mfma") and plain C loops otherwise, as for
+ *           double complex.
+ * 
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "sell.h"
+
+#if !defined(USE_DOUBLECOMPLEX) && defined(__AVX512F__)
+#  define SELL_AVX512
+#  include <immintrin.h>
+#elif !defined(USE_DOUBLECOMPLEX) && defined(__AVX2__) && defined(__FMA__)
+#  define SELL_AVX2
+#  include <immintrin.h>
+#endif
+
+typedef struct {
+   int len;
+   int row;
+} rowKey;
+
+static int compRowKeys(const void *a, const void *b);
+static void chunkSums1(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      PRIMME_NUM *t);
+static void chunkSums4(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *t);
+static void sell_spmv1(const SELLMatrix *sell, const PRIMME_NUM *x,
+      PRIMME_NUM *y);
+static void sell_spmv4(const SELLMatrix *sell, const PRIMME_NUM *x, int ldx,
+      PRIMME_NUM *y, int ldy);
+
+/******************************************************************************
+ * Builds a SELL-C-sigma copy of the square matrix in CSR. The padding of
+ * each row repeats its last column index with a zero value, so that the
+ * gathers of the padding hit an entry of x already in cache.
+ *
+******************************************************************************/
+int createSELLMatrix(const CSRMatrix *matrix, SELLMatrix **sell_) {
+
+   int i, j, k, r, w, row, len, last, nRows, off;
+   const int *IA = matrix->IA, *JA = matrix->JA;
+   rowKey *keys;
+   SELLMatrix *sell;
+
+   sell = (SELLMatrix *)primme_calloc(1, sizeof(SELLMatrix), "SELLMatrix");
+   sell->n = nRows = matrix->m;
+   sell->numChunks = (nRows + SELL_C - 1)/SELL_C;
+   sell->perm = (int *)primme_calloc(nRows, sizeof(int), "perm");
+   sell->chunkLen = (int *)primme_calloc(sell->numChunks, sizeof(int),
+         "chunkLen");
+   sell->chunkPtr = (int *)primme_calloc(sell->numChunks+1, sizeof(int),
+         "chunkPtr");
+
+   /* Sort the rows by decreasing length in each window of SELL_SIGMA rows */
+   keys = (rowKey *)primme_calloc(nRows, sizeof(rowKey), "keys");
+   for (i=0; i<nRows; i++) {
+      keys[i].len = IA[i+1] - IA[i];
+      keys[i].row = i;
+   }
+   for (w=0; w<nRows; w+=SELL_SIGMA) {
+      qsort(&keys[w], min(SELL_SIGMA, nRows-w), sizeof(rowKey), compRowKeys);
+   }
+   for (i=0; i<nRows; i++) sell->perm[i] = keys[i].row;
+
+   /* Each chunk is as long as its first row, the longest one */
+   for (k=0; k<sell->numChunks; k++) {
+      sell->chunkLen[k] = keys[k*SELL_C].len;
+      sell->chunkPtr[k+1] = sell->chunkPtr[k] + sell->chunkLen[k]*SELL_C;
+   }
+   free(keys);
+
+   sell->col = (int *)primme_calloc(sell->chunkPtr[sell->numChunks],
+         sizeof(int), "col");
+   sell->val = (PRIMME_NUM *)primme_calloc(sell->chunkPtr[sell->numChunks],
+         sizeof(PRIMME_NUM), "val");
+
+   for (k=0; k<sell->numChunks; k++) {
+      for (r=0; r<SELL_C && k*SELL_C+r<nRows; r++) {
+         row = sell->perm[k*SELL_C+r];
+         len = IA[row+1] - IA[row];
+         last = 0;
+         for (j=0, off=sell->chunkPtr[k]+r; j<sell->chunkLen[k];
+               j++, off+=SELL_C) {
+            if (j < len) {
+               last = JA[IA[row]-1+j]-1;
+               sell->val[off] = matrix->AElts[IA[row]-1+j];
+            }
+            sell->col[off] = last;
+         }
+      }
+   }
+
+   *sell_ = sell;
+   return 0;
+}
+
+static int compRowKeys(const void *a, const void *b) {
+   const rowKey *ka = (const rowKey *)a, *kb = (const rowKey *)b;
+   return ka->len != kb->len ? kb->len - ka->len : ka->row - kb->row;
+}
+
+void destroySELLMatrix(SELLMatrix *sell) {
+   free(sell->chunkPtr);
+   free(sell->chunkLen);
+   free(sell->col);
+   free(sell->val);
+   free(sell->perm);
+   free(sell);
+}
+
+/******************************************************************************
+ * Applies the matrix vector multiplication on a block of vectors, four
+ * vectors at a time sharing the loads of the values and the indices, and
+ * one at a time for the rest. Vector i of x starts at x + (*ldx)*i and
+ * vector i of y at y + (*ldy)*i.
+ *
+******************************************************************************/
+void SELLMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                      primme_params *primme) {
+
+   int k;
+   PRIMME_NUM *xvec, *yvec;
+   SELLMatrix *sell;
+
+   sell = (SELLMatrix *)primme->matrix;
+   xvec = (PRIMME_NUM *)x;
+   yvec = (PRIMME_NUM *)y;
+
+   for (k=0; k+4<=*blockSize; k+=4) {
+      sell_spmv4(sell, &xvec[*ldx*k], *ldx, &yvec[*ldy*k], *ldy);
+   }
+   for (; k<*blockSize; k++) {
+      sell_spmv1(sell, &xvec[*ldx*k], &yvec[*ldy*k]);
+   }
+}
+
+/******************************************************************************
+ * Computes y = A*x for one or four vectors. The chunks are split among the
+ * OpenMP threads, and the SELL_C row sums of each chunk are stored back in
+ * the original order of the rows.
+ *
+******************************************************************************/
+static void sell_spmv1(const SELLMatrix *sell, const PRIMME_NUM *x,
+      PRIMME_NUM *y) {
+
+   int k, r;
+   PRIMME_NUM t[SELL_C];
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(r,t)
+#endif
+   for (k=0; k<sell->numChunks; k++) {
+      chunkSums1(sell, k, x, t);
+      for (r=0; r<SELL_C && k*SELL_C+r<sell->n; r++) {
+         y[sell->perm[k*SELL_C+r]] = t[r];
+      }
+   }
+}
+
+static void sell_spmv4(const SELLMatrix *sell, const PRIMME_NUM *x, int ldx,
+      PRIMME_NUM *y, int ldy) {
+
+   int k, r, i;
+   PRIMME_NUM t[4*SELL_C];
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(r,i,t)
+#endif
+   for (k=0; k<sell->numChunks; k++) {
+      chunkSums4(sell, k, x, ldx, t);
+      for (r=0; r<SELL_C && k*SELL_C+r<sell->n; r++) {
+         i = sell->perm[k*SELL_C+r];
+         y[i] = t[r];
+         y[i+ldy] = t[SELL_C+r];
+         y[i+2*ldy] = t[2*SELL_C+r];
+         y[i+3*ldy] = t[3*SELL_C+r];
+      }
+   }
+}
+
+/******************************************************************************
+ * Computes the sums t of the SELL_C rows of chunk k times x, for one vector
+ * or for four vectors, t(:,v) = A(chunk rows,:)*x(:,v) with t stored with
+ * leading dimension SELL_C.
+ *
+******************************************************************************/
+#if defined(SELL_AVX512)
+
+static void chunkSums1(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      PRIMME_NUM *t) {
+
+   int j, off = sell->chunkPtr[k];
+   __m256i idx;
+   __m512d s0 = _mm512_setzero_pd();
+
+   for (j=0; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      idx = _mm256_loadu_si256((const __m256i *)&sell->col[off]);
+      s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&sell->val[off]),
+            _mm512_i32gather_pd(idx, x, 8), s0);
+   }
+   _mm512_storeu_pd(t, s0);
+}
+
+static void chunkSums4(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *t) {
+
+   int j, off = sell->chunkPtr[k];
+   __m256i idx;
+   __m512d a, s0, s1, s2, s3;
+
+   s0 = s1 = s2 = s3 = _mm512_setzero_pd();
+   for (j=0; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      idx = _mm256_loadu_si256((const __m256i *)&sell->col[off]);
+      a = _mm512_loadu_pd(&sell->val[off]);
+      s0 = _mm512_fmadd_pd(a, _mm512_i32gather_pd(idx, x, 8), s0);
+      s1 = _mm512_fmadd_pd(a, _mm512_i32gather_pd(idx, x+ldx, 8), s1);
+      s2 = _mm512_fmadd_pd(a, _mm512_i32gather_pd(idx, x+2*ldx, 8), s2);
+      s3 = _mm512_fmadd_pd(a, _mm512_i32gather_pd(idx, x+3*ldx, 8), s3);
+   }
+   _mm512_storeu_pd(t, s0);
+   _mm512_storeu_pd(t+SELL_C, s1);
+   _mm512_storeu_pd(t+2*SELL_C, s2);
+   _mm512_storeu_pd(t+3*SELL_C, s3);
+}
+
+#elif defined(SELL_AVX2)
+
+/* A chunk is two AVX2 registers wide: rows 0-3 (lo) and rows 4-7 (hi) */
+
+static void chunkSums1(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      PRIMME_NUM *t) {
+
+   int j, off = sell->chunkPtr[k];
+   __m128i lo, hi;
+   __m256d s0l = _mm256_setzero_pd(), s0h = _mm256_setzero_pd();
+
+   for (j=0; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      lo = _mm_loadu_si128((const __m128i *)&sell->col[off]);
+      hi = _mm_loadu_si128((const __m128i *)&sell->col[off+4]);
+      s0l = _mm256_fmadd_pd(_mm256_loadu_pd(&sell->val[off]),
+            _mm256_i32gather_pd(x, lo, 8), s0l);
+      s0h = _mm256_fmadd_pd(_mm256_loadu_pd(&sell->val[off+4]),
+            _mm256_i32gather_pd(x, hi, 8), s0h);
+   }
+   _mm256_storeu_pd(t, s0l);
+   _mm256_storeu_pd(t+4, s0h);
+}
+
+static void chunkSums4(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *t) {
+
+   int j, v, off;
+   __m128i lo, hi;
+   __m256d al, ah, sl[4], sh[4];
+
+   /* Eight accumulators and the two halves of the values take ten of the
+      sixteen registers */
+   for (v=0; v<4; v++) sl[v] = sh[v] = _mm256_setzero_pd();
+   for (j=0, off=sell->chunkPtr[k]; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      lo = _mm_loadu_si128((const __m128i *)&sell->col[off]);
+      hi = _mm_loadu_si128((const __m128i *)&sell->col[off+4]);
+      al = _mm256_loadu_pd(&sell->val[off]);
+      ah = _mm256_loadu_pd(&sell->val[off+4]);
+      for (v=0; v<4; v++) {
+         sl[v] = _mm256_fmadd_pd(al, _mm256_i32gather_pd(x+v*ldx, lo, 8),
+               sl[v]);
+         sh[v] = _mm256_fmadd_pd(ah, _mm256_i32gather_pd(x+v*ldx, hi, 8),
+               sh[v]);
+      }
+   }
+   for (v=0; v<4; v++) {
+      _mm256_storeu_pd(t+v*SELL_C, sl[v]);
+      _mm256_storeu_pd(t+v*SELL_C+4, sh[v]);
+   }
+}
+
+#else
+
+static void chunkSums1(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      PRIMME_NUM *t) {
+
+   int j, r, off;
+   const int *col;
+   const PRIMME_NUM *val;
+
+   for (r=0; r<SELL_C; r++) t[r] = 0.0;
+   for (j=0, off=sell->chunkPtr[k]; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      col = &sell->col[off];
+      val = &sell->val[off];
+      for (r=0; r<SELL_C; r++) {
+         t[r] += val[r]*x[col[r]];
+      }
+   }
+}
+
+static void chunkSums4(const SELLMatrix *sell, int k, const PRIMME_NUM *x,
+      int ldx, PRIMME_NUM *t) {
+
+   int j, r, off;
+   const int *col;
+   const PRIMME_NUM *val, *xj;
+
+   for (r=0; r<4*SELL_C; r++) t[r] = 0.0;
+   for (j=0, off=sell->chunkPtr[k]; j<sell->chunkLen[k]; j++, off+=SELL_C) {
+      col = &sell->col[off];
+      val = &sell->val[off];
+      for (r=0; r<SELL_C; r++) {
+         xj = &x[col[r]];
+         t[r]          += val[r]*xj[0];
+         t[SELL_C+r]   += val[r]*xj[ldx];
+         t[2*SELL_C+r] += val[r]*xj[2*ldx];
+         t[3*SELL_C+r] += val[r]*xj[3*ldx];
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: sell.h
+ * 
+ * Purpose - Definitions of the SELL-C-sigma matrix used by the driver.
+ * 
+ ******************************************************************************/
+
+#ifndef SELL_H
+#define SELL_H
+
+#include "csr.h"
+#include "primme.h"
+
+#define SELL_C     8     /* rows per chunk, the width of an AVX-512 register */
+#define SELL_SIGMA 256   /* rows sorted by length within windows of this size */
+
+/* Rows are grouped in chunks of SELL_C rows; chunk k stores its columns one
+   after another, starting at chunkPtr[k], each one with SELL_C entries (one
+   per row) and with chunkLen[k] columns, the length of its longest row.
+   Shorter rows are padded with zero values. Before chunking, the rows in
+   each window of SELL_SIGMA rows are sorted by decreasing length, and row
+   r of the chunks is row perm[r] of the matrix. Column indices start at 0. */
+
+typedef struct {
+   int n;          /* number of rows */
+   int numChunks;
+   int *chunkPtr;  /* start of each chunk in col and val, numChunks+1 */
+   int *chunkLen;
+   int *col;
+   PRIMME_NUM *val;
+   int *perm;
+} SELLMatrix;
+
+int createSELLMatrix(const CSRMatrix *matrix, SELLMatrix **sell);
+void destroySELLMatrix(SELLMatrix *sell);
+void SELLMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                      primme_params *primme);
+
+#endif
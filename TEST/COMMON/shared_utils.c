@@ -47,6 +47,7 @@ int read_solver_params(char *configFileName, char *outputFileName,
    char ident[2048];
    char op[128];
    char stringValue[128];
+   static char outOfCoreDir[1024];  /* primme.outOfCoreDir points here */
    FILE *configFile;
 
    if ((configFile = fopen(configFileName, "r")) == NULL) {
@@ -154,6 +155,16 @@ int read_solver_params(char *configFileName, char *outputFileName,
          else if (strcmp(ident, "primme.maxBlockSize") == 0) {
             ret = fscanf(configFile, "%d", &primme->maxBlockSize);
          }
+         else if (strcmp(ident, "primme.traceSize") == 0) {
+            ret = fscanf(configFile, "%d", &primme->traceSize);
+         }
+         else if (strcmp(ident, "primme.hugePages") == 0) {
+            ret = fscanf(configFile, "%d", &primme->hugePages);
+         }
+         else if (strcmp(ident, "primme.outOfCoreDir") == 0) {
+            ret = fscanf(configFile, "%1023s", outOfCoreDir);
+            primme->outOfCoreDir = outOfCoreDir;
+         }
          else if (strcmp(ident, "primme.initSize") == 0) {
             ret = fscanf(configFile, "%d", &primme->initSize);
          }
@@ -166,6 +177,12 @@ int read_solver_params(char *configFileName, char *outputFileName,
          else if (strcmp(ident, "primme.maxMatvecs") == 0) {
             ret = fscanf(configFile, "%d", &primme->maxMatvecs);
          }
+         else if (strcmp(ident, "primme.maxTime") == 0) {
+            ret = fscanf(configFile, "%le", &primme->maxTime);
+         }
+         else if (strcmp(ident, "primme.autoTune") == 0) {
+            ret = fscanf(configFile, "%d", &primme->autoTune);
+         }
          else if (strcmp(ident, "primme.printLevel") == 0) {
             ret = fscanf(configFile, "%d", &primme->printLevel);
          }
@@ -178,6 +195,12 @@ int read_solver_params(char *configFileName, char *outputFileName,
                else if (strcmp(stringValue, "primme_dtr") == 0) {
                   primme->restartingParams.scheme = primme_dtr;
                }
+               else if (strcmp(stringValue, "primme_thick_adaptive") == 0) {
+                  primme->restartingParams.scheme = primme_thick_adaptive;
+               }
+               else if (strcmp(stringValue, "primme_krylov_schur") == 0) {
+                  primme->restartingParams.scheme = primme_krylov_schur;
+               }
                else {
                   printf("Invalid restart.scheme value\n");
                   ret = 0;
@@ -414,6 +437,27 @@ int read_driver_params(char *configFileName, driver_params *driver) {
          else if (strcmp(ident, "driver.checkXFile") == 0) {
             ret = fscanf(configFile, "%s", driver->checkXFileName);
          }
+         else if (strcmp(ident, "driver.traceFile") == 0) {
+            ret = fscanf(configFile, "%s", driver->traceFileName);
+         }
+         else if (strcmp(ident, "driver.costModelFile") == 0) {
+            ret = fscanf(configFile, "%s", driver->costModelFileName);
+         }
+         else if (strcmp(ident, "driver.traceFormat") == 0) {
+            ret = fscanf(configFile, "%s", stringValue);
+            if (ret == 1) {
+               if (strcmp(stringValue, "chrome") == 0) {
+                  driver->traceFormat = primme_trace_chrome;
+               }
+               else if (strcmp(stringValue, "jsonl") == 0) {
+                  driver->traceFormat = primme_trace_jsonl;
+               }
+               else {
+                  fprintf(stderr, 
+                     "ERROR(read_driver_params): Invalid parameter '%s'\n", ident);
+               }
+            }
+         }
          else if (strcmp(ident, "driver.matrixChoice") == 0) {
             ret = fscanf(configFile, "%s", stringValue);
             if (ret == 1) {
@@ -423,6 +467,12 @@ int read_driver_params(char *configFileName, driver_params *driver) {
                else if (strcmp(stringValue, "native") == 0) {
                   driver->matrixChoice = driver_native;
                }
+               else if (strcmp(stringValue, "native_amux") == 0) {
+                  driver->matrixChoice = driver_native_amux;
+               }
+               else if (strcmp(stringValue, "native_sell") == 0) {
+                  driver->matrixChoice = driver_native_sell;
+               }
                else if (strcmp(stringValue, "parasails") == 0) {
                   driver->matrixChoice = driver_parasails;
                }
@@ -435,6 +485,36 @@ int read_driver_params(char *configFileName, driver_params *driver) {
                }
             }
          }
+         else if (strcmp(ident, "driver.reorder") == 0) {
+            ret = fscanf(configFile, "%s", stringValue);
+            if (ret == 1) {
+               if (strcmp(stringValue, "none") == 0) {
+                  driver->reorder = driver_reorder_none;
+               }
+               else if (strcmp(stringValue, "rcm") == 0) {
+                  driver->reorder = driver_rcm;
+               }
+               else if (strcmp(stringValue, "nd") == 0) {
+                  driver->reorder = driver_nd;
+               }
+               else {
+                  fprintf(stderr, 
+                     "ERROR(read_driver_params): Invalid parameter '%s'\n", ident);
+               }
+            }
+         }
+         else if (strcmp(ident, "driver.threads") == 0) {
+            ret = fscanf(configFile, "%d", &driver->threads);
+         }
+         else if (strcmp(ident, "driver.splitMatvec") == 0) {
+            ret = fscanf(configFile, "%d", &driver->splitMatvec);
+         }
+         else if (strcmp(ident, "driver.monitorStop") == 0) {
+            ret = fscanf(configFile, "%d", &driver->monitorStop);
+         }
+         else if (strcmp(ident, "driver.expectedRet") == 0) {
+            ret = fscanf(configFile, "%d", &driver->expectedRet);
+         }
          /* Preconditioning parameters */
          else if (strcmp(ident, "driver.PrecChoice") == 0) {
             ret = fscanf(configFile, "%s", stringValue);
@@ -451,6 +531,12 @@ int read_driver_params(char *configFileName, driver_params *driver) {
                else if (strcmp(stringValue, "ilut") == 0) {
                   driver->PrecChoice = driver_ilut;
                }
+               else if (strcmp(stringValue, "chebyshev") == 0) {
+                  driver->PrecChoice = driver_chebyshev;
+               }
+               else if (strcmp(stringValue, "amg") == 0) {
+                  driver->PrecChoice = driver_amg;
+               }
                else {
                   fprintf(stderr, 
                      "ERROR(read_driver_params): Invalid parameter '%s'\n", ident);
@@ -472,6 +558,24 @@ int read_driver_params(char *configFileName, driver_params *driver) {
          else if (strcmp(ident, "driver.filter") == 0) {
             ret = fscanf(configFile, "%lf", &driver->filter);
          }
+         else if (strcmp(ident, "driver.degree") == 0) {
+            ret = fscanf(configFile, "%d", &driver->degree);
+         }
+         else if (strcmp(ident, "driver.smoother") == 0) {
+            ret = fscanf(configFile, "%s", stringValue);
+            if (ret == 1) {
+               if (strcmp(stringValue, "jacobi") == 0) {
+                  driver->smoother = driver_smoother_jacobi;
+               }
+               else if (strcmp(stringValue, "chebyshev") == 0) {
+                  driver->smoother = driver_smoother_chebyshev;
+               }
+               else {
+                  fprintf(stderr, 
+                     "ERROR(read_driver_params): Invalid parameter '%s'\n", ident);
+               }
+            }
+         }
          else if (strncmp(ident, "driver.", 7) == 0) {
             fprintf(stderr, 
               "ERROR(read_driver_params): Invalid parameter '%s'\n", ident);
@@ -503,8 +607,13 @@ int read_driver_params(char *configFileName, driver_params *driver) {
 
 void driver_display_params(driver_params driver, FILE *outputFile) {
 
-const char *strPrecChoice[] = {"noprecond", "jacobi", "davidsonjacobi", "ilut"};
-const char *strMatrixChoice[] = {"default", "native", "petsc", "parasails"};
+const char *strPrecChoice[] = {"noprecond", "jacobi", "davidsonjacobi", "ilut",
+                               "chebyshev", "amg"};
+const char *strMatrixChoice[] = {"default", "native", "petsc", "parasails",
+                                 "native_amux", "native_sell"};
+const char *strTraceFormat[] = {"chrome", "jsonl"};
+const char *strReorder[] = {"none", "rcm", "nd"};
+const char *strSmoother[] = {"jacobi", "chebyshev"};
  
 fprintf(outputFile, "// ---------------------------------------------------\n"
                     "//                 driver configuration               \n"
@@ -514,16 +623,26 @@ fprintf(outputFile, "driver.partId        = %s\n", driver.partId);
 fprintf(outputFile, "driver.partDir       = %s\n", driver.partDir);
 fprintf(outputFile, "driver.matrixFile    = %s\n", driver.matrixFileName);
 fprintf(outputFile, "driver.matrixChoice  = %s\n", strMatrixChoice[driver.matrixChoice]);
+fprintf(outputFile, "driver.reorder       = %s\n", strReorder[driver.reorder]);
+fprintf(outputFile, "driver.threads       = %d\n", driver.threads);
+fprintf(outputFile, "driver.splitMatvec   = %d\n", driver.splitMatvec);
+fprintf(outputFile, "driver.monitorStop   = %d\n", driver.monitorStop);
+fprintf(outputFile, "driver.expectedRet   = %d\n", driver.expectedRet);
 fprintf(outputFile, "driver.initialGuessesFile = %s\n", driver.initialGuessesFileName);
 fprintf(outputFile, "driver.initialGuessesPert = %e\n", driver.initialGuessesPert);
 fprintf(outputFile, "driver.saveXFile     = %s\n", driver.saveXFileName);
 fprintf(outputFile, "driver.checkXFile    = %s\n", driver.checkXFileName);
+fprintf(outputFile, "driver.traceFile     = %s\n", driver.traceFileName);
+fprintf(outputFile, "driver.traceFormat   = %s\n", strTraceFormat[driver.traceFormat]);
+fprintf(outputFile, "driver.costModelFile = %s\n", driver.costModelFileName);
 fprintf(outputFile, "driver.PrecChoice    = %s\n", strPrecChoice[driver.PrecChoice]);
 fprintf(outputFile, "driver.shift         = %e\n", driver.shift);
 fprintf(outputFile, "driver.isymm         = %d\n", driver.isymm);
 fprintf(outputFile, "driver.level         = %d\n", driver.level);
 fprintf(outputFile, "driver.threshold     = %f\n", driver.threshold);
-fprintf(outputFile, "driver.filter        = %f\n\n", driver.filter);
+fprintf(outputFile, "driver.filter        = %f\n", driver.filter);
+fprintf(outputFile, "driver.degree        = %d\n", driver.degree);
+fprintf(outputFile, "driver.smoother      = %s\n\n", strSmoother[driver.smoother]);
 
 }
 
@@ -39,16 +39,31 @@ typedef enum {
    driver_default,
    driver_native,
    driver_petsc,
-   driver_parasails
+   driver_parasails,
+   driver_native_amux,
+   driver_native_sell
 } driver_mat;
 
 typedef enum {
    driver_noprecond,    /* no preconditioning */
    driver_jacobi,       /* K=Diag(A-shift),   shift provided once by user */
    driver_jacobi_i,     /* Diag(A-shift_i), shifts provided by primme every step */
-   driver_ilut          /* ILUT(A-shift)  , shift provided once by user */
+   driver_ilut,         /* ILUT(A-shift)  , shift provided once by user */
+   driver_chebyshev,    /* p(A) ~ (A-shift_i)^-1, only with matrixMatvec */
+   driver_amg           /* V-cycle of smoothed aggregation AMG on A-shift */
 } driver_prec;
 
+typedef enum {
+   driver_smoother_jacobi,
+   driver_smoother_chebyshev
+} driver_smoother;
+
+typedef enum {
+   driver_reorder_none,
+   driver_rcm,          /* reverse Cuthill-McKee */
+   driver_nd            /* nested dissection */
+} driver_reorder;
+
 typedef struct driver_params {
 
    char outputFileName[512];
@@ -60,10 +75,18 @@ typedef struct driver_params {
    char saveXFileName[1024];
    double initialGuessesPert;
    char checkXFileName[1024];
+   char traceFileName[1024];
+   primme_trace_format traceFormat;
+   char costModelFileName[1024];
 
    driver_mat matrixChoice;
+   driver_reorder reorder;
 
    int weightedPart;
+   int threads;           /* ranks run as threads on row blocks (NATIVE) */
+   int splitMatvec;       /* products in update_W deferred to the wait   */
+   int monitorStop;       /* monitor stops after so many outer iterations*/
+   int expectedRet;       /* value that primme is expected to return     */
 
    /* Preconditioning paramaters for various preconditioners */
    driver_prec PrecChoice;
@@ -72,6 +95,8 @@ typedef struct driver_params {
    double threshold;
    double filter;
    double shift;
+   int degree;
+   driver_smoother smoother;
    
 } driver_params;
 
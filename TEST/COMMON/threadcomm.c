@@ -0,0 +1,313 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: threadcomm.c
+ * 
+ * Purpose - Shared memory versions of the distributed operations that the
+ *           driver needs to run several solver instances as threads: a
+ *           barrier, globalSumDouble, and the matrix-vector product of a
+ *           CSR matrix partitioned by rows, with halo exchange.
+ * 
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "threadcomm.h"
+#include "num.h"
+
+static int rowStart(int n, int numProcs, int rank);
+static CSRMatrix *newCSRMatrix(int m, int n, int nnz);
+
+int createThreadComm(int numProcs, ThreadComm **comm_) {
+
+   ThreadComm *comm;
+
+   if (numProcs < 1) return -1;
+   comm = (ThreadComm *)primme_calloc(1, sizeof(ThreadComm), "ThreadComm");
+   comm->numProcs = numProcs;
+   if (pthread_mutex_init(&comm->mutex, NULL) != 0
+         || pthread_cond_init(&comm->cond, NULL) != 0) {
+      free(comm);
+      return -1;
+   }
+   comm->slots = (void **)primme_calloc(numProcs, sizeof(void *), "slots");
+   comm->lds = (int *)primme_calloc(numProcs, sizeof(int), "lds");
+   *comm_ = comm;
+   return 0;
+}
+
+void destroyThreadComm(ThreadComm *comm) {
+
+   pthread_mutex_destroy(&comm->mutex);
+   pthread_cond_destroy(&comm->cond);
+   free(comm->slots);
+   free(comm->lds);
+   free(comm);
+}
+
+/******************************************************************************
+ * Returns when all the ranks of the group have called it.
+ *
+******************************************************************************/
+void threadBarrier(ThreadComm *comm) {
+
+   unsigned int phase;
+
+   pthread_mutex_lock(&comm->mutex);
+   phase = comm->phase;
+   if (++comm->waiting == comm->numProcs) {
+      comm->waiting = 0;
+      comm->phase++;
+      pthread_cond_broadcast(&comm->cond);
+   }
+   else {
+      while (phase == comm->phase) {
+         pthread_cond_wait(&comm->cond, &comm->mutex);
+      }
+   }
+   pthread_mutex_unlock(&comm->mutex);
+}
+
+/******************************************************************************
+ * Sums count doubles of all the ranks, as MPI_Allreduce. The partial sums
+ * are added by pairs of ranks in a binary tree, so all ranks get exactly
+ * the same result.
+ *
+******************************************************************************/
+void ThreadGlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
+                           primme_params *primme) {
+
+   int i, step;
+   const int rank = primme->procID;
+   double *sum = (double *)recvBuf, *other;
+   ThreadComm *comm = (ThreadComm *)primme->commInfo;
+
+   if (sendBuf != recvBuf) memcpy(recvBuf, sendBuf, sizeof(double)*(*count));
+   comm->slots[rank] = recvBuf;
+   threadBarrier(comm);
+
+   for (step=1; step<comm->numProcs; step*=2) {
+      if (rank % (2*step) == 0 && rank+step < comm->numProcs) {
+         other = (double *)comm->slots[rank+step];
+         for (i=0; i<*count; i++) sum[i] += other[i];
+      }
+      threadBarrier(comm);
+   }
+
+   if (rank != 0) {
+      memcpy(recvBuf, comm->slots[0], sizeof(double)*(*count));
+   }
+   threadBarrier(comm);
+}
+
+/******************************************************************************
+ * Returns in tmatrix the rows of the rank in a block partition of the
+ * matrix. All ranks call it; only rank 0 passes the matrix, also in half
+ * storage, and in perm the permutation of its rows or NULL, and both are
+ * released. On return, perm has the original index of each local row.
+ *
+******************************************************************************/
+int createThreadMatrix(ThreadComm *comm, int rank, CSRMatrix *matrix,
+                       int **perm, ThreadMatrix **tmatrix_) {
+
+   int i, j, c, r, n, nnzd, nnzo, numProcs = comm->numProcs, *ghostOf;
+   CSRMatrix *A, *full;
+   ThreadMatrix *tmatrix;
+
+   /* Rank 0 shares the matrix with both triangles */
+   if (rank == 0) {
+      if (matrix->symmetric) {
+         expandSymCSRMatrix(matrix, &full);
+         destroyCSRMatrix(matrix);
+         matrix = full;
+      }
+      comm->matrix = matrix;
+      comm->perm = *perm;
+   }
+   threadBarrier(comm);
+   A = comm->matrix;
+   n = A->n;
+
+   tmatrix = (ThreadMatrix *)primme_calloc(1, sizeof(ThreadMatrix),
+         "ThreadMatrix");
+   tmatrix->comm = comm;
+   tmatrix->rank = rank;
+   tmatrix->n = n;
+   tmatrix->r0 = rowStart(n, numProcs, rank);
+   tmatrix->nLocal = rowStart(n, numProcs, rank+1) - tmatrix->r0;
+
+   /* Number the columns out of the block in increasing order, from 1 */
+   ghostOf = (int *)primme_calloc(n, sizeof(int), "ghostOf");
+   for (i=tmatrix->r0, nnzd=nnzo=0; i<tmatrix->r0+tmatrix->nLocal; i++) {
+      for (j=A->IA[i]-1; j<A->IA[i+1]-1; j++) {
+         c = A->JA[j]-1;
+         if (c >= tmatrix->r0 && c < tmatrix->r0+tmatrix->nLocal) {
+            nnzd++;
+         }
+         else {
+            ghostOf[c] = 1;
+            nnzo++;
+         }
+      }
+   }
+   for (c=0; c<n; c++) {
+      if (ghostOf[c]) ghostOf[c] = ++tmatrix->nGhost;
+   }
+   tmatrix->ghostRank = (int *)primme_calloc(max(tmatrix->nGhost, 1),
+         sizeof(int), "ghostRank");
+   tmatrix->ghostIndex = (int *)primme_calloc(max(tmatrix->nGhost, 1),
+         sizeof(int), "ghostIndex");
+   for (c=0, r=0; c<n; c++) {
+      if (!ghostOf[c]) continue;
+      while (rowStart(n, numProcs, r+1) <= c) r++;
+      tmatrix->ghostRank[ghostOf[c]-1] = r;
+      tmatrix->ghostIndex[ghostOf[c]-1] = c - rowStart(n, numProcs, r);
+   }
+
+   /* Split the rows */
+   tmatrix->diag = newCSRMatrix(tmatrix->nLocal, tmatrix->nLocal, nnzd);
+   tmatrix->offd = newCSRMatrix(tmatrix->nLocal, tmatrix->nGhost, nnzo);
+   for (i=0, nnzd=nnzo=0; i<tmatrix->nLocal; i++) {
+      tmatrix->diag->IA[i] = nnzd+1;
+      tmatrix->offd->IA[i] = nnzo+1;
+      r = tmatrix->r0 + i;
+      for (j=A->IA[r]-1; j<A->IA[r+1]-1; j++) {
+         c = A->JA[j]-1;
+         if (ghostOf[c]) {
+            tmatrix->offd->JA[nnzo] = ghostOf[c];
+            tmatrix->offd->AElts[nnzo++] = A->AElts[j];
+         }
+         else {
+            tmatrix->diag->JA[nnzd] = c - tmatrix->r0 + 1;
+            tmatrix->diag->AElts[nnzd++] = A->AElts[j];
+         }
+      }
+   }
+   tmatrix->diag->IA[tmatrix->nLocal] = nnzd+1;
+   tmatrix->offd->IA[tmatrix->nLocal] = nnzo+1;
+   free(ghostOf);
+
+   *perm = (int *)primme_calloc(max(tmatrix->nLocal, 1), sizeof(int), "perm");
+   for (i=0; i<tmatrix->nLocal; i++) {
+      (*perm)[i] = comm->perm ? comm->perm[tmatrix->r0+i] : tmatrix->r0+i;
+   }
+
+   /* Rank 0 releases the matrix when all ranks have taken their rows */
+   threadBarrier(comm);
+   if (rank == 0) {
+      destroyCSRMatrix(comm->matrix);
+      free(comm->perm);
+      comm->matrix = NULL;
+      comm->perm = NULL;
+   }
+
+   *tmatrix_ = tmatrix;
+   return 0;
+}
+
+void destroyThreadMatrix(ThreadMatrix *tmatrix) {
+
+   destroyCSRMatrix(tmatrix->diag);
+   destroyCSRMatrix(tmatrix->offd);
+   free(tmatrix->ghostRank);
+   free(tmatrix->ghostIndex);
+   free(tmatrix);
+}
+
+/******************************************************************************
+ * Computes y = A*x on the local rows. The entries of x of other ranks
+ * (the halo) are copied after a barrier, and the ranks do not change x
+ * before the next barrier. The loop over the rows is split among the
+ * OpenMP threads of the rank.
+ *
+******************************************************************************/
+void ThreadMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme) {
+
+   int i, j, k, g;
+   const int nv = *blockSize;
+   PRIMME_NUM *xvec, *yvec, *ghost, *owner, s;
+   ThreadMatrix *tmatrix;
+   ThreadComm *comm;
+
+   tmatrix = (ThreadMatrix *)primme->matrix;
+   comm = tmatrix->comm;
+   xvec = (PRIMME_NUM *)x;
+   yvec = (PRIMME_NUM *)y;
+
+   ghost = (PRIMME_NUM *)primme_calloc(max(tmatrix->nGhost*nv, 1),
+         sizeof(PRIMME_NUM), "ghost");
+   comm->slots[tmatrix->rank] = x;
+   comm->lds[tmatrix->rank] = *ldx;
+   threadBarrier(comm);
+   for (k=0; k<nv; k++) {
+      for (g=0; g<tmatrix->nGhost; g++) {
+         owner = (PRIMME_NUM *)comm->slots[tmatrix->ghostRank[g]];
+         ghost[(size_t)tmatrix->nGhost*k+g] = owner[
+            (size_t)comm->lds[tmatrix->ghostRank[g]]*k + tmatrix->ghostIndex[g]];
+      }
+   }
+   threadBarrier(comm);
+
+   for (k=0; k<nv; k++) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) private(j,s)
+#endif
+      for (i=0; i<tmatrix->nLocal; i++) {
+         const CSRMatrix *d = tmatrix->diag, *o = tmatrix->offd;
+         s = 0.0;
+         for (j=d->IA[i]-1; j<d->IA[i+1]-1; j++) {
+            s += d->AElts[j]*xvec[(size_t)*ldx*k+d->JA[j]-1];
+         }
+         for (j=o->IA[i]-1; j<o->IA[i+1]-1; j++) {
+            s += o->AElts[j]*ghost[(size_t)tmatrix->nGhost*k+o->JA[j]-1];
+         }
+         yvec[(size_t)*ldy*k+i] = s;
+      }
+   }
+
+   free(ghost);
+}
+
+/******************************************************************************
+ * First row of rank in the partition of n rows in numProcs blocks.
+ *
+******************************************************************************/
+static int rowStart(int n, int numProcs, int rank) {
+   return (int)((long int)n*rank/numProcs);
+}
+
+static CSRMatrix *newCSRMatrix(int m, int n, int nnz) {
+
+   CSRMatrix *matrix;
+
+   matrix = (CSRMatrix *)primme_calloc(1, sizeof(CSRMatrix), "CSRMatrix");
+   matrix->m = m;
+   matrix->n = n;
+   matrix->nnz = nnz;
+   matrix->IA = (int *)primme_calloc(m+1, sizeof(int), "IA");
+   matrix->JA = (int *)primme_calloc(max(nnz, 1), sizeof(int), "JA");
+   matrix->AElts = (PRIMME_NUM *)primme_calloc(max(nnz, 1), sizeof(PRIMME_NUM),
+         "AElts");
+   return matrix;
+}
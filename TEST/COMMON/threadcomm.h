@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: threadcomm.h
+ * 
+ * Purpose - Definitions of the shared memory communication and the
+ *           partitioned CSR matrix used by the driver to run several
+ *           solver instances as threads.
+ * 
+ ******************************************************************************/
+
+#ifndef THREADCOMM_H
+#define THREADCOMM_H
+
+#include <pthread.h>
+#include "csr.h"
+#include "primme.h"
+
+/* Group of numProcs solver instances run as threads of one process. Each
+   instance plays the role of an MPI process: primme.procID is its rank,
+   primme.commInfo points to the shared ThreadComm, and it owns a block of
+   consecutive rows of the matrix and of the vectors. Each rank publishes a
+   pointer (and a leading dimension) in slots and lds before a barrier, so
+   that the others can read its data until the next barrier. */
+
+typedef struct {
+   int numProcs;
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+   int waiting;            /* ranks waiting on the barrier */
+   unsigned int phase;     /* times the barrier has been passed */
+   void **slots;
+   int *lds;
+   CSRMatrix *matrix;      /* whole matrix while the ranks take their rows */
+   int *perm;
+} ThreadComm;
+
+/* Rows r0:r0+nLocal-1 of the n rows of the matrix of a rank. diag has the columns of the
+   same rows and offd the others, renumbered by ghost index; ghost g is the
+   local row ghostIndex[g] of rank ghostRank[g]. Both are numbered from 1. */
+
+typedef struct {
+   ThreadComm *comm;
+   int rank, n, r0, nLocal, nGhost;
+   CSRMatrix *diag, *offd;
+   int *ghostRank, *ghostIndex;
+} ThreadMatrix;
+
+int createThreadComm(int numProcs, ThreadComm **comm);
+void destroyThreadComm(ThreadComm *comm);
+void threadBarrier(ThreadComm *comm);
+int createThreadMatrix(ThreadComm *comm, int rank, CSRMatrix *matrix,
+                       int **perm, ThreadMatrix **tmatrix);
+void destroyThreadMatrix(ThreadMatrix *tmatrix);
+void ThreadMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+                        primme_params *primme);
+void ThreadGlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
+                           primme_params *primme);
+
+#endif
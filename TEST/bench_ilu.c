@@ -0,0 +1,167 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Scaling benchmark of the ILUT preconditioner of the native driver: the
+ *  level-scheduled forward and backward solves of ApplyILUTPrecNative,
+ *  with 1, 2, 4, ... OpenMP threads up to OMP_NUM_THREADS, against SPARSKIT
+ *  lusol0 called once per vector. Build the driver objects with -fopenmp
+ *  to time more than one thread.
+ *
+ *  Usage: bench_ilu [matrix.mtx [level [threshold [repetitions]]]]
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+#include "primme.h"
+#include "wtime.h"
+#include "native.h"
+
+#define MAX_BLOCK_SIZE 8
+#define TRIALS         3
+
+void FORTRAN_FUNCTION(lusol0)(int*, double*, double*, double*, int*, int*);
+
+static void applyLusol0(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+static double bench(void (*f)(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, primme_params *primme), double *x, double *y,
+   int blockSize, int reps, primme_params *primme);
+
+int main (int argc, char *argv[]) {
+
+   int i, bs, reps, level, threads, maxThreads = 1;
+   const char *matrixFile;
+   double *x, *y, *yLusol, threshold, tLusol, tLevel, diff, fnorm;
+   CSRMatrix *matrix;
+   ILUTPrec *prec;
+   primme_params primme;
+
+   matrixFile = argc > 1 ? argv[1] : "LUNDA.mtx";
+   level = argc > 2 ? atoi(argv[2]) : 2;
+   threshold = argc > 3 ? atof(argv[3]) : 0.01;
+   reps = argc > 4 ? atoi(argv[4]) : 20;
+
+   if (readMatrixNative(matrixFile, &matrix, &fnorm) != 0) return 1;
+   if (createILUTPrecNative(matrix, 0.0, level, threshold, 0.0, &prec) != 0)
+      return 1;
+
+   primme_initialize(&primme);
+   primme.matrix = matrix;
+   primme.preconditioner = prec;
+   primme.n = primme.nLocal = matrix->n;
+
+   x = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE, "x");
+   y = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE, "y");
+   yLusol = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE,
+      "yLusol");
+   for (i = 0; i < matrix->n*MAX_BLOCK_SIZE; i++) {
+      x[i] = (double)(i % 97)/97.0;
+   }
+
+#ifdef _OPENMP
+   maxThreads = omp_get_max_threads();
+#endif
+   printf("%s: n = %d, nnz = %d, nnz of L+U = %d, levels of L = %d, "
+      "levels of U = %d\n", matrixFile, matrix->n, matrix->nnz,
+      prec->factors->JA[matrix->n]-1, prec->numLevelsL, prec->numLevelsU);
+   printf("%8s %10s %10s %10s %8s %10s\n", "threads", "blockSize", "lusol0",
+      "levels", "speedup", "max |diff|");
+
+   for (threads = 1; threads <= maxThreads;
+         threads = threads < maxThreads && threads*2 > maxThreads ?
+            maxThreads : threads*2) {
+#ifdef _OPENMP
+      omp_set_num_threads(threads);
+#endif
+      for (bs = 1; bs <= MAX_BLOCK_SIZE; bs *= 2) {
+         tLusol = bench(applyLusol0, x, yLusol, bs, reps, &primme);
+         tLevel = bench(ApplyILUTPrecNative, x, y, bs, reps, &primme);
+
+         diff = 0.0;
+         for (i = 0; i < matrix->n*bs; i++) {
+            diff = fmax(diff, fabs(y[i] - yLusol[i]));
+         }
+
+         printf("%8d %10d %10.3e %10.3e %8.2f %10.3e\n", threads, bs, tLusol,
+            tLevel, tLusol/tLevel, diff);
+      }
+      if (threads == maxThreads) break;
+   }
+
+   destroyILUTPrecNative(prec);
+   destroyCSRMatrix(matrix);
+   free(x); free(y); free(yLusol);
+   return 0;
+}
+
+/******************************************************************************
+ * The previous ApplyILUTPrecNative: SPARSKIT lusol0 for each vector.
+ *
+******************************************************************************/
+
+static void applyLusol0(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme) {
+
+   int i;
+   ILUTPrec *prec = (ILUTPrec *)primme->preconditioner;
+
+   for (i = 0; i < *blockSize; i++) {
+      FORTRAN_FUNCTION(lusol0)(&primme->n, &((double *)x)[*ldx*i],
+         &((double *)y)[*ldy*i], (double *)prec->factors->AElts,
+         prec->factors->JA, prec->factors->IA);
+   }
+}
+
+/******************************************************************************
+ * Returns the time in seconds of applying f to blockSize vectors, stored
+ * with leading dimension n, averaged over reps applications. The smallest
+ * of TRIALS such averages is returned to filter out the noise of other
+ * processes.
+ *
+******************************************************************************/
+
+static double bench(void (*f)(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, primme_params *primme), double *x, double *y,
+   int blockSize, int reps, primme_params *primme) {
+
+   int i, trial;
+   double t0, t, tmin = HUGE_VAL;
+
+   /* Warm up */
+   f(x, &primme->n, y, &primme->n, &blockSize, primme);
+
+   for (trial = 0; trial < TRIALS; trial++) {
+      t0 = primme_get_wtime();
+      for (i = 0; i < reps; i++) {
+         f(x, &primme->n, y, &primme->n, &blockSize, primme);
+      }
+      t = (primme_get_wtime() - t0)/reps;
+      if (t < tmin) tmin = t;
+   }
+   return tmin;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Microbenchmark of the tall skinny products on the basis V done by
+ *  restart_X (V*hVecs) and update_projection (V'*W), with V stored with
+ *  leading dimension nLocal and with the padded leading dimension that
+ *  dprimme uses by default (primme.ldOPs = 0).
+ *
+ *  Usage: bench_ld [repetitions]
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "primme.h"
+#include "wtime.h"
+#include "num.h"
+
+#define BASIS_SIZE   24   /* columns of V, as maxBasisSize               */
+#define RESTART_SIZE 12   /* columns of V*hVecs, as restartSize          */
+#define BLOCK_SIZE   4    /* new columns of W in update_projection       */
+
+static void bench(int n, int ld, int reps, double *tRestart, double *tProj);
+static void record_ld(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme);
+
+static int ldSeen;   /* ldx passed to the last call of record_ld */
+
+int main (int argc, char *argv[]) {
+
+   int i, k, n, ldPad, reps;
+   double tRestart, tProj, tRestartPad, tProjPad, eval, resNorm, *evec;
+   primme_params primme;
+
+   reps = argc > 1 ? atoi(argv[1]) : 20;
+
+   printf("%10s %10s %12s %12s %8s %12s %12s %8s\n", "n", "ldOPs",
+      "V*h (ld=n)", "V*h (pad)", "speedup", "V'W (ld=n)", "V'W (pad)",
+      "speedup");
+
+   for (k = 12; k <= 18; k++) {
+      for (i = -1; i <= 0; i++) {
+         n = (1 << k) + i;
+
+         /* Catch the default leading dimension that dprimme passes to */
+         /* the matvec. With A = I it converges at the first check.    */
+         primme_initialize(&primme);
+         primme.n = n;
+         primme.numEvals = 1;
+         primme.matrixMatvec = record_ld;
+         primme_set_method(DEFAULT_MIN_TIME, &primme);
+         evec = (double *)primme_calloc(n, sizeof(double), "evec");
+         dprimme(&eval, evec, &resNorm, &primme);
+         ldPad = ldSeen;
+         primme_Free(&primme);
+         free(evec);
+
+         bench(n, n, reps, &tRestart, &tProj);
+         bench(n, ldPad, reps, &tRestartPad, &tProjPad);
+
+         printf("%10d %10d %12.3e %12.3e %8.2f %12.3e %12.3e %8.2f\n", n,
+            ldPad, tRestart, tRestartPad, tRestart/tRestartPad, tProj,
+            tProjPad, tProj/tProjPad);
+      }
+   }
+
+   return 0;
+}
+
+/******************************************************************************
+ * Times the products Y = V*h, with V n x BASIS_SIZE and Y n x RESTART_SIZE,
+ * and Z = V'*W(:,1:BLOCK_SIZE), with both V and W stored with leading
+ * dimension ld. It returns the average time in seconds of each product.
+ *
+******************************************************************************/
+
+static void bench(int n, int ld, int reps, double *tRestart, double *tProj) {
+
+   int i;
+   double *V, *W, *Y, *h, *Z, t0;
+
+   V = (double *)primme_valloc(sizeof(double)*ld*BASIS_SIZE, "V");
+   W = (double *)primme_valloc(sizeof(double)*ld*BASIS_SIZE, "W");
+   Y = (double *)primme_valloc(sizeof(double)*ld*RESTART_SIZE, "Y");
+   h = (double *)primme_valloc(sizeof(double)*BASIS_SIZE*RESTART_SIZE, "h");
+   Z = (double *)primme_valloc(sizeof(double)*BASIS_SIZE*BLOCK_SIZE, "Z");
+
+   for (i = 0; i < ld*BASIS_SIZE; i++) {
+      V[i] = (double)(i % 97)/97.0;
+      W[i] = (double)(i % 89)/89.0;
+   }
+   for (i = 0; i < ld*RESTART_SIZE; i++) Y[i] = 0.0;
+   for (i = 0; i < BASIS_SIZE*RESTART_SIZE; i++) h[i] = (double)(i % 7)/7.0;
+
+   /* Warm up */
+   Num_gemm_dprimme("N", "N", n, RESTART_SIZE, BASIS_SIZE, 1.0, V, ld, h,
+      BASIS_SIZE, 0.0, Y, ld);
+
+   t0 = primme_get_wtime();
+   for (i = 0; i < reps; i++) {
+      Num_gemm_dprimme("N", "N", n, RESTART_SIZE, BASIS_SIZE, 1.0, V, ld, h,
+         BASIS_SIZE, 0.0, Y, ld);
+   }
+   *tRestart = (primme_get_wtime() - t0)/reps;
+
+   t0 = primme_get_wtime();
+   for (i = 0; i < reps; i++) {
+      Num_gemm_dprimme("C", "N", BASIS_SIZE, BLOCK_SIZE, n, 1.0, V, ld,
+         &W[ld*(BASIS_SIZE-BLOCK_SIZE)], ld, 0.0, Z, BASIS_SIZE);
+   }
+   *tProj = (primme_get_wtime() - t0)/reps;
+
+   free(V); free(W); free(Y); free(h); free(Z);
+}
+
+/******************************************************************************
+ * Matvec of the identity that records the leading dimension of x.
+ *
+******************************************************************************/
+
+static void record_ld(void *x, int *ldx, void *y, int *ldy, int *blockSize,
+   primme_params *primme) {
+
+   int i, j;
+
+   ldSeen = *ldx;
+   for (j = 0; j < *blockSize; j++) {
+      for (i = 0; i < primme->nLocal; i++) {
+         ((double *)y)[*ldy*j+i] = ((double *)x)[*ldx*j+i];
+      }
+   }
+}
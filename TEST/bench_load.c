@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Load-time benchmark of the native driver matrix: reading the MatrixMarket
+ *  text file against mapping the same matrix stored in binary CSR, both in
+ *  full and in half storage. The time of each load includes the checks and
+ *  the Frobenius norm that readMatrixNative computes, which reads all the
+ *  entries, so the mapped pages are actually read in.
+ *
+ *  Usage: bench_load matrix.mtx [matrix.bcsr]
+ *
+ *  If matrix.bcsr is not given, the binary file is written to
+ *  bench_load.bcsr and removed at the end.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "primme.h"
+#include "wtime.h"
+#include "csr.h"
+
+typedef int (*read_fn)(const char* matrixFileName, CSRMatrix **matrix_,
+   double *fnorm);
+
+static double bench(read_fn f, const char *fileName, double *fnorm);
+
+int main (int argc, char *argv[]) {
+
+   const char *textFile, *binFile;
+   double tText, tTextHalf, tWrite, tBin, tBinHalf, fText, fBin, fBinHalf, t0;
+   CSRMatrix *matrix;
+
+   if (argc < 2) {
+      fprintf(stderr, "Usage: %s matrix.mtx [matrix.bcsr]\n", argv[0]);
+      return 1;
+   }
+   textFile = argv[1];
+   binFile = argc > 2 ? argv[2] : "bench_load.bcsr";
+
+   tText = bench(readMatrixNative, textFile, &fText);
+   tTextHalf = bench(readSymMatrixNative, textFile, NULL);
+
+   if (readSymMatrixNative(textFile, &matrix, NULL) != 0) return 1;
+   t0 = primme_get_wtime();
+   if (writeBinaryCSRMatrix(binFile, matrix) != 0) {
+      fprintf(stderr, "ERROR: Could not write %s\n", binFile);
+      return 1;
+   }
+   tWrite = primme_get_wtime() - t0;
+   printf("%s: n = %d, nnz = %d%s\n", textFile, matrix->n, matrix->nnz,
+      matrix->symmetric ? " in half storage" : "");
+   destroyCSRMatrix(matrix);
+
+   tBin = bench(readMatrixNative, binFile, &fBin);
+   tBinHalf = bench(readSymMatrixNative, binFile, &fBinHalf);
+
+   printf("%-28s %12s %8s\n", "load", "time (s)", "speedup");
+   printf("%-28s %12.3e %8.2f\n", "text, full", tText, 1.0);
+   printf("%-28s %12.3e %8.2f\n", "text, half storage", tTextHalf,
+      tText/tTextHalf);
+   printf("%-28s %12.3e\n", "write binary", tWrite);
+   printf("%-28s %12.3e %8.2f\n", "binary, expanded to full", tBin,
+      tText/tBin);
+   printf("%-28s %12.3e %8.2f\n", "binary, mapped", tBinHalf,
+      tText/tBinHalf);
+   printf("Frobenius norms: text %.15e, binary %.15e, mapped %.15e\n", fText,
+      fBin, fBinHalf);
+
+   if (argc <= 2) remove(binFile);
+   return 0;
+}
+
+/******************************************************************************
+ * Returns the time in seconds of loading the matrix with f and freeing it.
+ * The first load warms up the page cache, and the smallest time of the
+ * next three is returned.
+ *
+******************************************************************************/
+
+static double bench(read_fn f, const char *fileName, double *fnorm) {
+
+   int trial;
+   double t0, t, tmin = HUGE_VAL, norm;
+   CSRMatrix *matrix;
+
+   for (trial = 0; trial < 4; trial++) {
+      t0 = primme_get_wtime();
+      if (f(fileName, &matrix, &norm) != 0) exit(1);
+      destroyCSRMatrix(matrix);
+      t = primme_get_wtime() - t0;
+      if (trial > 0 && t < tmin) tmin = t;
+   }
+   if (fnorm) *fnorm = norm;
+   return tmin;
+}
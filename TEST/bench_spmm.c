@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Microbenchmark of the block product of the native driver matrix: the
+ *  CSR kernel CSRMatrixMatvec, which reads the matrix once per 4 vectors,
+ *  the same kernel on the matrix in half storage if it is symmetric, and
+ *  the SELL-C-sigma kernel SELLMatrixMatvec, against the previous
+ *  CSRMatrixMatvecAmux, which calls SPARSKIT amux once per vector. Build
+ *  the driver objects with -fopenmp to time the kernels with
+ *  OMP_NUM_THREADS threads, and with -mavx512f or -mavx2 -mfma to time the
+ *  vectorized SELL kernels.
+ *
+ *  Usage: bench_spmm [matrix.mtx [repetitions]]
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "primme.h"
+#include "wtime.h"
+#include "native.h"
+#include "sell.h"
+
+#define MAX_BLOCK_SIZE 16
+#define TRIALS         3
+
+typedef void (*matvec_fn)(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, primme_params *primme);
+
+static double bench(matvec_fn f, double *x, double *y, int blockSize, int reps,
+   primme_params *primme);
+
+int main (int argc, char *argv[]) {
+
+   int i, bs, reps;
+   const char *matrixFile;
+   double *x, *y, *ySym, *ySell, *yAmux, tAmux, tBlock, tSym, tSell, diff,
+      fnorm;
+   CSRMatrix *matrix, *half;
+   SELLMatrix *sell;
+   primme_params primme, primmeSym, primmeSell;
+
+   matrixFile = argc > 1 ? argv[1] : "LUNDA.mtx";
+   reps = argc > 2 ? atoi(argv[2]) : 20;
+
+   if (readMatrixNative(matrixFile, &matrix, &fnorm) != 0) return 1;
+   if (readSymMatrixNative(matrixFile, &half, &fnorm) != 0) return 1;
+
+   primme_initialize(&primme);
+   primme.matrix = matrix;
+   primme.n = primme.nLocal = matrix->n;
+   primmeSym = primme;
+   primmeSym.matrix = half;
+   createSELLMatrix(matrix, &sell);
+   primmeSell = primme;
+   primmeSell.matrix = sell;
+
+   x = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE, "x");
+   y = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE, "y");
+   ySym = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE,
+      "ySym");
+   ySell = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE,
+      "ySell");
+   yAmux = (double *)primme_valloc(sizeof(double)*matrix->n*MAX_BLOCK_SIZE,
+      "yAmux");
+   for (i = 0; i < matrix->n*MAX_BLOCK_SIZE; i++) {
+      x[i] = (double)(i % 97)/97.0;
+   }
+
+   printf("%s: n = %d, nnz = %d, nnz in half storage = %d\n", matrixFile,
+      matrix->n, matrix->nnz, half->symmetric ? half->nnz : matrix->nnz);
+   printf("%10s %10s %10s %8s %10s %8s %10s %8s %10s\n", "blockSize",
+      "amux", "block", "speedup", "sym", "speedup", "sell", "speedup",
+      "max |diff|");
+
+   for (bs = 1; bs <= MAX_BLOCK_SIZE; bs *= 2) {
+      tAmux = bench(CSRMatrixMatvecAmux, x, yAmux, bs, reps, &primme);
+      tBlock = bench(CSRMatrixMatvec, x, y, bs, reps, &primme);
+      tSym = bench(CSRMatrixMatvec, x, ySym, bs, reps, &primmeSym);
+      tSell = bench(SELLMatrixMatvec, x, ySell, bs, reps, &primmeSell);
+
+      diff = 0.0;
+      for (i = 0; i < matrix->n*bs; i++) {
+         diff = fmax(diff, fabs(y[i] - yAmux[i]));
+         diff = fmax(diff, fabs(ySym[i] - yAmux[i]));
+         diff = fmax(diff, fabs(ySell[i] - yAmux[i]));
+      }
+
+      printf("%10d %10.3e %10.3e %8.2f %10.3e %8.2f %10.3e %8.2f %10.3e\n",
+         bs, tAmux, tBlock, tAmux/tBlock, tSym, tAmux/tSym, tSell,
+         tAmux/tSell, diff);
+   }
+
+   destroySELLMatrix(sell);
+   destroyCSRMatrix(half);
+   destroyCSRMatrix(matrix);
+   free(x); free(y); free(ySym); free(ySell); free(yAmux);
+   return 0;
+}
+
+/******************************************************************************
+ * Returns the time in seconds of y = A*x with blockSize vectors, stored
+ * with leading dimension n, averaged over reps products. The smallest of
+ * TRIALS such averages is returned to filter out the noise of other
+ * processes.
+ *
+******************************************************************************/
+
+static double bench(matvec_fn f, double *x, double *y, int blockSize, int reps,
+   primme_params *primme) {
+
+   int i, trial;
+   double t0, t, tmin = HUGE_VAL;
+
+   /* Warm up */
+   f(x, &primme->n, y, &primme->n, &blockSize, primme);
+
+   for (trial = 0; trial < TRIALS; trial++) {
+      t0 = primme_get_wtime();
+      for (i = 0; i < reps; i++) {
+         f(x, &primme->n, y, &primme->n, &blockSize, primme);
+      }
+      t = (primme_get_wtime() - t0)/reps;
+      if (t < tmin) tmin = t;
+   }
+   return tmin;
+}
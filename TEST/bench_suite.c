@@ -0,0 +1,396 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Benchmark suite on synthetic matrices (see COMMON/generators.c):
+ *
+ *     lap2d     2D Laplacian, 5-point stencil
+ *     lap3d     3D Laplacian, 7-point stencil
+ *     aniso     2D anisotropic diffusion, -(u_xx + 1e-2 u_yy)
+ *     graph     Laplacian of a random graph with average degree 8
+ *     anderson  3D Anderson Hamiltonian with disorder 16.5 (and a magnetic
+ *               flux of 0.1 in the complex version)
+ *
+ *  It runs the smallest eigenvalues of every combination of matrix, size,
+ *  number of eigenvalues, block size and preset method, and writes one
+ *  record per run, in CSV or JSON, with the wall time, the counts and the
+ *  time per phase of primme.stats, and the memory: the work space of
+ *  PRIMME, the matrix and the peak resident size of the process so far.
+ *  The label (e.g., the output of git describe) tells the versions apart
+ *  when the files of several are merged. Build bench_suite_double for real
+ *  matrices and bench_suite_doublecomplex for complex ones.
+ *
+ *  Usage: bench_suite_double [options]
+ *     -m lap2d,lap3d,aniso,graph,anderson   matrices
+ *     -n 1000,10000          approximate sizes (rounded to whole grids)
+ *     -e 1,10                numEvals
+ *     -b 1,4                 maxBlockSize
+ *     -p DYNAMIC,...         preset methods, as in the driver configuration
+ *     -P davidsonjacobi      preconditioner: none, jacobi or davidsonjacobi
+ *     -t 1e-10               primme.eps
+ *     -M 100000              primme.maxMatvecs
+ *     -f csv                 output format: csv or json
+ *     -o file                output file (standard output by default)
+ *     -l label               label of the records
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#  include <sys/resource.h>
+#endif
+#include "primme.h"
+#include "wtime.h"
+#include "native.h"
+#include "generators.h"
+
+#define MAX_LIST     32
+#define ANISOTROPY   1e-2
+#define GRAPH_DEGREE 8
+#define DISORDER     16.5
+#define FLUX         0.1
+#define SEED         1
+
+static const char *matrixNames[] = {"lap2d", "lap3d", "aniso", "graph",
+   "anderson"};
+#define NUM_MATRICES ((int)(sizeof(matrixNames)/sizeof(matrixNames[0])))
+
+static const char *methodNames[] = {"DYNAMIC", "DEFAULT_MIN_TIME",
+   "DEFAULT_MIN_MATVECS", "Arnoldi", "GD", "GD_plusK", "GD_Olsen_plusK",
+   "JD_Olsen_plusK", "RQI", "JDQR", "JDQMR", "JDQMR_ETol",
+   "SUBSPACE_ITERATION", "LOBPCG_OrthoBasis", "LOBPCG_OrthoBasis_Window"};
+#define NUM_METHODS ((int)(sizeof(methodNames)/sizeof(methodNames[0])))
+
+static const char *precNames[] = {"none", "jacobi", "davidsonjacobi"};
+#define NUM_PRECS ((int)(sizeof(precNames)/sizeof(precNames[0])))
+
+typedef struct {
+   const char *matrix, *method, *prec;
+   int n, nnz, numEvals, blockSize, ret, converged;
+   double wallTime, maxResNorm;
+   long int matrixBytes, maxRSSBytes;
+   primme_params primme;
+} record;
+
+static int parseList(char *arg, const char **names, int numNames, int *list);
+static int parseInts(char *arg, int *list);
+static int generate(int matrix, int size, CSRMatrix **A);
+static int run(CSRMatrix *A, int prec, int method, int numEvals,
+   int blockSize, double eps, int maxMatvecs, record *r);
+static long int maxRSS(void);
+static void writeRecord(FILE *f, int json, int first, const char *label,
+   const record *r);
+
+int main (int argc, char *argv[]) {
+
+   int matrices[MAX_LIST], sizes[MAX_LIST], numEvals[MAX_LIST],
+      blockSizes[MAX_LIST], methods[MAX_LIST];
+   int numMatrices, numSizes, numNumEvals, numBlockSizes, numMethods;
+   int prec = 2, json = 0, maxMatvecs = 100000, count = 0, bad = 0;
+   int i, im, is, ie, ib, ip;
+   double eps = 1e-10;
+   const char *label = "", *outputFileName = NULL;
+   char opt, *arg, defMatrices[] = "lap2d,lap3d,aniso,graph,anderson",
+        defSizes[] = "1000,10000", defNumEvals[] = "1,10",
+        defBlockSizes[] = "1,4",
+        defMethods[] = "DYNAMIC,DEFAULT_MIN_TIME,DEFAULT_MIN_MATVECS";
+   FILE *f = stdout;
+   CSRMatrix *A;
+   record r;
+
+   numMatrices = parseList(defMatrices, matrixNames, NUM_MATRICES, matrices);
+   numSizes = parseInts(defSizes, sizes);
+   numNumEvals = parseInts(defNumEvals, numEvals);
+   numBlockSizes = parseInts(defBlockSizes, blockSizes);
+   numMethods = parseList(defMethods, methodNames, NUM_METHODS, methods);
+
+   for (i = 1; i < argc; i++) {
+      if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0'
+            || i+1 >= argc) {
+         fprintf(stderr, "Usage: %s [-m matrices] [-n sizes] [-e numEvals] "
+            "[-b blockSizes] [-p methods] [-P prec] [-t eps] [-M maxMatvecs] "
+            "[-f csv|json] [-o file] [-l label]\n", argv[0]);
+         return 1;
+      }
+      opt = argv[i++][1];
+      arg = argv[i];
+      switch(opt) {
+      case 'm': numMatrices = parseList(arg, matrixNames, NUM_MATRICES,
+                   matrices); break;
+      case 'n': numSizes = parseInts(arg, sizes); break;
+      case 'e': numNumEvals = parseInts(arg, numEvals); break;
+      case 'b': numBlockSizes = parseInts(arg, blockSizes); break;
+      case 'p': numMethods = parseList(arg, methodNames, NUM_METHODS,
+                   methods); break;
+      case 'P': bad |= parseList(arg, precNames, NUM_PRECS, &prec) != 1;
+                break;
+      case 't': eps = atof(arg); break;
+      case 'M': maxMatvecs = atoi(arg); break;
+      case 'f': json = strcmp(arg, "json") == 0;
+                bad |= !json && strcmp(arg, "csv") != 0;
+                break;
+      case 'o': outputFileName = arg; break;
+      case 'l': label = arg; break;
+      default:  bad = 1;
+      }
+   }
+   if (numMatrices <= 0 || numSizes <= 0 || numNumEvals <= 0
+         || numBlockSizes <= 0 || numMethods <= 0 || bad) {
+      fprintf(stderr, "ERROR: Invalid option, see the head of bench_suite.c\n");
+      return 1;
+   }
+   if (outputFileName && (f = fopen(outputFileName, "w")) == NULL) {
+      fprintf(stderr, "ERROR: Could not open %s\n", outputFileName);
+      return 1;
+   }
+
+   if (json) fprintf(f, "[\n");
+   for (im = 0; im < numMatrices; im++) {
+      for (is = 0; is < numSizes; is++) {
+         if (generate(matrices[im], sizes[is], &A) != 0) {
+            fprintf(stderr, "ERROR: Could not generate %s of size %d\n",
+               matrixNames[matrices[im]], sizes[is]);
+            return 1;
+         }
+         for (ie = 0; ie < numNumEvals; ie++) {
+            if (numEvals[ie] > A->n) continue;
+            for (ib = 0; ib < numBlockSizes; ib++) {
+               for (ip = 0; ip < numMethods; ip++) {
+                  r.matrix = matrixNames[matrices[im]];
+                  if (run(A, prec, methods[ip], numEvals[ie], blockSizes[ib],
+                           eps, maxMatvecs, &r) != 0) {
+                     return 1;
+                  }
+                  writeRecord(f, json, count++ == 0, label, &r);
+                  fflush(f);
+               }
+            }
+         }
+         destroyCSRMatrix(A);
+      }
+   }
+   if (json) fprintf(f, "\n]\n");
+
+   if (f != stdout) fclose(f);
+   return 0;
+}
+
+/******************************************************************************
+ * Returns in A the matrix with about size rows.
+ *
+******************************************************************************/
+static int generate(int matrix, int size, CSRMatrix **A) {
+
+   int nx2 = (int)floor(sqrt((double)size) + 0.5),
+       nx3 = (int)floor(cbrt((double)size) + 0.5);
+
+   if (nx2 < 2) nx2 = 2;
+   if (nx3 < 2) nx3 = 2;
+   switch(matrix) {
+   case 0: return generateLaplacian(nx2, nx2, 1, 1.0, 1.0, 0.0, A);
+   case 1: return generateLaplacian(nx3, nx3, nx3, 1.0, 1.0, 1.0, A);
+   case 2: return generateLaplacian(nx2, nx2, 1, 1.0, ANISOTROPY, 0.0, A);
+   case 3: return generateGraphLaplacian(size, GRAPH_DEGREE, SEED, A);
+   case 4: return generateAnderson(nx3, DISORDER, FLUX, SEED, A);
+   }
+   return -1;
+}
+
+/******************************************************************************
+ * Computes the numEvals smallest eigenvalues of A and fills r.
+ *
+******************************************************************************/
+static int run(CSRMatrix *A, int prec, int method, int numEvals,
+   int blockSize, double eps, int maxMatvecs, record *r) {
+
+   int i;
+   double *evals, *rnorms, *diag = NULL, t0;
+   PRIMME_NUM *evecs;
+   primme_params primme;
+
+   primme_initialize(&primme);
+   primme.n = primme.nLocal = A->n;
+   primme.matrix = A;
+   primme.matrixMatvec = CSRMatrixMatvec;
+   primme.numEvals = numEvals;
+   primme.target = primme_smallest;
+   primme.eps = eps;
+   primme.maxMatvecs = maxMatvecs;
+   if (prec == 1) {
+      createInvDiagPrecNative(A, 0.0, &diag);
+      primme.applyPreconditioner = ApplyInvDiagPrecNative;
+   }
+   else if (prec == 2) {
+      createInvDavidsonDiagPrecNative(A, &diag);
+      primme.applyPreconditioner = ApplyInvDavidsonDiagPrecNative;
+   }
+   primme.preconditioner = diag;
+   primme.correctionParams.precondition = diag != NULL;
+   if (primme_set_method((primme_preset_method)method, &primme) < 0) {
+      fprintf(stderr, "ERROR: Could not set method %s\n", methodNames[method]);
+      return -1;
+   }
+   primme.maxBlockSize = blockSize;
+
+   evals = (double *)primme_calloc(numEvals, sizeof(double), "evals");
+   rnorms = (double *)primme_calloc(numEvals, sizeof(double), "rnorms");
+   evecs = (PRIMME_NUM *)primme_calloc((size_t)A->n*numEvals,
+         sizeof(PRIMME_NUM), "evecs");
+
+   t0 = primme_get_wtime();
+   r->ret = PREFIX(primme)(evals, COMPLEXZ(evecs), rnorms, &primme);
+   r->wallTime = primme_get_wtime() - t0;
+
+   r->method = methodNames[method];
+   r->prec = precNames[prec];
+   r->n = A->n;
+   r->nnz = A->nnz;
+   r->numEvals = numEvals;
+   r->blockSize = blockSize;
+   /* initSize is only meaningful on success; e.g., it may be negative if */
+   /* pairs became unconverged when maxMatvecs was reached                  */
+   r->converged = primme.initSize < 0 ? 0 :
+      primme.initSize > numEvals ? numEvals : primme.initSize;
+   for (i = 0, r->maxResNorm = 0.0; i < r->converged; i++) {
+      if (rnorms[i] > r->maxResNorm) r->maxResNorm = rnorms[i];
+   }
+   r->matrixBytes = (long int)(A->n+1)*sizeof(int)
+      + (long int)A->nnz*(sizeof(int) + sizeof(PRIMME_NUM));
+   r->maxRSSBytes = maxRSS();
+   r->primme = primme;
+
+   primme_Free(&primme);
+   free(diag);
+   free(evals);
+   free(rnorms);
+   free(evecs);
+   return 0;
+}
+
+/******************************************************************************
+ * Fills list with the indices in names of the items of the comma separated
+ * arg, and returns how many there are, or -1 if one is not in names.
+ *
+******************************************************************************/
+static int parseList(char *arg, const char **names, int numNames, int *list) {
+
+   int i, n = 0;
+   char *item;
+
+   for (item = strtok(arg, ","); item; item = strtok(NULL, ",")) {
+      for (i = 0; i < numNames && strcmp(item, names[i]) != 0; i++);
+      if (i >= numNames || n >= MAX_LIST) return -1;
+      list[n++] = i;
+   }
+   return n;
+}
+
+/* Same for a list of positive integers */
+static int parseInts(char *arg, int *list) {
+
+   int n = 0;
+   char *item;
+
+   for (item = strtok(arg, ","); item; item = strtok(NULL, ",")) {
+      if (n >= MAX_LIST || (list[n++] = (int)atof(item)) <= 0) return -1;
+   }
+   return n;
+}
+
+/* Peak resident size of the process in bytes, or -1 if unknown */
+static long int maxRSS(void) {
+
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+   struct rusage usage;
+
+   if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#  if defined (__APPLE__)
+      return usage.ru_maxrss;
+#  else
+      return usage.ru_maxrss*1024L;
+#  endif
+   }
+#endif
+   return -1;
+}
+
+/******************************************************************************
+ * Writes the record as a line of CSV, after the header if first, or as an
+ * object of a JSON array, after a comma if not first.
+ *
+******************************************************************************/
+static void writeRecord(FILE *f, int json, int first, const char *label,
+   const record *r) {
+
+   const primme_stats *s = &r->primme.stats;
+#ifdef USE_DOUBLECOMPLEX
+   const char *arithmetic = "complex";
+#else
+   const char *arithmetic = "double";
+#endif
+
+   if (json) {
+      fprintf(f, "%s  {\"label\": \"%s\", \"arithmetic\": \"%s\", "
+         "\"matrix\": \"%s\", \"n\": %d, \"nnz\": %d, \"method\": \"%s\", "
+         "\"numEvals\": %d, \"blockSize\": %d, \"precond\": \"%s\", "
+         "\"ret\": %d, \"converged\": %d, \"maxResNorm\": %.3e,\n"
+         "   \"wallTime\": %.6e, \"iterations\": %d, \"restarts\": %d, "
+         "\"matvecs\": %d, \"preconds\": %d,\n"
+         "   \"phases\": {\"matvec\": %.6e, \"precond\": %.6e, "
+         "\"ortho\": %.6e, \"update_projection\": %.6e, \"solve_H\": %.6e, "
+         "\"restart\": %.6e, \"locking\": %.6e, \"convergence\": %.6e, "
+         "\"inner_solve\": %.6e, \"globalSum\": %.6e},\n"
+         "   \"realWorkBytes\": %ld, \"intWorkBytes\": %d, "
+         "\"matrixBytes\": %ld, \"maxRSSBytes\": %ld}",
+         first ? "" : ",\n", label, arithmetic, r->matrix, r->n, r->nnz,
+         r->method, r->numEvals, r->blockSize, r->prec, r->ret, r->converged,
+         r->maxResNorm, r->wallTime, s->numOuterIterations, s->numRestarts,
+         s->numMatvecs, s->numPreconds, s->timeMatvec, s->timePrecond,
+         s->timeOrtho, s->timeUpdateProjection, s->timeSolveH,
+         s->timeRestart, s->timeLocking, s->timeConvergence,
+         s->timeInnerSolve, s->timeGlobalSum, r->primme.realWorkSize,
+         r->primme.intWorkSize, r->matrixBytes, r->maxRSSBytes);
+      return;
+   }
+
+   if (first) {
+      fprintf(f, "label,arithmetic,matrix,n,nnz,method,numEvals,blockSize,"
+         "precond,ret,converged,maxResNorm,wallTime,iterations,restarts,"
+         "matvecs,preconds,matvecTime,precondTime,orthoTime,"
+         "updateProjectionTime,solveHTime,restartTime,lockingTime,"
+         "convergenceTime,innerSolveTime,globalSumTime,realWorkBytes,"
+         "intWorkBytes,matrixBytes,maxRSSBytes\n");
+   }
+   fprintf(f, "%s,%s,%s,%d,%d,%s,%d,%d,%s,%d,%d,%.3e,%.6e,%d,%d,%d,%d,"
+      "%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%ld,%d,%ld,%ld\n",
+      label, arithmetic, r->matrix, r->n, r->nnz, r->method, r->numEvals,
+      r->blockSize, r->prec, r->ret, r->converged, r->maxResNorm,
+      r->wallTime, s->numOuterIterations, s->numRestarts, s->numMatvecs,
+      s->numPreconds, s->timeMatvec, s->timePrecond, s->timeOrtho,
+      s->timeUpdateProjection, s->timeSolveH, s->timeRestart,
+      s->timeLocking, s->timeConvergence, s->timeInnerSolve,
+      s->timeGlobalSum, r->primme.realWorkSize, r->primme.intWorkSize,
+      r->matrixBytes, r->maxRSSBytes);
+}
@@ -59,6 +59,10 @@
 #endif
 #ifdef USE_NATIVE
 #  include "native.h"
+#  include "sell.h"
+#  include "reorder.h"
+#  include "amg.h"
+#  include "threadcomm.h"
 #endif
 #ifdef USE_PARASAILS
 #  include "parasailsw.h"
@@ -70,12 +74,19 @@
 /* primme.h header file is required to run primme */
 #include "primme.h"
 #include "shared_utils.h"
+#include "chebyshev.h"
 /* wtime.h header file is included so primme's timimg functions can be used */
 #include "wtime.h"
 
 #define ASSERT_MSG(COND, RETURN, ...) { if (!(COND)) {fprintf(stderr, "Error in " __FUNCT__ ": " __VA_ARGS__); return (RETURN);} }
 
 static int real_main (int argc, char *argv[]);
+static int solve(driver_params driver, primme_params primme,
+                 primme_preset_method method);
+#if defined(USE_NATIVE) && !defined(USE_MPI)
+static int solveThreads(driver_params driver, primme_params primme,
+                        primme_preset_method method);
+#endif
 static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int **permutation);
 #ifdef USE_MPI
 static void broadCast(primme_params *primme, primme_preset_method *method, 
@@ -84,8 +95,16 @@ static void par_GlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
                          primme_params *primme);
 #endif
 static int check_solution(const char *checkXFileName, primme_params *primme, double *evals,
-                          PRIMME_NUM *evecs, double *rnorms, int *perm);
+                          PRIMME_NUM *evecs, double *rnorms, int *perm, int numPairs,
+                          int stopped);
 static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme, int *permutation);
+static void DeferredMatvecBegin(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, void **request, primme_params *primme);
+static void DeferredMatvecWait(void **request, primme_params *primme);
+static int StopMonitor(double *basisEvals, int *basisFlags, int basisSize,
+   int *iblock, double *blockNorms, int blockSize, double *lockedEvals,
+   int numLocked, int numConverged, primme_params *primme);
+static int monitorStop = 0;
 static int writeBinaryEvecsAndPrimmeParams(const char *fileName, PRIMME_NUM *X, int *perm,
                                            primme_params *primme);
 static int readBinaryEvecsAndPrimmeParams(const char *fileName, PRIMME_NUM *X, PRIMME_NUM **Xout,
@@ -128,32 +147,19 @@ int main (int argc, char *argv[]) {
 #define __FUNCT__ "real_main"
 static int real_main (int argc, char *argv[]) {
 
-   /* Timing vars */
-   double wt1,wt2;
-#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
-   double ut1,ut2,st1,st2;
-#endif
-
    /* Files */
    char *DriverConfigFileName=NULL, *SolverConfigFileName=NULL;
    
-   /* Driver and solver I/O arrays and parameters */
-   double *evals, *rnorms;
-   PRIMME_NUM *evecs;
+   /* Driver and solver parameters */
    driver_params driver;
    primme_params primme;
    primme_preset_method method;
-   int *permutation = NULL;
 
-   /* Other miscellaneous items */
-   int ret, retX=0;
-   int i;
    int master = 1;
-   int procID = 0;
 
 #ifdef USE_MPI
    MPI_Comm comm;
-   int numProcs;
+   int numProcs, procID;
    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
    MPI_Comm_rank(MPI_COMM_WORLD, &procID);
 
@@ -208,10 +214,67 @@ static int real_main (int argc, char *argv[]) {
    broadCast(&primme, &method, &driver, master, comm);
 #endif
 
+   /* ------------------------------------------------------------ */
+   /* Optional: run driver.threads solver instances as threads on  */
+   /* blocks of rows of the matrix, as if they were MPI processes  */
+   /* ------------------------------------------------------------ */
+   if (driver.threads > 1) {
+#if defined(USE_NATIVE) && !defined(USE_MPI)
+      return solveThreads(driver, primme, method);
+#else
+      fprintf(stderr, "ERROR: driver.threads needs NATIVE and no MPI!\n");
+      return -1;
+#endif
+   }
+
+   return solve(driver, primme, method);
+}
+
+/******************************************************************************
+ * Sets up the matrix, runs the solver and reports on the process (or thread)
+ * with rank primme.procID.
+ *
+******************************************************************************/
+#undef __FUNCT__
+#define __FUNCT__ "solve"
+static int solve(driver_params driver, primme_params primme,
+                 primme_preset_method method) {
+
+   /* Timing vars */
+   double wt1,wt2;
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+   double ut1,ut2,st1,st2;
+#endif
+
+   /* Solver I/O arrays */
+   double *evals, *rnorms;
+   PRIMME_NUM *evecs;
+   primme_cost_model costModel;
+   int *permutation = NULL;
+
+   /* Other miscellaneous items */
+   int ret, retX=0, numPairs;
+   int i;
+   int master, procID;
+
    /* --------------------------------------- */
    /* Set up matrix vector and preconditioner */
    /* --------------------------------------- */
    if (setMatrixAndPrecond(&driver, &primme, &permutation) != 0) return -1;
+   if (driver.splitMatvec) {
+      primme.matrixMatvecBegin = DeferredMatvecBegin;
+      primme.matrixMatvecWait = DeferredMatvecWait;
+   }
+   if (driver.monitorStop > 0) {
+      monitorStop = driver.monitorStop;
+      primme.monitor = StopMonitor;
+   }
+#ifdef USE_MPI
+   MPI_Comm_rank(MPI_COMM_WORLD, &procID);
+#else
+   procID = primme.procID;
+#endif
+   master = (procID == 0);
 
    /* --------------------------------------- */
    /* Pick one of the default methods(if set) */
@@ -220,6 +283,23 @@ static int real_main (int argc, char *argv[]) {
       fprintf(primme.outputFile, "No preset method. Using custom settings\n");
    }
 
+   /* ---------------------------------------------------------- */
+   /* Optional: dynamic method switching starts from saved model */
+   /* ---------------------------------------------------------- */
+   if (driver.costModelFileName[0]) {
+      FILE *costModelFile;
+
+      memset(&costModel, 0, sizeof(costModel));
+      costModelFile = fopen(driver.costModelFileName, "r");
+      if (costModelFile != NULL) {
+         if (primme_read_cost_model(costModelFile, &costModel) != 0) {
+            costModel.calibrated = 0;
+         }
+         fclose(costModelFile);
+      }
+      primme.costModel = &costModel;
+   }
+
    /* --------------------------------------- */
    /* Optional: report memory requirements    */
    /* --------------------------------------- */
@@ -308,8 +388,44 @@ static int real_main (int argc, char *argv[]) {
    primme_get_time(&ut2,&st2);
 #endif
 
+   /* --------------------------------------------------------------------- */
+   /* Save the event trace, one file per process if parallel (optional)     */
+   /* --------------------------------------------------------------------- */
+   if (driver.traceFileName[0]) {
+      char traceFileName[1100];
+      FILE *traceFile;
+
+      if (primme.numProcs > 1) {
+         sprintf(traceFileName, "%s.%d", driver.traceFileName, primme.procID);
+      }
+      else {
+         sprintf(traceFileName, "%s", driver.traceFileName);
+      }
+      traceFile = fopen(traceFileName, "w");
+      ASSERT_MSG(traceFile != NULL, 1, "Could not open trace file\n");
+      primme_write_trace(traceFile, driver.traceFormat, &primme);
+      fclose(traceFile);
+   }
+
+   /* --------------------------------------------------------------------- */
+   /* Save the cost model for the next run (optional)                       */
+   /* --------------------------------------------------------------------- */
+   if (driver.costModelFileName[0] && master) {
+      FILE *costModelFile = fopen(driver.costModelFileName, "w");
+
+      ASSERT_MSG(costModelFile != NULL, 1, "Could not open cost model file\n");
+      primme_write_cost_model(costModelFile, &costModel);
+      fclose(costModelFile);
+   }
+
    if (driver.checkXFileName[0]) {
-      retX = check_solution(driver.checkXFileName, &primme, evals, evecs, rnorms, permutation);
+      /* After a stop by the monitor or maxTime the first initSize pairs */
+      /* are returned; after reaching maxMatvecs or maxOuterIterations    */
+      /* without locking, all numEvals approximations                     */
+      numPairs = primme.initSize;
+      if (ret == -3 && !primme.locking) numPairs = primme.numEvals;
+      retX = check_solution(driver.checkXFileName, &primme, evals, evecs, rnorms, permutation,
+                            numPairs, ret != 0);
    }
 
    /* --------------------------------------------------------------------- */
@@ -345,6 +461,50 @@ static int real_main (int argc, char *argv[]) {
       fprintf(primme.outputFile, "Restarts  : %-d\n", primme.stats.numRestarts);
       fprintf(primme.outputFile, "Matvecs   : %-d\n", primme.stats.numMatvecs);
       fprintf(primme.outputFile, "Preconds  : %-d\n", primme.stats.numPreconds);
+      if (primme.stats.numPageFaults >= 0) fprintf(primme.outputFile,
+         "PageFaults: %-ld\n", primme.stats.numPageFaults);
+      if (primme.stats.numRemotePages >= 0) fprintf(primme.outputFile,
+         "RemotePages: %-ld\n", primme.stats.numRemotePages);
+      if (primme.stats.bytesStreamed >= 0) fprintf(primme.outputFile,
+         "BytesStreamed: %-ld\n", primme.stats.bytesStreamed);
+      fprintf(primme.outputFile, "\nPhase                    Time    Calls\n");
+      fprintf(primme.outputFile, "matvec            %11.3e %8d\n",
+         primme.stats.timeMatvec, primme.stats.numMatvecCalls);
+      fprintf(primme.outputFile, "preconditioner    %11.3e %8d\n",
+         primme.stats.timePrecond, primme.stats.numPrecondCalls);
+      fprintf(primme.outputFile, "ortho             %11.3e %8d\n",
+         primme.stats.timeOrtho, primme.stats.numOrthoCalls);
+      fprintf(primme.outputFile, "update_projection %11.3e %8d\n",
+         primme.stats.timeUpdateProjection,
+         primme.stats.numUpdateProjectionCalls);
+      fprintf(primme.outputFile, "solve_H           %11.3e %8d\n",
+         primme.stats.timeSolveH, primme.stats.numSolveHCalls);
+      fprintf(primme.outputFile, "restart           %11.3e %8d\n",
+         primme.stats.timeRestart, primme.stats.numRestartCalls);
+      fprintf(primme.outputFile, "locking           %11.3e %8d\n",
+         primme.stats.timeLocking, primme.stats.numLockingCalls);
+      fprintf(primme.outputFile, "convergence       %11.3e %8d\n",
+         primme.stats.timeConvergence, primme.stats.numConvergenceCalls);
+      fprintf(primme.outputFile, "inner_solve       %11.3e %8d\n",
+         primme.stats.timeInnerSolve, primme.stats.numInnerSolveCalls);
+      fprintf(primme.outputFile, "globalSum         %11.3e %8d\n",
+         primme.stats.timeGlobalSum, primme.stats.numGlobalSumCalls);
+      fprintf(primme.outputFile, "Reorthos  : %-d\n", primme.stats.numReorthos);
+      fprintf(primme.outputFile, "Randomized: %-d\n",
+         primme.stats.numRandomizations);
+      fprintf(primme.outputFile, "SumBytes  : %-ld\n",
+         primme.stats.bytesGlobalSum);
+      if (primme.stats.numRestarts > 0) {
+         fprintf(primme.outputFile, "Restart to: %.1f vectors, %.1f previous"
+            " (average)\n", primme.stats.meanRestartSize,
+            primme.stats.meanPrevRetained);
+      }
+      if (primme.autoTune) {
+         fprintf(primme.outputFile, "Tuned     : maxBasisSize %d "
+            "minRestartSize %d maxBlockSize %d (%d changes)\n",
+            primme.stats.tunedBasisSize, primme.stats.tunedRestartSize,
+            primme.stats.tunedBlockSize, primme.stats.numTunings);
+      }
       if (primme.locking && primme.intWork && primme.intWork[0] == 1) {
          fprintf(primme.outputFile, "\nA locking problem has occurred.\n");
          fprintf(primme.outputFile,
@@ -366,16 +526,17 @@ static int real_main (int argc, char *argv[]) {
       }
    }
 
-   fclose(primme.outputFile);
+   if (master) fclose(primme.outputFile);
    destroyMatrixAndPrecond(&driver, &primme, permutation);
    primme_Free(&primme);
    free(evals);
    free(evecs);
    free(rnorms);
 
-   if (ret != 0 && master) {
+   if (ret != driver.expectedRet && master) {
       fprintf(primme.outputFile, 
-         "Error: dprimme returned with nonzero exit status: %d \n",ret);
+         "Error: dprimme returned with exit status %d instead of %d\n", ret,
+         driver.expectedRet);
       return -1;
    }
 
@@ -387,6 +548,70 @@ static int real_main (int argc, char *argv[]) {
 
   return(0);
 }
+
+#if defined(USE_NATIVE) && !defined(USE_MPI)
+typedef struct {
+   driver_params driver;
+   primme_params primme;
+   primme_preset_method method;
+   int ret;
+} solveArgs;
+
+static void *solveThread(void *args_) {
+   solveArgs *args = (solveArgs *)args_;
+
+   args->ret = solve(args->driver, args->primme, args->method);
+   return NULL;
+}
+
+/******************************************************************************
+ * Runs solve on driver.threads threads, with primme.numProcs and
+ * primme.procID set as for MPI processes and a shared ThreadComm as
+ * primme.commInfo. Rank 0 runs on the calling thread.
+ *
+******************************************************************************/
+#undef __FUNCT__
+#define __FUNCT__ "solveThreads"
+static int solveThreads(driver_params driver, primme_params primme,
+                        primme_preset_method method) {
+
+   int i, ret = 0, numThreads = driver.threads;
+   ThreadComm *comm;
+   solveArgs *args;
+   pthread_t *threads;
+
+   ASSERT_MSG(createThreadComm(numThreads, &comm) == 0, -1,
+         "Could not create the group of threads\n");
+   args = (solveArgs *)primme_calloc(numThreads, sizeof(solveArgs), "args");
+   threads = (pthread_t *)primme_calloc(numThreads, sizeof(pthread_t),
+         "threads");
+
+   for (i=0; i<numThreads; i++) {
+      args[i].driver = driver;
+      args[i].primme = primme;
+      args[i].primme.numProcs = numThreads;
+      args[i].primme.procID = i;
+      args[i].primme.commInfo = comm;
+      args[i].method = method;
+   }
+   for (i=1; i<numThreads; i++) {
+      ASSERT_MSG(pthread_create(&threads[i], NULL, solveThread, &args[i]) == 0,
+            -1, "Could not create thread %d\n", i);
+   }
+   solveThread(&args[0]);
+   for (i=1; i<numThreads; i++) {
+      pthread_join(threads[i], NULL);
+   }
+
+   for (i=0; i<numThreads; i++) {
+      if (args[i].ret != 0) ret = -1;
+   }
+   free(args);
+   free(threads);
+   destroyThreadComm(comm);
+   return ret;
+}
+#endif
 /******************************************************************************/
 /* END OF MAIN DRIVER FUNCTION                                                */
 /******************************************************************************/
@@ -413,14 +638,24 @@ static void broadCast(primme_params *primme, primme_preset_method *method,
    MPI_Bcast(driver->initialGuessesFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->saveXFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->checkXFileName, 1024, MPI_CHAR, 0, comm);
+   MPI_Bcast(driver->traceFileName, 1024, MPI_CHAR, 0, comm);
+   MPI_Bcast(&driver->traceFormat, 1, MPI_INT, 0, comm);
+   MPI_Bcast(driver->costModelFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(&driver->initialGuessesPert, 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&driver->matrixChoice, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->reorder, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->threads, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->splitMatvec, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->monitorStop, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->expectedRet, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->PrecChoice, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->isymm, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->level, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->threshold, 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&driver->filter, 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&driver->shift, 1, MPI_DOUBLE, 0, comm);
+   MPI_Bcast(&driver->degree, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->smoother, 1, MPI_INT, 0, comm);
 
    MPI_Bcast(&(primme->numEvals), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->target), 1, MPI_INT, 0, comm);
@@ -442,6 +677,9 @@ static void broadCast(primme_params *primme, primme_preset_method *method,
    MPI_Bcast(&(primme->maxBlockSize), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->maxMatvecs), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->maxOuterIterations), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->maxTime), 1, MPI_DOUBLE, 0, comm);
+   MPI_Bcast(&(primme->autoTune), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->traceSize), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->aNorm), 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&(primme->eps), 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&(primme->printLevel), 1, MPI_INT, 0, comm);
@@ -491,6 +729,8 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
       assert(0);
       break;
    case driver_native:
+   case driver_native_amux:
+   case driver_native_sell:
 #if !defined(USE_NATIVE)
       fprintf(stderr, "ERROR: NATIVE is needed!\n");
       return -1;
@@ -503,16 +743,72 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
       *(MPI_Comm*)primme->commInfo = MPI_COMM_WORLD;
 #  endif
       {
-         CSRMatrix *matrix, *prec;
+         CSRMatrix *matrix = NULL;
+         ThreadMatrix *tmatrix;
+         ILUTPrec *prec;
+         AMGPrec *amg;
          double *diag;
          
-         if (readMatrixNative(driver->matrixFileName, &matrix, &primme->aNorm) !=0 )
+         if (driver->threads > 1 && driver->matrixChoice != driver_native) {
+            fprintf(stderr, "ERROR: driver.threads only supports matrix native!\n");
             return -1;
-         primme->matrix = matrix;
-         primme->matrixMatvec = CSRMatrixMatvec;
-         primme->n = primme->nLocal = matrix->n;
+         }
+
+         /* The CSR product takes symmetric matrices in half storage; SELL
+            and amux need both triangles. With threads, rank 0 reads the
+            matrix and the others take their rows from it */
+         if (driver->threads > 1 && primme->procID != 0) {
+            /* Nothing to read */
+         }
+         else if (driver->matrixChoice == driver_native) {
+            if (readSymMatrixNative(driver->matrixFileName, &matrix,
+                     &primme->aNorm) != 0)
+               return -1;
+         }
+         else if (readMatrixNative(driver->matrixFileName, &matrix, &primme->aNorm) !=0 )
+            return -1;
+         /* Reorder rows and columns for the locality of the accesses to x
+            in the products and in the preconditioner. The eigenvectors
+            stay permuted; the permutation is undone on the initial
+            guesses, saveXFile and checkXFile, as for PETSc partitions */
+         if (matrix && driver->reorder != driver_reorder_none) {
+            CSRMatrix *permuted;
+            *permutation = (int *)primme_calloc(matrix->n, sizeof(int), "perm");
+            if ((driver->reorder == driver_rcm ?
+                     rcmOrdering(matrix, *permutation) :
+                     ndOrdering(matrix, *permutation)) != 0
+                  || permuteCSRMatrix(matrix, *permutation, &permuted) != 0)
+               return -1;
+            destroyCSRMatrix(matrix);
+            matrix = permuted;
+         }
+         if (driver->threads > 1) {
+            /* Each rank keeps a block of rows; the preconditioners are
+               built on the diagonal block, i.e., block Jacobi */
+            double aNorm = primme->procID == 0 ? primme->aNorm : 0.0;
+            int one = 1;
+            if (createThreadMatrix((ThreadComm*)primme->commInfo,
+                     primme->procID, matrix, permutation, &tmatrix) != 0)
+               return -1;
+            primme->matrix = tmatrix;
+            primme->matrixMatvec = ThreadMatrixMatvec;
+            primme->globalSumDouble = ThreadGlobalSumDouble;
+            primme->n = tmatrix->n;
+            primme->nLocal = tmatrix->nLocal;
+            ThreadGlobalSumDouble(&aNorm, &primme->aNorm, &one, primme);
+            matrix = tmatrix->diag;
+         }
+         else {
+            primme->matrix = matrix;
+            if (driver->matrixChoice == driver_native_amux)
+               primme->matrixMatvec = CSRMatrixMatvecAmux;
+            else
+               primme->matrixMatvec = CSRMatrixMatvec;
+            primme->n = primme->nLocal = matrix->n;
+         }
          switch(driver->PrecChoice) {
          case driver_noprecond:
+         case driver_chebyshev:
             primme->preconditioner = NULL;
             primme->applyPreconditioner = NULL;
             break;
@@ -531,6 +827,23 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
             primme->preconditioner = prec;
             primme->applyPreconditioner = ApplyILUTPrecNative;
             break;
+         case driver_amg:
+            if (createAMGPrecNative(matrix, driver->shift, driver->threshold,
+                     driver->smoother == driver_smoother_chebyshev ?
+                     amg_chebyshev : amg_jacobi, &amg) != 0)
+               return -1;
+            primme->preconditioner = amg;
+            primme->applyPreconditioner = ApplyAMGPrecNative;
+            break;
+         }
+         /* The preconditioners are built from the CSR matrix; after that,
+            only the SELL-C-sigma copy is kept */
+         if (driver->matrixChoice == driver_native_sell) {
+            SELLMatrix *sell;
+            createSELLMatrix(matrix, &sell);
+            destroyCSRMatrix(matrix);
+            primme->matrix = sell;
+            primme->matrixMatvec = SELLMatrixMatvec;
          }
       }
 #endif
@@ -579,7 +892,8 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
          *(MPI_Comm*)primme->commInfo = PETSC_COMM_WORLD;
          primme->matrix = matrix;
          primme->matrixMatvec = PETScMatvec;
-         if (driver->PrecChoice == driver_noprecond) {
+         if (driver->PrecChoice == driver_noprecond
+               || driver->PrecChoice == driver_chebyshev) {
             primme->preconditioner = NULL;
             primme->applyPreconditioner = NULL;
          }
@@ -589,6 +903,9 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
             if (driver->PrecChoice == driver_jacobi) {
                ierr = PCSetType(*pc, PCJACOBI); CHKERRQ(ierr);
             }
+            else if (driver->PrecChoice == driver_amg) {
+               ierr = PCSetType(*pc, PCGAMG); CHKERRQ(ierr);
+            }
             else if (driver->PrecChoice == driver_ilut) {
                if (primme->numProcs <= 1) {
                   ierr = PCSetType(*pc, PCICC); CHKERRQ(ierr);
@@ -624,26 +941,47 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
 #if defined(USE_MPI)
    primme->globalSumDouble = par_GlobalSumDouble;
 #endif
+
+   /* The polynomial preconditioner only needs the matrix-vector product,
+      so it works with any matrix */
+   if (driver->PrecChoice == driver_chebyshev) {
+      ChebyshevPrec *cheb;
+      if (createChebyshevPrec(primme, driver->shift,
+               driver->degree > 0 ? driver->degree : 10, &cheb) != 0)
+         return -1;
+      primme->preconditioner = cheb;
+      primme->applyPreconditioner = ApplyChebyshevPrec;
+   }
    return 0;
 }
 
 static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme, int *permutation) {
+   if (driver->PrecChoice == driver_chebyshev) {
+      destroyChebyshevPrec((ChebyshevPrec*)primme->preconditioner);
+      primme->preconditioner = NULL;
+   }
    switch(driver->matrixChoice) {
    case driver_default:
       assert(0);
       break;
    case driver_native:
+   case driver_native_amux:
+   case driver_native_sell:
 #if !defined(USE_NATIVE)
       fprintf(stderr, "ERROR: NATIVE is needed!\n");
       return -1;
 #else
-      free(((CSRMatrix*)primme->matrix)->AElts);
-      free(((CSRMatrix*)primme->matrix)->IA);
-      free(((CSRMatrix*)primme->matrix)->JA);
-      free(primme->matrix);
+      if (driver->threads > 1) {
+         destroyThreadMatrix((ThreadMatrix*)primme->matrix);
+      } else if (driver->matrixChoice == driver_native_sell) {
+         destroySELLMatrix((SELLMatrix*)primme->matrix);
+      } else {
+         destroyCSRMatrix((CSRMatrix*)primme->matrix);
+      }
 
       switch(driver->PrecChoice) {
       case driver_noprecond:
+      case driver_chebyshev:
          break;
       case driver_jacobi:
       case driver_jacobi_i:
@@ -651,12 +989,12 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme,
          break;
       case driver_ilut:
          if (primme->preconditioner) {
-            free(((CSRMatrix*)primme->preconditioner)->AElts);
-            free(((CSRMatrix*)primme->preconditioner)->IA);
-            free(((CSRMatrix*)primme->preconditioner)->JA);
-            free(primme->preconditioner);
+            destroyILUTPrecNative((ILUTPrec*)primme->preconditioner);
          }
          break;
+      case driver_amg:
+         destroyAMGPrecNative((AMGPrec*)primme->preconditioner);
+         break;
       }
 #endif
       break;
@@ -685,7 +1023,8 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme,
          ierr = MatDestroy((Mat*)primme->matrix);CHKERRQ(ierr);
          if (primme->preconditioner) {
          }
-         if (driver->PrecChoice == driver_noprecond) {
+         if (driver->PrecChoice == driver_noprecond
+               || driver->PrecChoice == driver_chebyshev) {
          }
          else if (driver->PrecChoice != driver_jacobi_i) {
             ierr = PCDestroy((PC*)primme->preconditioner);CHKERRQ(ierr);
@@ -707,6 +1046,62 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme,
 }
 
 
+/******************************************************************************
+ * Split-phase matvec for testing primme.matrixMatvecBegin and
+ * primme.matrixMatvecWait. The begin only records the arguments and fills y
+ * with NaN; the wait computes y = A*x with primme.matrixMatvec. If PRIMME
+ * read y, or changed x, before the wait, the results would show it.
+ *
+******************************************************************************/
+typedef struct {
+   void *x, *y;
+   int ldx, ldy, blockSize;
+} DeferredMatvec;
+
+static void DeferredMatvecBegin(void *x, int *ldx, void *y, int *ldy,
+   int *blockSize, void **request, primme_params *primme) {
+
+   DeferredMatvec *mv;
+   PRIMME_NUM *yvec = (PRIMME_NUM *)y;
+   int i, j;
+
+   mv = (DeferredMatvec *)primme_calloc(1, sizeof(DeferredMatvec), "mv");
+   mv->x = x;
+   mv->y = y;
+   mv->ldx = *ldx;
+   mv->ldy = *ldy;
+   mv->blockSize = *blockSize;
+   for (j=0; j<*blockSize; j++) {
+      for (i=0; i<primme->nLocal; i++) {
+         yvec[*ldy*j+i] = NAN;
+      }
+   }
+   *request = mv;
+}
+
+static void DeferredMatvecWait(void **request, primme_params *primme) {
+
+   DeferredMatvec *mv = (DeferredMatvec *)*request;
+
+   primme->matrixMatvec(mv->x, &mv->ldx, mv->y, &mv->ldy, &mv->blockSize,
+      primme);
+   free(mv);
+   *request = NULL;
+}
+
+/******************************************************************************
+ * Monitor for testing primme.monitor. It stops the solver after
+ * driver.monitorStop outer iterations, so that a small value stops it before
+ * the basis has numEvals vectors.
+ *
+******************************************************************************/
+static int StopMonitor(double *basisEvals, int *basisFlags, int basisSize,
+   int *iblock, double *blockNorms, int blockSize, double *lockedEvals,
+   int numLocked, int numConverged, primme_params *primme) {
+
+   return primme->stats.numOuterIterations >= monitorStop;
+}
+
 #ifdef USE_MPI
 /******************************************************************************
  * MPI globalSumDouble function
@@ -722,8 +1117,11 @@ static void par_GlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
 
 #undef __FUNCT__
 #define __FUNCT__ "check_solution"
+/* Checks the first numPairs pairs. If stopped, PRIMME did not finish, and */
+/* only the pairs with residual norm within the tolerance are converged    */
 static int check_solution(const char *checkXFileName, primme_params *primme, double *evals,
-                   PRIMME_NUM *evecs, double *rnorms, int *perm) {
+                   PRIMME_NUM *evecs, double *rnorms, int *perm, int numPairs,
+                   int stopped) {
 
    double eval0, rnorm0, prod, auxd;
    PRIMME_NUM *Ax, *r, *X=NULL, *h, *h0;
@@ -776,16 +1174,20 @@ static int check_solution(const char *checkXFileName, primme_params *primme, dou
       CHECK_PRIMME_PARAM_DOUBLE(eps);
       CHECK_PRIMME_PARAM_DOUBLE(correctionParams.relTolBase);
       CHECK_PRIMME_PARAM(initSize);
-      CHECK_PRIMME_PARAM_TOL(stats.numOuterIterations, 40);
+      /* With autoTune the sizes, and so the iterations, depend on timings */
+      if (!primme->autoTune) {
+         CHECK_PRIMME_PARAM_TOL(stats.numOuterIterations, 40);
+      }
    }
 
    h = (PRIMME_NUM *)primme_calloc(cols*2, sizeof(PRIMME_NUM), "h"); h0 = &h[cols];
    Ax = (PRIMME_NUM *)primme_calloc(primme->nLocal, sizeof(PRIMME_NUM), "Ax");
    r = (PRIMME_NUM *)primme_calloc(primme->nLocal, sizeof(PRIMME_NUM), "r");
    
-   for (i=0; i < primme->initSize; i++) {
+   for (i=0; i < numPairs; i++) {
       /* Check |V(:,i)'A*V(:,i) - evals[i]| < |r|*|A| */
-      primme->matrixMatvec(&evecs[primme->nLocal*i], Ax, &one, primme);
+      primme->matrixMatvec(&evecs[primme->nLocal*i], &primme->nLocal, Ax,
+            &primme->nLocal, &one, primme);
       auxd = REAL_PARTZ(SUF(Num_dot)(primme->nLocal, COMPLEXZ(&evecs[primme->nLocal*i]), 1, COMPLEXZ(Ax), 1));
       if (primme->globalSumDouble) primme->globalSumDouble(&auxd, &eval0, &one, primme);
       else eval0 = auxd;
@@ -803,6 +1205,10 @@ static int check_solution(const char *checkXFileName, primme_params *primme, dou
          fprintf(stderr, "Warning: Eval[%d] = %-22.15E, residual | %5E - %5E | <= %5E\n", i, evals[i], rnorms[i], rnorm0, 4*max(primme->aNorm,fabs(evals[i]))*MACHINE_EPSILON);
          retX = 1;
       }
+      /* After a stop, the unconverged pairs only need accurate residuals */
+      if (stopped && rnorms[i] > primme->eps*primme->aNorm*sqrt((double)(i+1))) {
+         continue;
+      }
       if (rnorm0 > primme->eps*primme->aNorm*sqrt((double)(i+1)) && primme->procID == 0) {
          fprintf(stderr, "Warning: Eval[%d] = %-22.15E, RR residual %5E is larger than tolerance %5E\n", i, evals[i], rnorm0, primme->eps*primme->aNorm*sqrt((double)(i+1)));
          retX = 1;
@@ -30,8 +30,8 @@
 #include <math.h>
 #include "primme.h"   /* header file is required to run primme */ 
 
-void LaplacianMatrixMatvec(void *x, void *y, int *blockSize, primme_params *primme);
-void LaplacianApplyPreconditioner(void *x, void *y, int *blockSize, primme_params *primme);
+void LaplacianMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme);
+void LaplacianApplyPreconditioner(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme);
 
 int main (int argc, char *argv[]) {
 
@@ -142,8 +142,8 @@ int main (int argc, char *argv[]) {
 
 /* 1-D Laplacian block matrix-vector product, Y = A * X, where
 
-   - X, input dense matrix of size primme.n x blockSize;
-   - Y, output dense matrix of size primme.n x blockSize;
+   - X, input dense matrix of size primme.n x blockSize with leading dimension ldx;
+   - Y, output dense matrix of size primme.n x blockSize with leading dimension ldy;
    - A, tridiagonal square matrix of dimension primme.n with this form:
 
         [ 2 -1  0  0  0 ... ]
@@ -152,7 +152,7 @@ int main (int argc, char *argv[]) {
          ...
 */
 
-void LaplacianMatrixMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
+void LaplacianMatrixMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme) {
    
    int i;            /* vector index, from 0 to *blockSize-1*/
    int row;          /* Laplacian matrix row index, from 0 to matrix dimension */
@@ -160,8 +160,8 @@ void LaplacianMatrixMatvec(void *x, void *y, int *blockSize, primme_params *prim
    double *yvec;     /* pointer to i-th output vector y */
    
    for (i=0; i<*blockSize; i++) {
-      xvec = (double *)x + primme->n*i;
-      yvec = (double *)y + primme->n*i;
+      xvec = (double *)x + *ldx*i;
+      yvec = (double *)y + *ldy*i;
       for (row=0; row<primme->n; row++) {
          yvec[row] = 0.0;
          if (row-1 >= 0) yvec[row] += -1.0*xvec[row-1];
@@ -173,12 +173,12 @@ void LaplacianMatrixMatvec(void *x, void *y, int *blockSize, primme_params *prim
 
 /* This performs Y = M^{-1} * X, where
 
-   - X, input dense matrix of size primme.n x blockSize;
-   - Y, output dense matrix of size primme.n x blockSize;
+   - X, input dense matrix of size primme.n x blockSize with leading dimension ldx;
+   - Y, output dense matrix of size primme.n x blockSize with leading dimension ldy;
    - M, diagonal square matrix of dimension primme.n with 2 in the diagonal.
 */
 
-void LaplacianApplyPreconditioner(void *x, void *y, int *blockSize, primme_params *primme) {
+void LaplacianApplyPreconditioner(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme) {
    
    int i;            /* vector index, from 0 to *blockSize-1*/
    int row;          /* Laplacian matrix row index, from 0 to matrix dimension */
@@ -186,8 +186,8 @@ void LaplacianApplyPreconditioner(void *x, void *y, int *blockSize, primme_param
    double *yvec;     /* pointer to i-th output vector y */
     
    for (i=0; i<*blockSize; i++) {
-      xvec = (double *)x + primme->n*i;
-      yvec = (double *)y + primme->n*i;
+      xvec = (double *)x + *ldx*i;
+      yvec = (double *)y + *ldy*i;
       for (row=0; row<primme->n; row++) {
          yvec[row] = xvec[row]/2.;
       }      
@@ -171,8 +171,8 @@
 
 !       1-D Laplacian block matrix-vector product, Y = A * X, where
 !      
-!       - X, input dense matrix of size primme.n x blockSize;
-!       - Y, output dense matrix of size primme.n x blockSize;
+!       - X, input dense matrix of size primme.n x blockSize with leading dimension ldx;
+!       - Y, output dense matrix of size primme.n x blockSize with leading dimension ldy;
 !       - A, tridiagonal square matrix of dimension primme.n with this form:
 !      
 !             2 -1  0  0  0 ... 
@@ -180,23 +180,23 @@
 !             0 -1  2 -1  0 ... 
 !             ...
 !      
-        subroutine MV(x,y,k,primme)
+        subroutine MV(x,ldx,y,ldy,k,primme)
 !       ----------------------------------------------------------------
         implicit none
         include 'primme_f77.h'
         real*8 x(*), y(*)
         integer*8 primme
-        integer k,i,j,n
+        integer ldx,ldy,k,i,j,n
         call primme_get_member_f77(primme, PRIMMEF77_n, n)
         do j=0,k-1
            do i=1,n
-              y(j*n+i) = 0
+              y(j*ldy+i) = 0
               if (i.ge.2) then
-                 y(j*n+i) = y(j*n+i) - x(j*n+i-1)
+                 y(j*ldy+i) = y(j*ldy+i) - x(j*ldx+i-1)
               endif
-              y(j*n+i) = y(j*n+i) + 2.*x(j*n+i)
+              y(j*ldy+i) = y(j*ldy+i) + 2.*x(j*ldx+i)
               if (i.le.n-1) then
-                 y(j*n+i) = y(j*n+i) - x(j*n+i+1)
+                 y(j*ldy+i) = y(j*ldy+i) - x(j*ldx+i+1)
               endif
            enddo
         enddo
@@ -204,21 +204,21 @@
 
 !       This performs Y = M^{-1} * X, where
 !      
-!       - X, input dense matrix of size primme.n x blockSize;
-!       - Y, output dense matrix of size primme.n x blockSize;
+!       - X, input dense matrix of size primme.n x blockSize with leading dimension ldx;
+!       - Y, output dense matrix of size primme.n x blockSize with leading dimension ldy;
 !       - M, diagonal square matrix of dimension primme.n with 2 in the diagonal.
 !      
-        subroutine ApplyPrecon(x,y,k,primme)
+        subroutine ApplyPrecon(x,ldx,y,ldy,k,primme)
 !       ----------------------------------------------------------------
         implicit none
         include 'primme_f77.h'
         real*8 x(*), y(*)
         integer*8 primme
-        integer k,i,j,n
+        integer ldx,ldy,k,i,j,n
         call primme_get_member_f77(primme, PRIMMEF77_n, n)
         do j=0,k-1
            do i=1,n
-              y(j*n+i) = x(j*n+i)/2.0
+              y(j*ldy+i) = x(j*ldx+i)/2.0
            enddo
         enddo
         end
@@ -33,8 +33,8 @@
 #include "primme.h"   /* header file is required to run primme */ 
 
 PetscErrorCode generateLaplacian1D(int n, Mat *A);
-void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme);
-void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme);
+void PETScMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme);
+void ApplyPCPrecPETSC(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme);
 static void par_GlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
                          primme_params *primme);
 
@@ -224,7 +224,7 @@ PetscErrorCode generateLaplacian1D(int n, Mat *A) {
    PetscFunctionReturn(0);
 }
 
-void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
+void PETScMatvec(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme) {
    int i;
    Mat *matrix;
    Vec xvec, yvec;
@@ -234,8 +234,8 @@ void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
 
    ierr = MatCreateVecs(*matrix, &xvec, &yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
    for (i=0; i<*blockSize; i++) {
-      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
-      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + *ldx*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + *ldy*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = MatMult(*matrix, xvec, yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(xvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
@@ -251,7 +251,7 @@ void PETScMatvec(void *x, void *y, int *blockSize, primme_params *primme) {
    - M, diagonal square matrix of dimension primme.n with 2 in the diagonal.
 */
 
-void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme) {
+void ApplyPCPrecPETSC(void *x, int *ldx, void *y, int *ldy, int *blockSize, primme_params *primme) {
    int i;
    Mat *matrix;
    PC *pc;
@@ -263,8 +263,8 @@ void ApplyPCPrecPETSC(void *x, void *y, int *blockSize, primme_params *primme) {
 
    ierr = MatCreateVecs(*matrix, &xvec, &yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
    for (i=0; i<*blockSize; i++) {
-      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
-      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + primme->nLocal*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(xvec, ((PetscScalar*)x) + *ldx*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
+      ierr = VecPlaceArray(yvec, ((PetscScalar*)y) + *ldy*i); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = PCApply(*pc, xvec, yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(xvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
       ierr = VecResetArray(yvec); CHKERRABORT(*(MPI_Comm*)primme->commInfo, ierr);
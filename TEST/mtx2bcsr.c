@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Converts a MatrixMarket file into the binary CSR format that the native
+ *  driver maps into memory when driver.matrixFile ends in .bcsr. Symmetric
+ *  and Hermitian matrices are written in half storage (upper triangle).
+ *  Build mtx2bcsr_double for real matrices and mtx2bcsr_doublecomplex for
+ *  complex ones; each driver reads only files of its own type.
+ *
+ *  Usage: mtx2bcsr_double matrix.mtx matrix.bcsr
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "csr.h"
+
+int main (int argc, char *argv[]) {
+
+   CSRMatrix *matrix;
+
+   if (argc != 3) {
+      fprintf(stderr, "Usage: %s matrix.mtx matrix.bcsr\n", argv[0]);
+      return 1;
+   }
+
+   if (readSymMatrixNative(argv[1], &matrix, NULL) != 0) return 1;
+   if (writeBinaryCSRMatrix(argv[2], matrix) != 0) {
+      fprintf(stderr, "ERROR: Could not write %s\n", argv[2]);
+      return 1;
+   }
+   printf("%s: n = %d, nnz = %d%s\n", argv[2], matrix->n, matrix->nnz,
+      matrix->symmetric ? " (upper triangle)" : "");
+
+   destroyCSRMatrix(matrix);
+   return 0;
+}
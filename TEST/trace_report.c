@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2015 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *
+ *  Reports from an event trace written by primme_write_trace in JSON lines
+ *  format (e.g., with driver.traceFile and driver.traceFormat = jsonl):
+ *
+ *  - the time breakdown per phase: calls, inclusive time (including the
+ *    phases it calls) and self time;
+ *  - the convergence history: per outer iteration, the elapsed time, the
+ *    block size and the Ritz values and residual norms of the block;
+ *  - the dynamic method switches.
+ *
+ *  Usage: trace_report trace.jsonl
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LINE   1024
+#define MAX_DEPTH  64
+#define NUM_PHASES 10
+
+static const char *phaseNames[NUM_PHASES] = {"matvec", "precond", "ortho",
+   "update_projection", "solve_H", "restart", "locking", "convergence",
+   "inner_solve", "globalSum"};
+
+static int get_string(const char *line, const char *key, char *value,
+   int size);
+static int get_number(const char *line, const char *key, double *value);
+static int phase_index(const char *name);
+
+int main (int argc, char *argv[]) {
+
+   FILE *f;
+   char line[MAX_LINE], event[32], phase[32];
+   double t, value, rnorm, iteration, index;
+   double inclusive[NUM_PHASES], self[NUM_PHASES], child[MAX_DEPTH];
+   double start[MAX_DEPTH];
+   int calls[NUM_PHASES], stack[MAX_DEPTH];
+   int depth = 0, p, i;
+
+   if (argc != 2) {
+      fprintf(stderr, "Usage: %s trace.jsonl\n", argv[0]);
+      return 1;
+   }
+   if ((f = fopen(argv[1], "r")) == NULL) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+   }
+
+   for (i = 0; i < NUM_PHASES; i++) {
+      inclusive[i] = self[i] = 0.0;
+      calls[i] = 0;
+   }
+
+   printf("Convergence history\n\n");
+   printf("%6s %12s %5s %6s %24s %12s\n", "iter", "time", "block", "index",
+      "Ritz value", "|r|");
+
+   while (fgets(line, MAX_LINE, f) != NULL) {
+      if (!get_string(line, "event", event, sizeof(event))
+            || !get_number(line, "time", &t)) {
+         continue;
+      }
+
+      if (strcmp(event, "begin") == 0 || strcmp(event, "end") == 0) {
+         if (!get_string(line, "phase", phase, sizeof(phase))
+               || (p = phase_index(phase)) < 0) {
+            continue;
+         }
+
+         if (event[0] == 'b') {
+            if (depth < MAX_DEPTH) {
+               stack[depth] = p;
+               start[depth] = t;
+               child[depth] = 0.0;
+            }
+            depth++;
+         }
+         else if (depth > 0) {
+            /* Events older than the ring buffer may leave ends unmatched */
+            depth--;
+            if (depth < MAX_DEPTH && stack[depth] == p) {
+               inclusive[p] += t - start[depth];
+               self[p] += t - start[depth] - child[depth];
+               calls[p]++;
+               if (depth > 0 && depth-1 < MAX_DEPTH) {
+                  child[depth-1] += t - start[depth];
+               }
+            }
+         }
+      }
+      else if (strcmp(event, "blockSize") == 0) {
+         get_number(line, "iteration", &iteration);
+         get_number(line, "value", &value);
+         printf("%6d %12.6f %5d\n", (int)iteration, t, (int)value);
+      }
+      else if (strcmp(event, "ritz") == 0) {
+         get_number(line, "iteration", &iteration);
+         get_number(line, "index", &index);
+         get_number(line, "value", &value);
+         get_number(line, "rnorm", &rnorm);
+         printf("%6d %12.6f %5s %6d %24.16e %12.4e\n", (int)iteration, t, "",
+            (int)index, value, rnorm);
+      }
+      else if (strcmp(event, "method") == 0) {
+         get_number(line, "iteration", &iteration);
+         get_number(line, "index", &index);
+         get_number(line, "value", &value);
+         printf("%6d %12.6f  switch to dynamicMethodSwitch %d (ratio %g)\n",
+            (int)iteration, t, (int)index, value);
+      }
+      else if (strcmp(event, "tune") == 0) {
+         get_number(line, "iteration", &iteration);
+         get_number(line, "index", &index);
+         get_number(line, "value", &value);
+         printf("%6d %12.6f  tuned %s = %d\n", (int)iteration, t,
+            index == 0 ? "maxBasisSize" : index == 1 ? "minRestartSize" :
+            "maxBlockSize", (int)value);
+      }
+      else if (strcmp(event, "restart") == 0) {
+         get_number(line, "iteration", &iteration);
+         get_number(line, "index", &index);
+         get_number(line, "value", &value);
+         printf("%6d %12.6f  restart to %d vectors, %d previous\n",
+            (int)iteration, t, (int)value, (int)index);
+      }
+   }
+   fclose(f);
+
+   printf("\nTime breakdown\n\n");
+   printf("%-18s %8s %12s %12s\n", "phase", "calls", "inclusive", "self");
+   for (i = 0; i < NUM_PHASES; i++) {
+      printf("%-18s %8d %12.6f %12.6f\n", phaseNames[i], calls[i],
+         inclusive[i], self[i]);
+   }
+
+   return 0;
+}
+
+/******************************************************************************
+ * Copies into value the string of "key" in the JSON object in line. Returns
+ * 1 if it is found and 0 otherwise.
+ *
+******************************************************************************/
+
+static int get_string(const char *line, const char *key, char *value,
+   int size) {
+
+   char pattern[64];
+   const char *p, *q;
+
+   sprintf(pattern, "\"%s\":\"", key);
+   if ((p = strstr(line, pattern)) == NULL) return 0;
+   p += strlen(pattern);
+   if ((q = strchr(p, '"')) == NULL || q - p >= size) return 0;
+   memcpy(value, p, q - p);
+   value[q - p] = '\0';
+   return 1;
+}
+
+/******************************************************************************
+ * Reads into value the number of "key" in the JSON object in line. Returns
+ * 1 if it is found and 0 otherwise.
+ *
+******************************************************************************/
+
+static int get_number(const char *line, const char *key, double *value) {
+
+   char pattern[64];
+   const char *p;
+
+   sprintf(pattern, "\"%s\":", key);
+   if ((p = strstr(line, pattern)) == NULL) return 0;
+   *value = strtod(p + strlen(pattern), NULL);
+   return 1;
+}
+
+static int phase_index(const char *name) {
+
+   int i;
+
+   for (i = 0; i < NUM_PHASES; i++) {
+      if (strcmp(name, phaseNames[i]) == 0) return i;
+   }
+   return -1;
+}